@@ -0,0 +1,209 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include <ActiveTiles.h>
+#include <Utils.h>
+#include <algorithm>
+#include <cstring>
+
+//-------------------------------------------------------------------------
+
+ActiveTiles::ActiveTiles(MPI_Comm &comm_, SpaceVariable3D &V, std::vector<GhostPoint> &ghost_nodes_outer,
+                         int tile_size_, int report_frequency_)
+           : comm(comm_), tile_size(tile_size_), report_frequency(report_frequency_), ghost_ref_valid(false),
+             Vn(NULL), computed_cells(0.0), total_cells(0.0), last_report_step(0)
+{
+  if(tile_size<2) {
+    print_error(comm, "*** Error: ActiveTileSize must be at least 2 (%d).\n", tile_size);
+    exit_mpi();
+  }
+
+  V.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+  V.GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+  V.GetGlobalSize(&NX, &NY, &NZ);
+
+  std::vector<unsigned char> near_x, near_y, near_z;
+  ntx = SetupTileCoordinates(i0, imax, ii0, iimax, NX, tx, near_x);
+  nty = SetupTileCoordinates(j0, jmax, jj0, jjmax, NY, ty, near_y);
+  ntz = SetupTileCoordinates(k0, kmax, kk0, kkmax, NZ, tz, near_z);
+  ntiles = ntx*nty*ntz;
+
+  tile_cells.assign(ntiles, 0);
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++)
+        tile_cells[Tile(i,j,k)]++;
+
+  pinned.assign(ntiles, 0);
+  for(int c=0; c<ntz; c++)
+    for(int b=0; b<nty; b++)
+      for(int a=0; a<ntx; a++)
+        pinned[(c*nty + b)*ntx + a] = near_x[a] || near_y[b] || near_z[c];
+
+  zero.assign(ntiles, 0);
+  skip.assign(ntiles, 0);
+  touched.assign(ntiles, 0);
+  keep.assign(ntiles, 0);
+  rzero.assign(ntiles, 0);
+
+  // ghost cells outside the physical domain next to the interior of this subdomain
+  for(auto&& gp : ghost_nodes_outer) {
+    if(gp.type_projection != GhostPoint::FACE)
+      continue;
+    Int3 g = gp.ijk;
+    Int3 im(std::min(std::max(g[0],0),NX-1), std::min(std::max(g[1],0),NY-1), std::min(std::max(g[2],0),NZ-1));
+    if(im[0]<i0 || im[0]>=imax || im[1]<j0 || im[1]>=jmax || im[2]<k0 || im[2]>=kmax)
+      continue; //next to another subdomain (see Note (1) in the header)
+    ghosts.push_back(g);
+    ghost_images.push_back(im);
+  }
+  ghost_ref.resize(ghosts.size());
+
+  int ntiles_total = ntiles;
+  MPI_Allreduce(MPI_IN_PLACE, &ntiles_total, 1, MPI_INT, MPI_SUM, comm);
+  print(comm, "- Skipping quiescent tiles in the N-S solver (tile size: %d, number of tiles: %d).\n",
+        tile_size, ntiles_total);
+}
+
+//-------------------------------------------------------------------------
+
+int
+ActiveTiles::SetupTileCoordinates(int lo, int hi, int glo, int ghi, int N, std::vector<int> &t,
+                                  std::vector<unsigned char> &near_remote)
+{
+  int nt = std::max(1, (hi-lo)/tile_size);
+
+  t.assign(ghi-glo, 0);
+  for(int n=glo; n<ghi; n++) {
+    if(n<lo || n>=hi)
+      t[n-glo] = (n<0 || n>=N) ? OUTSIDE : REMOTE;
+    else
+      t[n-glo] = std::min((n-lo)/tile_size, nt-1);
+  }
+
+  near_remote.assign(nt, 0);
+  for(int n=lo; n<std::min(lo+2,hi); n++)
+    if(lo>0)
+      near_remote[t[n-glo]] = 1;
+  for(int n=std::max(hi-2,lo); n<hi; n++)
+    if(hi<N)
+      near_remote[t[n-glo]] = 1;
+
+  return nt;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ActiveTiles::InvalidateNeighborhood(int a, int b, int c)
+{
+  for(int cc=std::max(c-1,0); cc<=std::min(c+1,ntz-1); cc++)
+    for(int bb=std::max(b-1,0); bb<=std::min(b+1,nty-1); bb++)
+      for(int aa=std::max(a-1,0); aa<=std::min(a+1,ntx-1); aa++)
+        zero[(cc*nty + bb)*ntx + aa] = 0;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ActiveTiles::InvalidateAll()
+{
+  std::fill(zero.begin(), zero.end(), 0);
+}
+
+//-------------------------------------------------------------------------
+
+void
+ActiveTiles::BeginTimeStep(SpaceVariable3D &V, int time_step)
+{
+  Vn = &V;
+  std::fill(touched.begin(), touched.end(), 0);
+
+  if(report_frequency>0 && time_step-1-last_report_step >= report_frequency) {
+    double buf[2] = {computed_cells, total_cells};
+    MPI_Allreduce(MPI_IN_PLACE, buf, 2, MPI_DOUBLE, MPI_SUM, comm);
+    if(buf[1]>0.0)
+      print(comm, "- Active tiles: %.2f%% of the cells computed in time steps %d - %d.\n",
+            100.0*buf[0]/buf[1], last_report_step+1, time_step-1);
+    computed_cells = total_cells = 0.0;
+    last_report_step = time_step-1;
+  }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ActiveTiles::BeginStage(SpaceVariable3D &V)
+{
+  // Changes at the ghost cells outside the physical domain
+  Vec5D*** v = (Vec5D***) V.GetDataPointer();
+  for(int n=0; n<(int)ghosts.size(); n++) {
+    Vec5D &vg(v[ghosts[n][2]][ghosts[n][1]][ghosts[n][0]]);
+    if(ghost_ref_valid && !memcmp(&vg, &ghost_ref[n], sizeof(Vec5D)))
+      continue;
+    ghost_ref[n] = vg;
+    Int3 &im(ghost_images[n]);
+    InvalidateNeighborhood(tx[im[0]-ii0], ty[im[1]-jj0], tz[im[2]-kk0]);
+  }
+  V.RestoreDataPointerToLocalVector();
+  ghost_ref_valid = true;
+
+  for(int t=0; t<ntiles; t++) {
+    skip[t] = zero[t];
+    total_cells += tile_cells[t];
+    if(!skip[t])
+      computed_cells += tile_cells[t];
+  }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ActiveTiles::RecordResidual(Vec5D*** r)
+{
+  for(int t=0; t<ntiles; t++)
+    rzero[t] = 1; //skipped tiles have zero residual
+
+  int t;
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++) {
+        t = Tile(i,j,k);
+        if(skip[t] || !rzero[t])
+          continue;
+        for(int p=0; p<5; p++)
+          if(r[k][j][i][p] != 0.0) {
+            rzero[t] = 0;
+            break;
+          }
+      }
+
+  for(t=0; t<ntiles; t++)
+    if(!skip[t])
+      zero[t] = rzero[t] && !pinned[t];
+}
+
+//-------------------------------------------------------------------------
+
+void
+ActiveTiles::PrepareUpdate()
+{
+  // A tile with zero residual that has not been updated in this time step is at the state of t(n), which is
+  // also the result of the update (U = Un exactly). Other tiles change, and so may the residual around them.
+  for(int t=0; t<ntiles; t++)
+    keep[t] = !touched[t] && rzero[t];
+
+  for(int c=0; c<ntz; c++)
+    for(int b=0; b<nty; b++)
+      for(int a=0; a<ntx; a++) {
+        int t = (c*nty + b)*ntx + a;
+        if(keep[t])
+          continue;
+        touched[t] = 1;
+        InvalidateNeighborhood(a,b,c);
+      }
+}
+
+//-------------------------------------------------------------------------
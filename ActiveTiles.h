@@ -0,0 +1,140 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _ACTIVE_TILES_H_
+#define _ACTIVE_TILES_H_
+
+#include <SpaceVariable.h>
+#include <GhostPoint.h>
+#include <Vector5D.h>
+#include <vector>
+
+/*****************************************************************************
+ * class ActiveTiles partitions the interior of a subdomain into tiles (blocks
+ * of about tile_size^3 cells) and tracks which tiles can be skipped in the
+ * computation of the N-S residual. This is exact (not an approximation): a
+ * tile is skipped only if its residual has been computed to be exactly zero,
+ * and neither the tile nor any of its 26 neighbors has changed since then.
+ * (The residual of a cell depends on the states within 2 cells, and each tile
+ * is at least 2 cells wide.) Skipped tiles are not reconstructed, their faces
+ * are not visited by the flux loop, and the stage update leaves them alone.
+ * Life cycle of a tile, in each time step:
+ *   BeginTimeStep: nothing has been updated yet.
+ *   BeginStage:    skipped if its residual is known to be zero.
+ *   RecordResidual: for computed tiles, checks whether the residual is zero.
+ *   PrepareUpdate: tiles that are untouched in this time step and have zero
+ *                  residual keep their state (U = Un exactly). Other tiles
+ *                  are updated, which invalidates them and their neighbors.
+ * Note:
+ *   (1) Tiles within 2 cells of another subdomain are never skipped (the
+ *       ghost layer is only 1 cell wide). Their updates invalidate the tiles
+ *       further inside, so changes in other subdomains are still detected.
+ *   (2) Changes of the ghost cells outside the physical domain (e.g., time-
+ *       dependent boundary conditions) are detected by comparing them with
+ *       the values seen in the previous stage.
+ *   (3) Any other modification of the state (e.g., smoothing filters) must
+ *       be followed by InvalidateAll.
+ ****************************************************************************/
+
+class ActiveTiles {
+
+  MPI_Comm &comm;
+
+  int tile_size;
+  int report_frequency; //!< report the fraction of computed cells every N time steps (<=0: never)
+
+  int i0, j0, k0, imax, jmax, kmax; //!< interior of the subdomain
+  int ii0, jj0, kk0, iimax, jjmax, kkmax; //!< ghosted subdomain
+  int NX, NY, NZ;
+
+  //! tiles (the last tile in each direction absorbs the remainder, so a tile is thinner than tile_size only
+  //! if the subdomain is)
+  int ntx, nty, ntz, ntiles;
+  enum {OUTSIDE = -1, REMOTE = -2}; //!< ghost cells outside the physical domain / in another subdomain
+  std::vector<int> tx, ty, tz; //!< tile coordinate of each (ghosted) index, or OUTSIDE/REMOTE
+  std::vector<int> tile_cells; //!< number of cells in each tile
+
+  std::vector<unsigned char> pinned;  //!< within 2 cells of another subdomain (never skipped)
+  std::vector<unsigned char> zero;    //!< residual is known to be exactly zero at the current state
+  std::vector<unsigned char> skip;    //!< skipped in the current stage
+  std::vector<unsigned char> touched; //!< updated in the current time step
+  std::vector<unsigned char> keep;    //!< left unchanged by the current stage update
+  std::vector<unsigned char> rzero;   //!< residual is exactly zero in the current stage
+
+  //! ghost cells outside the physical domain (FACE) and the interior cells next to them
+  std::vector<Int3> ghosts, ghost_images;
+  std::vector<Vec5D> ghost_ref; //!< states of the ghost cells when last checked
+  bool ghost_ref_valid;
+
+  SpaceVariable3D *Vn; //!< state at the beginning of the time step
+
+  //! statistics (local, since the last report)
+  double computed_cells, total_cells;
+  int last_report_step;
+
+public:
+
+  ActiveTiles(MPI_Comm &comm_, SpaceVariable3D &V, std::vector<GhostPoint> &ghost_nodes_outer,
+              int tile_size_, int report_frequency_);
+  ~ActiveTiles() {}
+
+  //! reports statistics (at the user-specified frequency) and resets "touched"
+  void BeginTimeStep(SpaceVariable3D &V, int time_step);
+
+  //! detects changes at the ghost cells outside the physical domain, and decides which tiles to skip
+  void BeginStage(SpaceVariable3D &V);
+
+  //! to be called with the final residual (before the stage update)
+  void RecordResidual(Vec5D*** r);
+
+  //! decides which tiles keep their state in the coming stage update (see above)
+  void PrepareUpdate();
+
+  //! forgets everything known about the residual (e.g., after the state is modified by a filter)
+  void InvalidateAll();
+
+  //! state at the beginning of the time step (for tiles that keep their state)
+  SpaceVariable3D* GetStepStartState() {return Vn;}
+
+  //! interior cells only
+  inline bool Skipped(int i, int j, int k) const {return skip[Tile(i,j,k)];}
+  inline bool Kept(int i, int j, int k) const {return keep[Tile(i,j,k)];}
+
+  //! Any cell in the ghosted subdomain. Ghost cells outside the physical domain follow the interior;
+  //! cells in other subdomains are never quiet.
+  inline bool Quiet(int i, int j, int k) const {
+    int a = tx[i-ii0], b = ty[j-jj0], c = tz[k-kk0];
+    if(a==REMOTE || b==REMOTE || c==REMOTE)
+      return false;
+    if(a==OUTSIDE || b==OUTSIDE || c==OUTSIDE)
+      return true;
+    return skip[(c*nty + b)*ntx + a];
+  }
+
+  //! the flux across a face is not needed if both cells are quiet
+  inline bool FaceIsQuiet(int i1, int j1, int k1, int i2, int j2, int k2) const {
+    return Quiet(i1,j1,k1) && Quiet(i2,j2,k2);}
+
+  //! an interior cell needs to be reconstructed unless it and its 6 neighbors are quiet
+  inline bool NeedsReconstruction(int i, int j, int k) const {
+    return !(Quiet(i,j,k) && Quiet(i-1,j,k) && Quiet(i+1,j,k) && Quiet(i,j-1,k) && Quiet(i,j+1,k) &&
+             Quiet(i,j,k-1) && Quiet(i,j,k+1));
+  }
+
+private:
+
+  inline int Tile(int i, int j, int k) const {
+    return (tz[k-kk0]*nty + ty[j-jj0])*ntx + tx[i-ii0];}
+
+  //! sets up the tile coordinates in one direction; returns the number of tiles
+  int SetupTileCoordinates(int lo, int hi, int glo, int ghi, int N, std::vector<int> &t,
+                           std::vector<unsigned char> &near_remote);
+
+  //! "zero" becomes false for tile (a,b,c) and its 26 neighbors
+  void InvalidateNeighborhood(int a, int b, int c);
+
+};
+
+#endif
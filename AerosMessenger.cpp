@@ -37,7 +37,8 @@ extern int verbose;
 AerosMessenger::AerosMessenger(AerosCouplingData &iod_aeros_, MPI_Comm &m2c_comm_, MPI_Comm &joint_comm_, 
                                TriangulatedSurface &surf_, vector<Vec3D> &F_)
               : iod_aeros(iod_aeros_), m2c_comm(m2c_comm_), joint_comm(joint_comm_),
-                surface(surf_), F(F_), cracking(NULL), numStrNodes(NULL)
+                surface(surf_), F(F_), cracking(NULL), numStrNodes(NULL),
+                distributed(iod_aeros_.exchange == AerosCouplingData::DISTRIBUTED)
 {
 
   MPI_Comm_rank(m2c_comm, &m2c_rank);
@@ -63,6 +64,11 @@ AerosMessenger::AerosMessenger(AerosCouplingData &iod_aeros_, MPI_Comm &m2c_comm
 
   GetEmbeddedWetSurfaceInfo(elemType, crack, nStNodes, nStElems);
 
+  if(distributed && crack) {
+    print_error("*** Error: Distributed data exchange with Aero-S does not support fracture (yet).\n");
+    exit_mpi();
+  }
+
   // initialize cracking information
   if(crack) {
     GetInitialCrackingSetup(totalStNodes, totalStElems);
@@ -118,8 +124,25 @@ AerosMessenger::AerosMessenger(AerosCouplingData &iod_aeros_, MPI_Comm &m2c_comm
   surface.active_nodes = nNodes;
   surface.active_elems = nElems;
 
+  // nodes owned by each proc (for data exchange)
+  block_counts.assign(m2c_size, 0);
+  block_displs.assign(m2c_size, 0);
+  for(int proc=0; proc<m2c_size; proc++) {
+    int b0 = distributed ? (int)((long)totalNodes*proc/m2c_size) : 0;
+    int b1 = distributed ? (int)((long)totalNodes*(proc+1)/m2c_size) : (proc==0 ? totalNodes : 0);
+    block_counts[proc] = 3*(b1-b0);
+    block_displs[proc] = 3*b0;
+    if(proc == m2c_rank) {
+      node_begin = b0;
+      node_end   = b1;
+    }
+  }
+
   Negotiate(); // Following the AERO-F/S function name, although misleading
 
+  if(distributed)
+    SetupPersistentRequests();
+
   GetInfo(); // Get algorithm number, dt, and tmax
 
   if(cracking) {
@@ -168,7 +191,14 @@ AerosMessenger::~AerosMessenger()
 
 void
 AerosMessenger::Destroy()
-{ }
+{
+  for(auto&& req : force_requests)
+    MPI_Request_free(&req);
+  for(auto&& req : disp_requests)
+    MPI_Request_free(&req);
+  force_requests.clear();
+  disp_requests.clear();
+}
 
 //---------------------------------------------------------------
 
@@ -275,24 +305,28 @@ void
 AerosMessenger::Negotiate()
 {
 
-  int numCPUMatchedNodes = m2c_rank ? 0 : totalNodes;
+  // Each fluid CPU sends the nodes it owns (a contiguous block, see the constructor).
+  int numCPUMatchedNodes = node_end - node_begin;
 
   vector<int> ibuffer;
   if(numCPUMatchedNodes>0) {
     ibuffer.resize(numCPUMatchedNodes);
     for(int i=0; i<numCPUMatchedNodes; i++)
-      ibuffer[i] = i; //trivial for M2C/Embedded boundary. (non-trivial in AERO-F/S w/ ALE)
+      ibuffer[i] = node_begin + i; //trivial for M2C/Embedded boundary. (non-trivial in AERO-F/S w/ ALE)
   }
 
   // send the matched node numbers of this fluid CPU to all the structure CPUs
   vector<MPI_Request> send_requests;
+  send_requests.reserve(2*numAerosProcs);
   for (int proc = 0; proc < numAerosProcs; proc++) {
     send_requests.push_back(MPI_Request());
     MPI_Isend(&numCPUMatchedNodes, 1, MPI_INT, proc, NEGO_NUM_TAG, 
               joint_comm, &(send_requests[send_requests.size()-1]));
-    if(numCPUMatchedNodes>0)
+    if(numCPUMatchedNodes>0) {
+      send_requests.push_back(MPI_Request());
       MPI_Isend(ibuffer.data(), numCPUMatchedNodes, MPI_INT, proc, NEGO_BUF_TAG, 
                 joint_comm, &(send_requests[send_requests.size()-1]));
+    }
   }
   MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
 
@@ -313,7 +347,7 @@ AerosMessenger::Negotiate()
 
         for(int i = 0; i < numStrNodes[proc][0]; ++i) {
           int idx = ibuffer[i];
-          assert(idx>=0 && idx<totalNodes);
+          assert(idx>=node_begin && idx<node_end);
 
           pack2local.push_back(idx);
           local2pack[idx] = pack2local.size()-1;
@@ -327,10 +361,10 @@ AerosMessenger::Negotiate()
       exit(-1);
     }
 
-    for(auto it = local2pack.begin(); it != local2pack.end(); it++) {
-      if(*it < 0) {
+    for(int i=node_begin; i<node_end; i++) {
+      if(local2pack[i] < 0) {
         fprintf(stdout, "\033[0;31m*** Error (proc %d): found unmatched node (local id: %d).\n\033[0m",
-              m2c_rank, (int)(it - local2pack.begin()));
+              m2c_rank, i);
         exit(-1);
       }
     }
@@ -345,6 +379,32 @@ AerosMessenger::Negotiate()
 
 //---------------------------------------------------------------
 
+void
+AerosMessenger::SetupPersistentRequests()
+{
+  // The communication pattern is fixed after Negotiate (no fracture). So, the send/receive requests
+  // are created once, and re-started in every exchange.
+  if(node_end == node_begin)
+    return;
+
+  assert(bufsize==6);
+  force_buffer.assign(3*pack2local.size(), 0.0);
+  disp_buffer.assign(bufsize*pack2local.size(), 0.0);
+
+  for(int proc = 0; proc < numAerosProcs; proc++) {
+    if(numStrNodes[proc][0] > 0) {
+      force_requests.push_back(MPI_Request());
+      MPI_Send_init(force_buffer.data() + 3*numStrNodes[proc][1], 3*numStrNodes[proc][0], MPI_DOUBLE,
+                    proc, FORCE_TAG, joint_comm, &(force_requests[force_requests.size()-1]));
+      disp_requests.push_back(MPI_Request());
+      MPI_Recv_init(disp_buffer.data() + bufsize*numStrNodes[proc][1], bufsize*numStrNodes[proc][0],
+                    MPI_DOUBLE, proc, DISP_TAG, joint_comm, &(disp_requests[disp_requests.size()-1]));
+    }
+  }
+}
+
+//---------------------------------------------------------------
+
 void
 AerosMessenger::GetInfo()
 {
@@ -562,6 +622,24 @@ void
 AerosMessenger::SendForce()
 {
   //IMPORTANT: Assuming that the force has been assembled on Proc 0
+  if(distributed) {
+    // each proc gets the forces on the nodes it owns, and sends them to AERO-S
+    MPI_Scatterv((double*)F.data(), block_counts.data(), block_displs.data(), MPI_DOUBLE,
+                 m2c_rank==0 ? MPI_IN_PLACE : (double*)(F.data() + node_begin), block_counts[m2c_rank],
+                 MPI_DOUBLE, 0, m2c_comm);
+
+    if(force_requests.empty())
+      return;
+
+    for(int i=0; i<(int)pack2local.size(); i++)
+      for(int j=0; j<3; j++)
+        force_buffer[3*i+j] = F[pack2local[i]][j];
+
+    MPI_Startall(force_requests.size(), force_requests.data());
+    MPI_Waitall(force_requests.size(), force_requests.data(), MPI_STATUSES_IGNORE);
+    return;
+  }
+
   if(m2c_rank == 0) {
 
     //TODO: Need to take care of "staggering"
@@ -598,6 +676,33 @@ AerosMessenger::SendForce()
 void
 AerosMessenger::GetDisplacementAndVelocity()
 {
+  if(distributed) {
+    // each proc receives disp and velo of the nodes it owns
+    if(!disp_requests.empty()) {
+      MPI_Startall(disp_requests.size(), disp_requests.data());
+      MPI_Waitall(disp_requests.size(), disp_requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    for(int i=node_begin; i<node_end; i++) {
+      int id = local2pack[i];
+      for(int j=0; j<3; j++)
+        surface.X[i][j] = surface.X0[i][j] + disp_buffer[bufsize*id+j];
+      for(int j=0; j<3; j++)
+        surface.Udot[i][j] = disp_buffer[bufsize*id+3+j];
+      if(algNum==6) {//A6
+        for(int j=0; j<3; j++)
+          surface.X[i][j] += 0.5*dt*surface.Udot[i][j];
+      }
+    }
+
+    // the entire surface is needed on every proc (e.g., for finding the scope of each intersector)
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, (double*)surface.X.data(), block_counts.data(),
+                   block_displs.data(), MPI_DOUBLE, m2c_comm);
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, (double*)surface.Udot.data(), block_counts.data(),
+                   block_displs.data(), MPI_DOUBLE, m2c_comm);
+    return;
+  }
+
   if(m2c_rank == 0) {
 
     assert(bufsize==6);
@@ -49,6 +49,15 @@ class AerosMessenger {
 
   std::vector<double> temp_buffer;
 
+  //! Distributed data exchange: each proc owns a contiguous block of nodes [node_begin, node_end),
+  //! and exchanges data for this block directly with AERO-S, using persistent requests set up in
+  //! Negotiate. (Centralized: proc 0 owns all the nodes.)
+  bool distributed;
+  int node_begin, node_end;
+  std::vector<int> block_counts, block_displs; //!< blocks of all the procs (in doubles, i.e. 3 per node)
+  std::vector<double> force_buffer, disp_buffer;
+  std::vector<MPI_Request> force_requests, disp_requests;
+
 public:
 
   AerosMessenger(AerosCouplingData &iod_aeros_, MPI_Comm &m2c_comm_, MPI_Comm &joint_comm_, 
@@ -86,6 +95,7 @@ protected:
   void GetInitialCrackingSetup(int &totalStNodes, int &totalStElems);
   int  SplitQuads(int *quads, int nStElems, std::vector<Int3> &Tria);
   void Negotiate();
+  void SetupPersistentRequests();
   void GetInfo();
   void GetInitialCrack();
   bool GetNewCrackingStats(int& numConnUpdate, int& numLSUpdate, int& newNodes);
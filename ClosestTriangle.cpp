@@ -10,7 +10,8 @@ using std::map;
 
 //----------------------------------------------------------------------------
 
-ClosestTriangle::ClosestTriangle(int (*nd)[3], Vec3D *sX, Vec3D *sN, set<int> *n2n, set<int> *n2e) {
+ClosestTriangle::ClosestTriangle(int (*nd)[3], Vec3D *sX, Vec3D *sN, const AdjacencyCSR *n2n,
+                                 const AdjacencyCSR *n2e) {
   fail = false;
   triNodes = nd;
   structX = sX;
@@ -330,7 +331,7 @@ double ClosestTriangle::getSignedVertexDistance() const {
 
 double ClosestTriangle::findSignedVertexDistance()
 {
-  set<int> &vertices = node2node[n1]; //vertices in the direct neighborhood of n1
+  AdjacencyCSR::Row vertices = (*node2node)[n1]; //vertices in the direct neighborhood of n1
   Vec3D    &xp       = structX[n1];   //coordinate of n1
 
   //step 1: find a test direction.
@@ -340,7 +341,7 @@ double ClosestTriangle::findSignedVertexDistance()
   double ry = 0.0;
   Vec3D npx = x - xp;
   npx = 1.0/npx.norm()*npx;
-  for(set<int>::iterator it=vertices.begin(); it!=vertices.end(); it++) {
+  for(const int *it=vertices.begin(); it!=vertices.end(); it++) {
     Vec3D xr = structX[*it];
 
     double d_xp_xr = (xp-xr).norm();
@@ -392,7 +393,7 @@ int ClosestTriangle::findTesterStatus(Vec3D xt) const
 //  Vec3D xdebug(-4.348610e+00, -5.030928e+00, -6.636450e-02);
 //  bool debug = (xt-xdebug).norm()<1.0e-5 ? true : false;
 
-  set<int> &elements = node2elem[n1]; //elements in the direct neighborhood of n1
+  AdjacencyCSR::Row elements = (*node2elem)[n1]; //elements in the direct neighborhood of n1
   double mindist = 1.0e14;
   const double eps = 1.0e-14;
   int nn1,nn2;
@@ -400,7 +401,7 @@ int ClosestTriangle::findTesterStatus(Vec3D xt) const
   int bestTriangle = -1;
   nn1 = nn2 = -1;
 
-  for(set<int>::iterator it=elements.begin(); it!=elements.end(); it++) {
+  for(const int *it=elements.begin(); it!=elements.end(); it++) {
     double xi[3];
     double dist = project(xt, *it, xi[0], xi[1]);
     xi[2] = 1.0 - xi[0] - xi[1]; // project onto the plane determined by this triangle
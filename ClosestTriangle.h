@@ -6,7 +6,7 @@
 #ifndef _CLOSEST_TRIANGLE_H_
 #define _CLOSEST_TRIANGLE_H_
 
-#include <Vector3D.h>
+#include <TriangulatedSurface.h>
 #include <map>
 #include <set>
 
@@ -29,8 +29,8 @@ class ClosestTriangle {
   int (*triNodes)[3];
   Vec3D *structX;
   Vec3D *structNorm;
-  std::set<int> *node2node;
-  std::set<int> *node2elem;
+  const AdjacencyCSR *node2node;
+  const AdjacencyCSR *node2elem;
 
 protected:
   bool fail;
@@ -63,7 +63,8 @@ protected:
 
 public:
 
-  ClosestTriangle(int (*triNodes)[3], Vec3D *structX, Vec3D *sN, std::set<int> *n2n, std::set<int> *n2e);
+  ClosestTriangle(int (*triNodes)[3], Vec3D *structX, Vec3D *sN, const AdjacencyCSR *n2n,
+                  const AdjacencyCSR *n2e);
   ~ClosestTriangle() {}
 
   void start(Vec3D x);
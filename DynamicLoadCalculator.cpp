@@ -12,8 +12,6 @@ using std::string;
 using std::vector;
 using std::shared_ptr;
 
-extern clock_t start_time; //time computation started (in Main.cpp)
-
 //-----------------------------------------------------------------
 
 DynamicLoadCalculator::DynamicLoadCalculator(IoData &iod_, MPI_Comm &comm_, 
@@ -21,7 +19,9 @@ DynamicLoadCalculator::DynamicLoadCalculator(IoData &iod_, MPI_Comm &comm_,
                      : comm(comm_), iod(iod_), concurrent(concurrent_), 
                        lagout(comm_, iod_.special_tools.transient_input.output),
                        S0(NULL), S1(NULL), tree0(NULL), tree1(NULL), id0(-INT_MAX), id1(-INT_MAX)
-{ }
+{
+  start_time = clock();
+}
 
 //-----------------------------------------------------------------
 
@@ -31,6 +31,8 @@ class DynamicLoadCalculator
 
   LagrangianOutput lagout;
 
+  clock_t start_time; //!< for timing purpose only
+
   //! Information about transient input data
   std::string prefix, suffix;
   double tmin, tmax;
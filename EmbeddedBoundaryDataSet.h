@@ -8,6 +8,7 @@
 
 #include <TriangulatedSurface.h>
 #include <SpaceVariable.h>
+#include <NodeSet.h>
 
 /*****************************************************************************
  * class IntersectionPoint is a utility class that stores information about an
@@ -93,11 +94,11 @@ public:
   std::vector<std::pair<Int3, ClosestPoint> > *closest_points_ptr;
   std::vector<IntersectionPoint> *intersections_ptr;
 
-  std::set<Int3> *occluded_ptr;
-  std::set<Int3> *firstLayer_ptr;
-  std::set<Int3> *imposed_occluded_ptr;
+  NodeSet *occluded_ptr;
+  NodeSet *firstLayer_ptr;
+  NodeSet *imposed_occluded_ptr;
 
-  std::set<Int3> *swept_ptr;
+  NodeSet *swept_ptr;
 
 
 public:
@@ -11,10 +11,14 @@
 #include<gauss_quadratures.h>
 #include<rbf_interp.hpp>
 #include<deque>
+#include<algorithm>
 #include<list>
 #include<utility>
 #include<memory.h> //unique_ptr
 #include<dlfcn.h> //dlopen, dlclose
+#include<sys/stat.h> //stat
+#include<climits>
+#include<cstring>
 
 using std::string;
 using std::map;
@@ -84,7 +88,8 @@ EmbeddedBoundaryOperator::EmbeddedBoundaryOperator(MPI_Comm &comm_, IoData &iod_
 
     surface_type[index] = it->second->type;
 
-    ReadMeshFile(it->second->filename, surfaces[index].X, surfaces[index].elems);
+    ReadMeshFile(it->second->filename, it->second->mesh_cache == EmbeddedSurfaceData::YES,
+                 surfaces[index].X, surfaces[index].elems);
 
     surfaces[index].X0 = surfaces[index].X;
 
@@ -143,7 +148,8 @@ EmbeddedBoundaryOperator::EmbeddedBoundaryOperator(MPI_Comm &comm_, EmbeddedSurf
   iod_embedded_surfaces.assign(1, &iod_surface);
   surface_type.assign(1, iod_surface.type);
 
-  ReadMeshFile(iod_surface.filename, surfaces[0].X, surfaces[0].elems);
+  ReadMeshFile(iod_surface.filename, iod_surface.mesh_cache == EmbeddedSurfaceData::YES,
+               surfaces[0].X, surfaces[0].elems);
 
   surfaces[0].X0 = surfaces[0].X;
   surfaces[0].Udot.assign(surfaces[0].X.size(), 0.0);
@@ -196,6 +202,9 @@ EmbeddedBoundaryOperator::Destroy()
   for(int i=0; i<(int)intersector.size(); i++)
     if(intersector[i])
       intersector[i]->Destroy();
+
+  for(auto&& surface : surfaces)
+    surface.DestroySharedMemory();
 }
 
 //------------------------------------------------------------------------------------------------
@@ -262,6 +271,11 @@ EmbeddedBoundaryOperator::IsEmbeddedSurfaceIn3D(int surf)
 void
 EmbeddedBoundaryOperator::SetupIntersectors()
 {
+  // The connectivities are final at this point (including surfaces received from a concurrent solver).
+  // Keep one copy per compute node.
+  for(auto&& surface : surfaces)
+    surface.MoveConnectivitiesToSharedMemory(comm);
+
   for(int i=0; i<(int)intersector.size(); i++) {
     intersector[i] = new Intersector(comm, *dms_ptr, *iod_embedded_surfaces[i], surfaces[i],
                                      *coordinates_ptr, *ghost_nodes_inner_ptr, *ghost_nodes_outer_ptr,
@@ -295,6 +309,10 @@ EmbeddedBoundaryOperator::FindSolidBodies(std::multimap<int, std::pair<int,int>
   }
 
 
+  // Gauss point stencils (for force computation) depend on inactive regions
+  for(auto&& gps : gp_stencils)
+    gps.valid = false;
+
   // Part 2: Find inactive_elem_status. Needed for force computation
   inactive_elem_status.resize(surfaces.size());
   for(int surf=0; surf<(int)surfaces.size(); surf++)
@@ -421,8 +439,147 @@ EmbeddedBoundaryOperator::FindSolidBodies(std::multimap<int, std::pair<int,int>
 
 //------------------------------------------------------------------------------------------------
 
+// Only rank 0 touches the file system. If use_cache is true, on the first run, it parses the ASCII file and
+// writes a binary cache ("<filename>.bin") next to it. Later runs load the cache, as long as the size and
+// modification time of the ASCII file recorded in it still match. The mesh is then broadcast to the other cores.
+void
+EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, bool use_cache, vector<Vec3D> &Xs, vector<Int3> &Es)
+{
+  int mpi_rank = 0;
+  MPI_Comm_rank(comm, &mpi_rank);
+
+  int sizes[2] = {0, 0};
+  if(mpi_rank == 0) {
+    if(!use_cache || !ReadMeshCache(filename, Xs, Es)) {
+      if(!ParseMeshFile(filename, Xs, Es))
+        sizes[0] = -1; //error (already printed)
+      else if(use_cache)
+        WriteMeshCache(filename, Xs, Es);
+    }
+    if(sizes[0] == 0) {
+      sizes[0] = Xs.size();
+      sizes[1] = Es.size();
+    }
+  }
+
+  MPI_Bcast(sizes, 2, MPI_INT, 0, comm);
+  if(sizes[0] < 0) //all the cores exit together
+    exit_mpi();
+
+  Xs.resize(sizes[0]);
+  Es.resize(sizes[1]);
+
+  // Vec3D and Int3 are plain arrays of 3 doubles/ints
+  if(sizes[0]>0)
+    MPI_Bcast((double*)Xs.data(), 3*sizes[0], MPI_DOUBLE, 0, comm);
+  if(sizes[1]>0)
+    MPI_Bcast((int*)Es.data(), 3*sizes[1], MPI_INT, 0, comm);
+}
+
+//------------------------------------------------------------------------------------------------
+
+namespace {
+
+struct MeshCacheHeader {
+  char magic[8]; //!< "M2CSURF" + version
+  int64_t source_size; //!< size of the ASCII file (bytes)
+  int64_t source_mtime; //!< modification time of the ASCII file
+  int64_t nNodes, nElems;
+};
+
+const char mesh_cache_magic[8] = {'M','2','C','S','U','R','F','1'};
+
+bool GetSourceFileStamp(const char *filename, int64_t &size, int64_t &mtime)
+{
+  struct stat st;
+  if(stat(filename, &st) != 0)
+    return false;
+  size = (int64_t)st.st_size;
+  mtime = (int64_t)st.st_mtime;
+  return true;
+}
+
+}
+
+//------------------------------------------------------------------------------------------------
+
+bool
+EmbeddedBoundaryOperator::ReadMeshCache(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es)
+{
+  MeshCacheHeader header, stamp;
+  if(!GetSourceFileStamp(filename, stamp.source_size, stamp.source_mtime))
+    return false; //let ParseMeshFile report the error
+
+  string cache_name = string(filename) + ".bin";
+  FILE *cache = fopen(cache_name.c_str(), "rb");
+  if(cache == NULL)
+    return false;
+
+  bool valid = fread(&header, sizeof(header), 1, cache) == 1 &&
+               memcmp(header.magic, mesh_cache_magic, sizeof(mesh_cache_magic)) == 0 &&
+               header.source_size == stamp.source_size && header.source_mtime == stamp.source_mtime &&
+               header.nNodes >= 0 && header.nNodes <= INT_MAX/3 &&
+               header.nElems >= 0 && header.nElems <= INT_MAX/3;
+  if(valid) {
+    Xs.resize(header.nNodes);
+    Es.resize(header.nElems);
+    valid = fread(Xs.data(), sizeof(Vec3D), Xs.size(), cache) == Xs.size() &&
+            fread(Es.data(), sizeof(Int3), Es.size(), cache) == Es.size();
+  }
+  fclose(cache);
+
+  if(valid) {
+    for(auto&& e : Es)
+      for(int i=0; i<3; i++)
+        if(e[i]<0 || e[i]>=(int)header.nNodes) {
+          valid = false;
+          break;
+        }
+  }
+
+  if(!valid) {
+    print_warning("Warning: Ignoring outdated or corrupted mesh cache %s.\n", cache_name.c_str());
+    Xs.clear();
+    Es.clear();
+  }
+  return valid;
+}
+
+//------------------------------------------------------------------------------------------------
+
 void
-EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es)
+EmbeddedBoundaryOperator::WriteMeshCache(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es)
+{
+  MeshCacheHeader header;
+  if(!GetSourceFileStamp(filename, header.source_size, header.source_mtime))
+    return;
+  memcpy(header.magic, mesh_cache_magic, sizeof(mesh_cache_magic));
+  header.nNodes = Xs.size();
+  header.nElems = Es.size();
+
+  // write to a temporary file, then rename it, so a concurrent run never sees a partial cache
+  string cache_name = string(filename) + ".bin";
+  string tmp_name = cache_name + ".tmp";
+  FILE *cache = fopen(tmp_name.c_str(), "wb");
+  if(cache == NULL) //e.g., read-only directory. Not an error.
+    return;
+
+  bool success = fwrite(&header, sizeof(header), 1, cache) == 1 &&
+                 fwrite(Xs.data(), sizeof(Vec3D), Xs.size(), cache) == Xs.size() &&
+                 fwrite(Es.data(), sizeof(Int3), Es.size(), cache) == Es.size();
+  success = (fclose(cache) == 0) && success;
+
+  if(!success || rename(tmp_name.c_str(), cache_name.c_str()) != 0) {
+    print_warning("Warning: Unable to write mesh cache %s.\n", cache_name.c_str());
+    remove(tmp_name.c_str());
+  } else
+    print("- Wrote mesh cache %s (used in later runs while %s is unchanged).\n", cache_name.c_str(), filename);
+}
+
+//------------------------------------------------------------------------------------------------
+
+bool
+EmbeddedBoundaryOperator::ParseMeshFile(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es)
 {
 
   // read data from the surface input file.
@@ -430,7 +587,7 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
   topFile = fopen(filename, "r");
   if(topFile == NULL) {
     print_error("*** Error: embedded structure surface mesh doesn't exist (%s).\n", filename);
-    exit_mpi();
+    return false;
   }
  
   int MAXLINE = 500;
@@ -462,7 +619,8 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
     else if(same_strings_insensitive(key1_string,"Nodes")){
       if(found_nodes) {//already found nodes... This is a conflict
         print_error("*** Error: Found multiple sets of nodes (keyword 'Nodes') in %s.\n", filename);
-        exit_mpi();
+        fclose(topFile);
+        return false;
       }
       sscanf(line, "%*s %s", key2);
       type_reading = 1;
@@ -472,7 +630,8 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
 
       if(found_elems) {//already found elements... This is a conflict
         print_error("*** Error: Found multiple sets of elements (keyword 'Elements') in %s.\n", filename);
-        exit_mpi();
+        fclose(topFile);
+        return false;
       }
       type_reading = 2;
       found_elems = true;
@@ -482,11 +641,13 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       int count = sscanf(line, "%d %lf %lf %lf", &num1, &x1, &x2, &x3);
       if(count != 4) {
         print_error("*** Error: Cannot interpret line %s (in %s). Expecting a node.\n", line, filename);
-        exit_mpi();
+        fclose(topFile);
+        return false;
       }
       if(num1 < 1) {
         print_error("*** Error: detected a node with index %d in embedded surface file %s.\n", num1, filename);
-        exit_mpi();
+        fclose(topFile);
+        return false;
       }
       if(num1 > maxNode)
         maxNode = num1;
@@ -497,11 +658,13 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       int count = sscanf(line, "%d %d %d %d %d", &num0, &num1, &node1, &node2, &node3);
       if(count != 5) {
         print_error("*** Error: Cannot interpret line %s (in %s). Expecting a triangular element.\n", line, filename);
-        exit_mpi();
+        fclose(topFile);
+        return false;
       }
       if(num0 < 1) {
         print_error("*** Error: detected an element with index %d in embedded surface file %s.\n", num0, filename);
-        exit_mpi();
+        fclose(topFile);
+        return false;
       }
       if(num0 > maxElem)
         maxElem = num0;
@@ -510,7 +673,8 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
     }
     else { // found something I cannot understand...
       print_error("*** Error: Unable to interpret line %s (in %s).\n", line, filename);
-      exit_mpi();
+      fclose(topFile);
+      return false;
     }
 
   }
@@ -519,11 +683,11 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
 
   if(!found_nodes) {
     print_error("*** Error: Unable to find node set in %s.\n", filename);
-    exit_mpi();
+    return false;
   }
   if(!found_elems) {
     print_error("*** Error: Unable to find element set in %s.\n", filename);
-    exit_mpi();
+    return false;
   }
 
   // ----------------------------
@@ -545,7 +709,7 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       id = it1->first;
       if(nodecheck[id]) {
         print_error("*** Error: Found duplicate node (id: %d) in embedded surface file %s.\n", id, filename);
-        exit(-1);
+        return false;
       }
       nodecheck[id] = true;
       Xs[current_id] = it1->second; 
@@ -560,7 +724,7 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       id = it1->first - 1; 
       if(nodecheck[id]) {
         print_error("*** Error: Found duplicate node (id: %d) in embedded surface file %s.\n", id+1, filename);
-        exit(-1);
+        return false;
       }
       nodecheck[id] = true;
       Xs[it1->first - 1] = it1->second;
@@ -582,17 +746,17 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
 
       if(node1<=0 || node1 > nNodes) {
         print_error("*** Error: Detected unknown node number (%d) in element %d (%s).\n", node1, id, filename);
-        exit_mpi();
+        return false;
       }
 
       if(node2<=0 || node2 > nNodes) {
         print_error("*** Error: Detected unknown node number (%d) in element %d (%s).\n", node2, id, filename);
-        exit_mpi();
+        return false;
       }
 
       if(node3<=0 || node3 > nNodes) {
         print_error("*** Error: Detected unknown node number (%d) in element %d (%s).\n", node3, id, filename);
-        exit_mpi();
+        return false;
       }
     }
     else {// nodes are renumbered
@@ -600,19 +764,19 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       auto p1 = old2new.find(node1);
       if(p1 == old2new.end()) { 
         print_error("*** Error: Detected unknown node number (%d) in element %d (%s).\n", node1, id, filename);
-        exit_mpi();
+        return false;
       }
 
       auto p2 = old2new.find(node2);
       if(p2 == old2new.end()) { 
         print_error("*** Error: Detected unknown node number (%d) in element %d (%s).\n", node2, id, filename);
-        exit_mpi();
+        return false;
       }
 
       auto p3 = old2new.find(node3);
       if(p3 == old2new.end()) { 
         print_error("*** Error: Detected unknown node number (%d) in element %d (%s).\n", node3, id, filename);
-        exit_mpi();
+        return false;
       }
     }
   }
@@ -635,7 +799,7 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       id = (*it)[0];
       if(elemcheck[id]) {
         print_error("*** Error: Found duplicate element (id: %d) in embedded surface file %s.\n", id, filename);
-        exit_mpi();
+        return false;
       }
       elemcheck[id] = true;
 
@@ -661,7 +825,7 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
       id = (*it)[0] - 1;
       if(elemcheck[id]) {
         print_error("*** Error: Found duplicate element (id: %d) in embedded surface file %s.\n", id, filename);
-        exit_mpi();
+        return false;
       }
       elemcheck[id] = true;
 
@@ -680,6 +844,7 @@ EmbeddedBoundaryOperator::ReadMeshFile(const char *filename, vector<Vec3D> &Xs,
     }
   }
 
+  return true;
 }
 
 //------------------------------------------------------------------------------------------------
@@ -743,6 +908,8 @@ EmbeddedBoundaryOperator::ComputeForces(SpaceVariable3D &V, SpaceVariable3D &ID)
 
   Vec5D***  v  = (Vec5D***) V.GetDataPointer();
   double*** id = ID.GetDataPointer();
+
+  CheckGaussPointStencils();
   
   // loop through all the embedded surfaces
   for(int surf=0; surf<(int)surfaces.size(); surf++) {
@@ -775,6 +942,9 @@ EmbeddedBoundaryOperator::ComputeForces(SpaceVariable3D &V, SpaceVariable3D &ID)
         exit_mpi();
     }
 
+    if(!gp_stencils[surf].valid)
+      BuildGaussPointStencils(surf, np, id);
+
     // ------------------------------------
     if(np==0) //one-way coupling
       continue;
@@ -983,11 +1153,11 @@ EmbeddedBoundaryOperator::ComputeForcesOnSurfaceDirectly(int surf, int np, Vec5D
   vector<double>& An(Anodal[surf]);
   An.assign(surfaces[surf].X.size(), 0.0);
 
-  int mpi_rank;
+  int mpi_rank, mpi_size;
   MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
 
   // Collect info about the surface and intersection results
-  vector<Vec3D>&  Xs(surfaces[surf].X);
   vector<Int3>&   Es(surfaces[surf].elems);
   vector<Vec3D>&  Ns(surfaces[surf].elemNorm);
   vector<double>& As(surfaces[surf].elemArea);
@@ -996,24 +1166,201 @@ EmbeddedBoundaryOperator::ComputeForcesOnSurfaceDirectly(int surf, int np, Vec5D
   vector<double> gweight(np, 0.0);
   vector<Vec3D>  gbary(np, 0.0); //barycentric coords of Gauss points (symmetric) 
   MathTools::GaussQuadraturesTriangle::GetParameters(np, gweight.data(), gbary.data());
+
+  GaussPointStencils &gps(gp_stencils[surf]);
+  assert(gps.valid);
+  vector<int>& scope(gps.scope);
+  double internal_pressure = iod_embedded_surfaces[surf]->internal_pressure;
+
+  // Step 1: Interpolate pressure at all the (lofted) Gauss points owned by this subdomain, using cached stencils
+  vector<double> pg(gps.gp.size(), 0.0);
+  for(int s=0; s<(int)scope.size(); s++) {
+    int tid = scope[s];
+    for(int e=gps.offset[s]; e<gps.offset[s+1]; e++) {
+      int side = gps.gp[e]%2;
+      if(status[tid]==3 || status[tid]==side+1) //this side faces the interior of a solid body
+        continue;
+      pg[e] = InterpolatePressure(gps.xg[e], gps.ijk0[e], gps.xi[e], gps.sameside[e], v, id);
+    }
+  }
+
+  // Step 2: Integrate
+  vector<Vec3D> tg(np, 0.0); // traction at each Gauss point, (-pI + tau)n --> a Vec3D
+  for(int s=0; s<(int)scope.size(); s++) {
+
+    int tid = scope[s]; //triangle id
+    Int3 n(Es[tid][0], Es[tid][1], Es[tid][2]);
+
+    for(int p=0; p<np; p++)
+      tg[p] = 0.0;
+
+    for(int e=gps.offset[s]; e<gps.offset[s+1]; e++) {
+      int p = gps.gp[e]/2;
+      int side = gps.gp[e]%2;
+      Vec3D normal = Ns[tid];
+      if(side==1)
+        normal *= -1.0;
+      if(status[tid]==3 || status[tid]==side+1) //this side faces the interior of a solid body 
+        tg[p] += -1.0*internal_pressure*normal;
+      else
+        tg[p] += -1.0*pg[e]*normal;
+    }
+
+    // Now, tg carries traction from both sides of the triangle
+
+    // Integrate (See KW's notes for the formula)
+    for(int p=0; p<np; p++) {
+      tg[p] *= As[tid];
+      // each node of the triangle gets some load from this Gauss point
+      for(int node=0; node<3; node++) {
+        double coeff = gweight[p]*gbary[p][node];
+        Fs[n[node]] += coeff*tg[p];
+        An[n[node]] += coeff*As[tid];
+      } 
+    }
+  }
+
+  // Step 3: Processor 0 assembles the loads on the entire surface. Each subdomain only sends the nodes
+  //         that it touches (gps.nodes), which are known to proc 0 (gps.recv_nodes).
+  int nNodes = gps.nodes.size();
+  vector<double> buf(4*nNodes);
+  for(int i=0; i<nNodes; i++) {
+    int node = gps.nodes[i];
+    for(int d=0; d<3; d++)
+      buf[4*i+d] = Fs[node][d];
+    buf[4*i+3] = An[node];
+  }
+
+  if(mpi_rank==0) {
+    vector<int> counts(mpi_size), displs(mpi_size);
+    for(int proc=0; proc<mpi_size; proc++) {
+      counts[proc] = 4*gps.recv_counts[proc];
+      displs[proc] = 4*gps.recv_displs[proc];
+    }
+    vector<double> rbuf(4*gps.recv_nodes.size());
+    MPI_Gatherv(buf.data(), 4*nNodes, MPI_DOUBLE, rbuf.data(), counts.data(), displs.data(), MPI_DOUBLE,
+                0, comm);
+    for(int i=gps.recv_counts[0]; i<(int)gps.recv_nodes.size(); i++) { //skip my own data
+      int node = gps.recv_nodes[i];
+      for(int d=0; d<3; d++)
+        Fs[node][d] += rbuf[4*i+d];
+      An[node] += rbuf[4*i+3];
+    }
+
+    for(int i=0; i<(int)Fs.size(); i++)
+      FAs[i] = An[i]==0.0 ? 0.0 : Fs[i]/An[i];
+  } 
+  else
+    MPI_Gatherv(buf.data(), 4*nNodes, MPI_DOUBLE, NULL, NULL, NULL, MPI_DOUBLE, 0, comm);
+
+  MPI_Barrier(comm);
+}
+
+//------------------------------------------------------------------------------------------------
+
+void
+EmbeddedBoundaryOperator::CheckGaussPointStencils()
+{
+  if(gp_stencils.size() != surfaces.size())
+    gp_stencils.assign(surfaces.size(), GaussPointStencils());
+
+  // The stencils of one surface depend on all the surfaces (through "Intersects"). So, they are
+  // invalidated together.
+  int invalid = 0;
+  vector<int> scope;
+  for(int surf=0; surf<(int)surfaces.size(); surf++) {
+    GaussPointStencils &gps(gp_stencils[surf]);
+    vector<Vec3D> &Xs(surfaces[surf].X);
+    double tol = iod_embedded_surfaces[surf]->stencil_reuse_tol;
+    if(!gps.valid || tol<0.0 || Xs.size() != gps.X0.size() || (int)surfaces[surf].elems.size() != gps.nElems) {
+      invalid = 1;
+      break;
+    }
+    double tol2 = tol*tol;
+    for(int i=0; i<(int)Xs.size(); i++)
+      if((Xs[i]-gps.X0[i]).norm2() > tol2) {
+        invalid = 1;
+        break;
+      }
+    if(invalid)
+      break;
+    if(intersector[surf]) {
+      intersector[surf]->GetElementsInScope1(scope);
+      if(scope != gps.scope) {
+        invalid = 1;
+        break;
+      }
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, &invalid, 1, MPI_INT, MPI_MAX, comm);
+
+  if(invalid)
+    for(auto&& gps : gp_stencils)
+      gps.valid = false;
+}
+
+//------------------------------------------------------------------------------------------------
+
+void
+EmbeddedBoundaryOperator::BuildGaussPointStencils(int surf, int np, double*** id)
+{
+  GaussPointStencils &gps(gp_stencils[surf]);
+
+  vector<Vec3D>&  Xs(surfaces[surf].X);
+  vector<Int3>&   Es(surfaces[surf].elems);
+  vector<Vec3D>&  Ns(surfaces[surf].elemNorm);
+  vector<int>&    status(inactive_elem_status[surf]);
+
+  gps.X0 = Xs;
+  gps.nElems = Es.size();
+  gps.scope.clear();
+  if(intersector[surf])
+    intersector[surf]->GetElementsInScope1(gps.scope);
+  gps.offset.assign(1, 0);
+  gps.gp.clear();
+  gps.xg.clear();
+  gps.ijk0.clear();
+  gps.xi.clear();
+  gps.sameside.clear();
+  gps.nodes.clear();
+  gps.recv_counts.clear();
+  gps.recv_displs.clear();
+  gps.recv_nodes.clear();
+  gps.valid = true;
+
+  if(np==0 || twoD_to_threeD[surf]) //nothing else is needed
+    return;
+
+  vector<double> gweight(np, 0.0);
+  vector<Vec3D>  gbary(np, 0.0); //barycentric coords of Gauss points (symmetric) 
+  MathTools::GaussQuadraturesTriangle::GetParameters(np, gweight.data(), gbary.data());
  
   vector<Vec3D> xgs(np, 0.0); //internal var.
-    
-  vector<int> scope;
-  intersector[surf]->GetElementsInScope1(scope);
+  vector<Vec3D> xgls(np, 0.0); //internal var. (lofted Gauss points)
+  vector<double> lofts(np, 0.0); //internal var.
+  vector<Int3> ijk0s, ijks; //internal var.
 
   //Note that different subdomain scopes overlap. We need to avoid repetition!
-  for(auto it = scope.begin(); it != scope.end(); it++) {
+  for(auto it = gps.scope.begin(); it != gps.scope.end(); it++) {
 
     int tid = *it; //triangle id
     Int3 n(Es[tid][0], Es[tid][1], Es[tid][2]);
 
+    for(int node=0; node<3; node++)
+      gps.nodes.push_back(n[node]);
+
     // Get Gauss points (before lofting)
     for(int p=0; p<np; p++) 
       xgs[p] = gbary[p][0]*Xs[n[0]] + gbary[p][1]*Xs[n[1]] + gbary[p][2]*Xs[n[2]];
 
-    // traction at each Gauss point, (-pI + tau)n --> a Vec3D
-    vector<Vec3D> tg(np, 0.0); 
+    //before lofting, we need to make sure the original Gauss points are in the domain.
+    global_mesh_ptr->FindCellsCoveringPoints(xgs, ijk0s, false);
+
+    // Lofting (Multiple processors may process the same point (xg). Make sure they produce the same result
+    for(int p=0; p<np; p++)
+      lofts[p] = ijk0s[p][0]==INT_MIN ? 0.0
+               : CalculateLoftingHeight(xgs[p], iod_embedded_surfaces[surf]->gauss_points_lofting);
 
     assert(fabs(Ns[tid].norm()-1.0)<1.0e-12); //normal must be valid!
 
@@ -1023,22 +1370,22 @@ EmbeddedBoundaryOperator::ComputeForcesOnSurfaceDirectly(int surf, int np, Vec5D
       if(side==1)
         normal *= -1.0;
 
+      // Check if the lofted Gauss points are in this subdomain.
+      for(int p=0; p<np; p++)
+        xgls[p] = xgs[p] + lofts[p]*normal;
+      global_mesh_ptr->FindCellsCoveringPoints(xgls, ijks, false);
+
       for(int p=0; p<np; p++) { //loop through Gauss points
 
-        Vec3D xg = xgs[p];
+        if(ijk0s[p][0]==INT_MIN)
+          continue; //the original Gauss point is outside the domain. There can be complexities.
 
-        Int3 ijk0;
-        if(!global_mesh_ptr->FindCellCoveringPoint(xg, ijk0, false))
-          continue; //before lofting, we need to make sure the original Gauss point is in the domain.
-                    //otherwise, there can be complexities.
+        Vec3D xg = xgls[p]; //lofted
+        double loft = lofts[p];
+        Int3 &ijk0(ijk0s[p]);
 
-        // Lofting (Multiple processors may process the same point (xg). Make sure they produce the same result
-        double loft = CalculateLoftingHeight(xg, iod_embedded_surfaces[surf]->gauss_points_lofting);
-        xg += loft*normal;
-          
-        // Check if this Gauss point is in this subdomain.
-        Int3 ijk;
-        bool foundit = global_mesh_ptr->FindCellCoveringPoint(xg, ijk, false);
+        Int3 ijk = ijks[p];
+        bool foundit = ijk[0]!=INT_MIN;
         if(!foundit) { //pull it back to the domain (not necessarily the current subdomain)
           Vec3D xg0 = xg - loft*normal;
           double pull_back = 0.5*loft;
@@ -1059,49 +1406,46 @@ EmbeddedBoundaryOperator::ComputeForcesOnSurfaceDirectly(int surf, int np, Vec5D
         if(!coordinates_ptr->IsHere(ijk[0],ijk[1],ijk[2],false))
           continue;
 
-//        fprintf(stdout,"[%d] Working on triangle %d, side %d.\n", mpi_rank, tid, side);
-        // Calculate traction at Gauss point on this "side"
+        gps.gp.push_back(2*p + side);
+        gps.xg.push_back(xg);
+        gps.ijk0.push_back(Int3(INT_MAX));
+        gps.xi.push_back(Vec3D(0.0));
+        gps.sameside.push_back(0);
+
         if(status[tid]==3 || status[tid]==side+1) //this side faces the interior of a solid body 
-          tg[p] += -1.0*iod_embedded_surfaces[surf]->internal_pressure*normal;
-        else 
-          tg[p] += CalculateTractionAtPoint(xg, normal, v, id); 
+          continue; //no need to interpolate
 
+        FindTractionStencil(xg, normal, id, gps.ijk0.back(), gps.xi.back(), gps.sameside.back());
       }
-
     }
 
-//    fprintf(stdout,"[%d] Triangle %d: tg = %e %e %e, mag = %e.\n", mpi_rank, tid, tg[0][0], tg[0][1], tg[0][2],
-//            tg[0].norm());
-
-    // Now, tg carries traction from both sides of the triangle
-
-    // Integrate (See KW's notes for the formula)
-    for(int p=0; p<np; p++) {
-      tg[p] *= As[tid];
-      // each node of the triangle gets some load from this Gauss point
-      for(int node=0; node<3; node++) {
-        double coeff = gweight[p]*gbary[p][node];
-        Fs[n[node]] += coeff*tg[p];
-        An[n[node]] += coeff*As[tid];
-      } 
-    }
+    gps.offset.push_back(gps.gp.size());
   }
 
-  // Processor 0 assembles the loads on the entire surface
-  if(mpi_rank==0) {
-    MPI_Reduce(MPI_IN_PLACE, (double*)Fs.data(), 3*Fs.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
-    MPI_Reduce(MPI_IN_PLACE, An.data(), An.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
-  } else {
-    MPI_Reduce((double*)Fs.data(), NULL, 3*Fs.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
-    MPI_Reduce(An.data(), NULL, An.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
-  }
+  std::sort(gps.nodes.begin(), gps.nodes.end());
+  gps.nodes.erase(std::unique(gps.nodes.begin(), gps.nodes.end()), gps.nodes.end());
 
+  // Proc 0 collects the nodes touched by all the subdomains (for assembling the loads)
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
+  int nNodes = gps.nodes.size();
   if(mpi_rank==0) {
-    for(int i=0; i<(int)Fs.size(); i++)
-      FAs[i] = An[i]==0.0 ? 0.0 : Fs[i]/An[i];
+    gps.recv_counts.resize(mpi_size);
+    gps.recv_displs.resize(mpi_size);
+    MPI_Gather(&nNodes, 1, MPI_INT, gps.recv_counts.data(), 1, MPI_INT, 0, comm);
+    int total = 0;
+    for(int proc=0; proc<mpi_size; proc++) {
+      gps.recv_displs[proc] = total;
+      total += gps.recv_counts[proc];
+    }
+    gps.recv_nodes.resize(total);
+    MPI_Gatherv(gps.nodes.data(), nNodes, MPI_INT, gps.recv_nodes.data(), gps.recv_counts.data(),
+                gps.recv_displs.data(), MPI_INT, 0, comm);
+  } else {
+    MPI_Gather(&nNodes, 1, MPI_INT, NULL, 1, MPI_INT, 0, comm);
+    MPI_Gatherv(gps.nodes.data(), nNodes, MPI_INT, NULL, NULL, NULL, MPI_INT, 0, comm);
   }
-
-  MPI_Barrier(comm);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -1138,6 +1482,9 @@ EmbeddedBoundaryOperator::ComputeForcesOnSurface2DTo3D(int surf, int np, Vec5D**
   MathTools::GaussQuadraturesTriangle::GetParameters(np, gweight.data(), gbary.data());
  
   vector<Vec3D> xgs(np, 0.0); //internal var.
+  vector<Vec3D> xgls(np, 0.0); //internal var. (lofted Gauss points)
+  vector<double> lofts(np, 0.0); //internal var.
+  vector<Int3> ijk0s, ijks; //internal var.
   vector<Vec3D> tgs(np, 0.0); //internal var.
   vector<int> special_tag(np, 0); //internal var.  
 
@@ -1167,27 +1514,36 @@ EmbeddedBoundaryOperator::ComputeForcesOnSurface2DTo3D(int surf, int np, Vec5D**
       special_tag[p] = 0;
     }
 
+    //before lofting, we need to make sure the original Gauss points are in the domain.
+    global_mesh_ptr->FindCellsCoveringPoints(xgs, ijk0s, false);
+
+    // Lofting (Multiple processors may process the same point (xg). Make sure they produce the same result
+    for(int p=0; p<np; p++)
+      lofts[p] = ijk0s[p][0]==INT_MIN ? 0.0
+               : CalculateLoftingHeight(xgs[p], iod_embedded_surfaces[surf]->gauss_points_lofting);
+
     for(int side=0; side<2; side++) { //loop through the two sides
 
       Vec3D normal = Ns[tid];
       if(side==1)
         normal *= -1.0;
 
+      // Check if the lofted Gauss points are in this subdomain.
+      for(int p=0; p<np; p++)
+        xgls[p] = xgs[p] + lofts[p]*normal;
+      global_mesh_ptr->FindCellsCoveringPoints(xgls, ijks, false);
+
       for(int p=0; p<np; p++) { //loop through Gauss points
-        Vec3D xg = xgs[p]; //has to be a new var because it will be lofted
 
-        Int3 ijk0;
-        if(!global_mesh_ptr->FindCellCoveringPoint(xg, ijk0, false))
-          continue; //before lofting, we need to make sure the original Gauss point is in the domain.
-                    //otherwise, there can be complexities.
+        if(ijk0s[p][0]==INT_MIN)
+          continue; //the original Gauss point is outside the domain. There can be complexities.
 
-        // Lofting (Multiple processors may process the same point (xg). Make sure they produce the same result
-        double loft = CalculateLoftingHeight(xg, iod_embedded_surfaces[surf]->gauss_points_lofting);
-        xg += loft*normal;
-          
-        // Check if this Gauss point is in this subdomain.
-        Int3 ijk;
-        bool foundit = global_mesh_ptr->FindCellCoveringPoint(xg, ijk, false);
+        Vec3D xg = xgls[p]; //lofted
+        double loft = lofts[p];
+        Int3 &ijk0(ijk0s[p]);
+
+        Int3 ijk = ijks[p];
+        bool foundit = ijk[0]!=INT_MIN;
         if(!foundit) { //pull it back to the domain (not necessarily the current subdomain)
           Vec3D xg0 = xg - loft*normal; 
           double pull_back = 0.5*loft;
@@ -1456,13 +1812,31 @@ EmbeddedBoundaryOperator::CalculateLoftingHeight(Vec3D &p, double factor)
 // Calculates the one-sided traction from the side indicated by "normal"
 Vec3D
 EmbeddedBoundaryOperator::CalculateTractionAtPoint(Vec3D &p, Vec3D &normal, Vec5D*** v, double*** id)
+{
+  Int3 ijk0;
+  Vec3D xi;
+  unsigned char sameside;
+  FindTractionStencil(p, normal, id, ijk0, xi, sameside);
+
+  double my_pressure = InterpolatePressure(p, ijk0, xi, sameside, v, id);
+
+  //TODO: Add viscous force later!
+
+  return -1.0*my_pressure*normal;  
+
+}
+
+//------------------------------------------------------------------------------------------------
+
+void
+EmbeddedBoundaryOperator::FindTractionStencil(Vec3D &p, Vec3D &normal, double*** id, Int3 &ijk0, Vec3D &xi,
+                                              unsigned char &sameside_mask)
 {
   //int mpi_rank;
   //MPI_Comm_rank(comm, &mpi_rank);
 
 
-  Int3 ijk0(INT_MAX);
-  Vec3D xi;
+  ijk0 = INT_MAX;
   global_mesh_ptr->FindElementCoveringPoint(p, ijk0, &xi, true);
 
   int i,j,k;
@@ -1528,12 +1902,29 @@ EmbeddedBoundaryOperator::CalculateTractionAtPoint(Vec3D &p, Vec3D &normal, Vec5
       fprintf(stdout,"\033[0;35mWarning: Applied a lofting height of %e (iter=%d) to find valid nodes for interpolating \n"
                                "         pressure at Gauss point (%e, %e, %e).\033[0m\n",
               loft, iter, p[0], p[1], p[2]);
-    //if found_sameside == false, will trigger another warning message below.
+    //if found_sameside == false, will trigger another warning message in InterpolatePressure.
   }
 
+  sameside_mask = 0;
+  for(int dk=0; dk<=1; dk++)
+    for(int dj=0; dj<=1; dj++)
+      for(int di=0; di<=1; di++)
+        if(sameside[dk][dj][di])
+          sameside_mask |= 1 << (dk*4 + dj*2 + di);
+}
+
+//------------------------------------------------------------------------------------------------
+
+double
+EmbeddedBoundaryOperator::InterpolatePressure(Vec3D &p, Int3 &ijk0, Vec3D &xi, unsigned char sameside_mask,
+                                              Vec5D*** v, double*** id)
+{
+  int i,j,k;
+
   // interpolate pressure at the point
   // We populate opposite side and inactive nodes by average of same side / active nodes.
   // TODO: This can be done more carefully.
+  bool sameside[2][2][2];
   double pressure[2][2][2];
   double total_pressure = 0.0;
   int n_pressure = 0;
@@ -1541,13 +1932,15 @@ EmbeddedBoundaryOperator::CalculateTractionAtPoint(Vec3D &p, Vec3D &normal, Vec5
     for(int dj=0; dj<=1; dj++)
       for(int di=0; di<=1; di++) {
 
-        if(!sameside[dk][dj][di])
-          continue;
-
         i = ijk0[0] + di;
         j = ijk0[1] + dj;
         k = ijk0[2] + dk;
 
+        // re-check "id", in case the stencil was computed earlier
+        sameside[dk][dj][di] = (sameside_mask & (1 << (dk*4 + dj*2 + di))) && id[k][j][i] != INACTIVE_MATERIAL_ID;
+        if(!sameside[dk][dj][di])
+          continue;
+
         //fprintf(stdout,"[%d] side = %d: (%d,%d,%d), p = %e.\n", mpi_rank, side, i,j,k, v[k][j][i][4]);
         pressure[dk][dj][di] = v[k][j][i][4]; //get pressure
         total_pressure += pressure[dk][dj][di];
@@ -1570,22 +1963,13 @@ EmbeddedBoundaryOperator::CalculateTractionAtPoint(Vec3D &p, Vec3D &normal, Vec5
         if(sameside[dk][dj][di])
           continue;
 
-        i = ijk0[0] + di;
-        j = ijk0[1] + dj;
-        k = ijk0[2] + dk;
-
         pressure[dk][dj][di] = avg_pressure;
       }
   
   //Now, perform trilinear interpolation to get p at the point
-  double my_pressure = MathTools::trilinear_interpolation(pressure[0][0][0], pressure[0][0][1],
+  return MathTools::trilinear_interpolation(pressure[0][0][0], pressure[0][0][1],
                                       pressure[0][1][0], pressure[0][1][1], pressure[1][0][0], 
                                       pressure[1][0][1], pressure[1][1][0], pressure[1][1][1], (double*)xi);
-
-  //TODO: Add viscous force later!
-
-  return -1.0*my_pressure*normal;  
-
 }
 
 //------------------------------------------------------------------------------------------------
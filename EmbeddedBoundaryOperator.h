@@ -53,6 +53,27 @@ class EmbeddedBoundaryOperator {
 
   vector<std::tuple<UserDefinedDynamics*, void*, DestroyUDD*> > dynamics_calculator; //!< the 1st one is the calculator
 
+  //! Gauss point stencils for force computation (one per surface). They are computed once and reused until
+  //! (1) a surface moves by more than "GaussPointStencilReuseTolerance", (2) the scope of an intersector
+  //! changes, or (3) FindSolidBodies is called. Only the Gauss points owned by this subdomain are stored.
+  //! Entries are grouped by triangle (same order as "scope"), then by side, then by Gauss point.
+  struct GaussPointStencils {
+    bool valid;
+    vector<Vec3D> X0; //!< nodal coords of the surface when the stencils were computed
+    int nElems;
+    vector<int> scope; //!< triangles in the scope of the intersector (subdomain)
+    vector<int> offset; //!< entries of scope[s]: offset[s], ..., offset[s+1]-1
+    vector<int> gp; //!< Gauss point (0 ~ np-1) * 2 + side (0 or 1)
+    vector<Vec3D> xg; //!< lofted Gauss point
+    vector<Int3> ijk0; //!< element (in the primal mesh) used for interpolation
+    vector<Vec3D> xi; //!< local coords within ijk0
+    vector<unsigned char> sameside; //!< bit (dk*4+dj*2+di): node is on the same side and active
+    vector<int> nodes; //!< surface nodes that get loads from this subdomain (sorted)
+    vector<int> recv_counts, recv_displs, recv_nodes; //!< (proc 0 only) nodes of all the subdomains
+    GaussPointStencils() : valid(false), nElems(0) {}
+  };
+  vector<GaussPointStencils> gp_stencils;
+
   //! Mesh info (Not used when the class is used for special purposes, e.g., DynamicLoadCalculator)
   //! These information are generally needed when the surface needs to be "tracked" within the M2C mesh
   DataManagers3D* dms_ptr;
@@ -120,7 +141,11 @@ public:
 
 private:
 
-  void ReadMeshFile(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es);
+  //! rank 0 reads the mesh (from the binary cache, if enabled and valid) and broadcasts it to the other cores
+  void ReadMeshFile(const char *filename, bool use_cache, vector<Vec3D> &Xs, vector<Int3> &Es);
+  bool ParseMeshFile(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es); //!< ASCII (top file). false: error
+  bool ReadMeshCache(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es); //!< false if absent/outdated
+  void WriteMeshCache(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es);
 
   void SetupUserDefinedDynamicsCalculator(); //!< setup dynamics_calculator
 
@@ -134,11 +159,24 @@ private:
 
   int CombineSharedGaussPointData(vector<double>& data4d, vector<double>& shared_data2d);
 
+  //! Check whether the stencils in gp_stencils remain valid (collective)
+  void CheckGaussPointStencils();
+
+  //! Compute gp_stencils[surf]
+  void BuildGaussPointStencils(int surf, int np, double*** id);
+
   double CalculateLoftingHeight(Vec3D &p, double factor);
 
   //! Compute one-sided traction from the "side" indicated by "normal"
   Vec3D CalculateTractionAtPoint(Vec3D &p, Vec3D &normal/*towards the "side"*/, Vec5D*** v, double*** id);
 
+  //! Find the element covering p, and the nodes of this element on the "side" indicated by "normal"
+  void FindTractionStencil(Vec3D &p, Vec3D &normal, double*** id, Int3 &ijk0, Vec3D &xi,
+                           unsigned char &sameside);
+
+  //! Interpolate pressure at p using the stencil found by FindTractionStencil
+  double InterpolatePressure(Vec3D &p, Int3 &ijk0, Vec3D &xi, unsigned char sameside, Vec5D*** v, double*** id);
+
 };
 
 
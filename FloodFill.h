@@ -40,9 +40,10 @@ public:
   /** Flood-fill nodes in the physical domain (excluding ghost nodes outside the physical domain)
    *  based on edge obstructions. Returns the number of colors for unoccluded nodes. "occluded_nodes" must include
    *  occluded internal ghost nodes. 
-   *  Colors are: 0 (occluded), 1, 2, ... */
+   *  Colors are: 0 (occluded), 1, 2, ... 
+   *  Local labeling uses union-find; colors are unionized across subdomains by min-label propagation. */
   int FillBasedOnEdgeObstructions(SpaceVariable3D& Obs, int non_obstruction_flag,
-                                  std::set<Int3>& occluded_nodes, SpaceVariable3D& Color);
+                                  const std::vector<Int3>& occluded_nodes, SpaceVariable3D& Color);
 
 
 
@@ -5,7 +5,7 @@
 
 #include<GlobalMeshInfo.h>
 #include<SpaceVariable.h>
-#include<algorithm> //std::upper_bound
+#include<algorithm> //std::upper_bound, std::sort, std::unique
 
 //------------------------------------------------------------------
 
@@ -148,6 +148,29 @@ GlobalMeshInfo::GetSubdomainInfo(MPI_Comm& comm, DataManagers3D& dms)
     assert(subD_neighbors_face[proc].size()<=6);
   }
 
+  // Step 5: Setup the owner map (used to find the owner of any cell directly)
+  subD_i_start.clear();
+  subD_j_start.clear();
+  subD_k_start.clear();
+  for(int proc=0; proc<size; proc++) {
+    subD_i_start.push_back(subD_ijk_min[proc][0]);
+    subD_j_start.push_back(subD_ijk_min[proc][1]);
+    subD_k_start.push_back(subD_ijk_min[proc][2]);
+  }
+  for(auto&& starts : {&subD_i_start, &subD_j_start, &subD_k_start}) {
+    std::sort(starts->begin(), starts->end());
+    starts->erase(std::unique(starts->begin(), starts->end()), starts->end());
+  }
+
+  int nI = subD_i_start.size(), nJ = subD_j_start.size(), nK = subD_k_start.size();
+  assert(nI*nJ*nK == size);
+  subD_owner_map.assign(nI*nJ*nK, none);
+  for(int proc=0; proc<size; proc++) {
+    int I = std::lower_bound(subD_i_start.begin(), subD_i_start.end(), subD_ijk_min[proc][0]) - subD_i_start.begin();
+    int J = std::lower_bound(subD_j_start.begin(), subD_j_start.end(), subD_ijk_min[proc][1]) - subD_j_start.begin();
+    int K = std::lower_bound(subD_k_start.begin(), subD_k_start.end(), subD_ijk_min[proc][2]) - subD_k_start.begin();
+    subD_owner_map[I + nI*(J + nJ*K)] = proc;
+  }
 
   S.Destroy();
 
@@ -404,56 +427,71 @@ GlobalMeshInfo::FindCellCoveringPoint(Vec3D &p, Int3 &ijk, bool include_ghost_la
   if(!IsPointInDomain(p, include_ghost_layer))
     return false;
 
-  double shift = 0.5;
-
-  if(include_ghost_layer && p[0]<x_glob[0]-shift*dx_glob[0]) {
-    ijk[0] = -1;  
-  } else {
-    bool found = false;
-    for(int i=0; i<(int)x_glob.size(); i++) {
-      if(p[0]<x_glob[i]+shift*dx_glob[i]) {
-        ijk[0] = i;
-        found = true;
-        break;
-      }
-    }
-    if(!found)
-      ijk[0] = include_ghost_layer ? x_glob.size() : x_glob.size() - 1;
-  }
+  ijk[0] = FindCellIndex1D(p[0], x_glob, dx_glob, include_ghost_layer);
+  ijk[1] = FindCellIndex1D(p[1], y_glob, dy_glob, include_ghost_layer);
+  ijk[2] = FindCellIndex1D(p[2], z_glob, dz_glob, include_ghost_layer);
 
+  return true;
+}
 
-  if(include_ghost_layer && p[1]<y_glob[0]-shift*dy_glob[0]) {
-    ijk[1] = -1;  
-  } else {
-    bool found = false;
-    for(int i=0; i<(int)y_glob.size(); i++) {
-      if(p[1]<y_glob[i]+shift*dy_glob[i]) {
-        ijk[1] = i;
-        found = true;
-        break;
-      }
+//------------------------------------------------------------------
+
+int
+GlobalMeshInfo::FindCellsCoveringPoints(std::vector<Vec3D> &points, std::vector<Int3> &ijk,
+                                        bool include_ghost_layer)
+{
+  ijk.resize(points.size());
+
+  // Consecutive points are often close to each other (e.g., Gauss points of a triangle, probes along a line).
+  // So we first check the cell found for the previous point before doing a binary search.
+  Int3 guess(-2,-2,-2);
+  int counter = 0;
+  for(int n=0; n<(int)points.size(); n++) {
+    Vec3D &p(points[n]);
+    if(!IsPointInDomain(p, include_ghost_layer)) {
+      ijk[n] = Int3(INT_MIN,INT_MIN,INT_MIN);
+      continue;
     }
-    if(!found)
-      ijk[1] = include_ghost_layer ? y_glob.size() : y_glob.size() - 1;
+    ijk[n][0] = FindCellIndex1D(p[0], x_glob, dx_glob, include_ghost_layer, guess[0]);
+    ijk[n][1] = FindCellIndex1D(p[1], y_glob, dy_glob, include_ghost_layer, guess[1]);
+    ijk[n][2] = FindCellIndex1D(p[2], z_glob, dz_glob, include_ghost_layer, guess[2]);
+    guess = ijk[n];
+    counter++;
   }
 
+  return counter;
+}
 
-  if(include_ghost_layer && p[2]<z_glob[0]-shift*dz_glob[0]) {
-    ijk[2] = -1;  
-  } else {
-    bool found = false;
-    for(int i=0; i<(int)z_glob.size(); i++) {
-      if(p[2]<z_glob[i]+shift*dz_glob[i]) {
-        ijk[2] = i;
-        found = true;
-        break;
-      }
-    }
-    if(!found)
-      ijk[2] = include_ghost_layer ? z_glob.size() : z_glob.size() - 1;
+//------------------------------------------------------------------
+
+int
+GlobalMeshInfo::FindCellIndex1D(double p, std::vector<double> &x, std::vector<double> &dx,
+                                bool include_ghost_layer, int guess)
+{
+  // Cell i covers [x[i]-0.5*dx[i], x[i]+0.5*dx[i]). We look for the first cell whose upper face is above p.
+  int N = x.size();
+
+  if(include_ghost_layer && p<x[0]-0.5*dx[0])
+    return -1;
+
+  if(guess>=0 && guess<N) { //check the guess first
+    if(p<x[guess]+0.5*dx[guess] && (guess==0 || p>=x[guess-1]+0.5*dx[guess-1]))
+      return guess;
   }
 
-  return true;
+  int lo = 0, hi = N, mid; //the answer is in [lo, hi]
+  while(lo<hi) {
+    mid = (lo+hi)/2;
+    if(p<x[mid]+0.5*dx[mid])
+      hi = mid;
+    else
+      lo = mid+1;
+  }
+
+  if(lo==N) //beyond the last cell face
+    return include_ghost_layer ? N : N-1;
+
+  return lo;
 }
 
 //------------------------------------------------------------------
@@ -497,14 +535,19 @@ GlobalMeshInfo::GetOwnerOfCell(int i, int j, int k, bool include_ghost_layer)
     if(k==(int)z_glob.size())  k = z_glob.size()-1;
   }
 
-  for(int proc=0; proc<(int)subD_ijk_min.size(); proc++) {
-    if(k >= subD_ijk_min[proc][2] && k < subD_ijk_max[proc][2] &&
-       j >= subD_ijk_min[proc][1] && j < subD_ijk_max[proc][1] &&
-       i >= subD_ijk_min[proc][0] && i < subD_ijk_max[proc][0])
-      return proc; //got you!
-  }
+  if(i<0 || i>=(int)x_glob.size() || j<0 || j>=(int)y_glob.size() || k<0 || k>=(int)z_glob.size())
+    return -1; //not found!
+
+  // find the slab in each direction
+  int I = int(std::upper_bound(subD_i_start.begin(), subD_i_start.end(), i) - subD_i_start.begin()) - 1;
+  int J = int(std::upper_bound(subD_j_start.begin(), subD_j_start.end(), j) - subD_j_start.begin()) - 1;
+  int K = int(std::upper_bound(subD_k_start.begin(), subD_k_start.end(), k) - subD_k_start.begin()) - 1;
+  assert(I>=0 && J>=0 && K>=0);
+
+  int proc = subD_owner_map[I + subD_i_start.size()*(J + subD_j_start.size()*K)];
+  assert(proc>=0 && IsCellInSubdomain(i,j,k,proc));
 
-  return -1; //not found!
+  return proc; //got you!
 
 }
 
@@ -8,6 +8,7 @@
 
 #include<vector>
 #include<cassert>
+#include<climits>
 #include<Vector3D.h>
 #include<mpi.h>
 
@@ -43,6 +44,11 @@ private:
 
   bool two_dimensional_mesh; //!< set to true if z has only one element
 
+  /** Direct lookup of subdomain owners. The DMDA partition is a tensor product, so the owner of (i,j,k)
+      is determined by the "slab" containing i, j, and k in each direction. (Setup in GetSubdomainInfo) **/
+  std::vector<int> subD_i_start, subD_j_start, subD_k_start; //!< sorted first indices of the slabs
+  std::vector<int> subD_owner_map; //!< owner of slab (I,J,K) at I + nI*(J + nJ*K)
+
 public:
 
   std::vector<double> x_glob, y_glob, z_glob;
@@ -103,9 +109,14 @@ public:
                                 Vec3D *xi = NULL, //optional output: local coords of "point" within element
                                 bool include_ghost_layer = false);
 
+  //! Batched version of FindCellCoveringPoint. Returns the number of points found. For points outside
+  //! the domain, ijk is set to (INT_MIN,INT_MIN,INT_MIN). Faster if nearby points are stored together.
+  int FindCellsCoveringPoints(std::vector<Vec3D> &points, std::vector<Int3> &ijk,
+                              bool include_ghost_layer = false);
+
   //! Find the subdomain/processor core that owns a node (or equiv. cell)
   int GetOwnerOfCell(int i, int j, int k, 
-                     bool include_ghost_layer = false); //!< Not optimally fast. Shouldn't call it too frequently.
+                     bool include_ghost_layer = false); //!< O(log(#procs along each axis))
   int GetOwnerOfNode(int i, int j, int k,
                      bool include_ghost_layer = false) {return GetOwnerOfCell(i,j,k,include_ghost_layer);}
 
@@ -128,6 +139,13 @@ public:
   std::vector<int> &Get19NeighborhoodOfSub(int sub);
   std::vector<int> &Get7NeighborhoodOfSub(int sub);
 
+private:
+
+  //! Locate a coordinate among the cells of one axis (binary search, or O(1) if "guess" is right).
+  //! Assumes p is inside the domain. guess = -2 means no guess.
+  int FindCellIndex1D(double p, std::vector<double> &x, std::vector<double> &dx,
+                      bool include_ghost_layer, int guess = -2);
+
 };
 
 
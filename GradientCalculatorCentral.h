@@ -8,6 +8,7 @@
 
 #include <GradientCalculatorBase.h>
 #include <Interpolator.h>
+#include <MeshMetrics.h>
 
 /****************************************************
  * class GradientCalculatorCentral calculates spatial 
@@ -20,8 +21,8 @@
 
 class GradientCalculatorCentral : public GradientCalculatorBase
 {
-  //! coefficients for the 3-cell stencil
-  SpaceVariable3D Cx, Cy, Cz;
+  //! 1D mesh tables, incl. coefficients for the 3-cell stencil
+  MeshMetrics metrics;
 
   //! temporary variable (dim=5) for internal use
   SpaceVariable3D Var;
@@ -48,13 +49,10 @@ public:
                                                 SpaceVariable3D &V, std::vector<int> &input_dof,
                                                 SpaceVariable3D &DV, std::vector<int> &output_dof);
 
-  void Destroy() {
-    Cx.Destroy();  Cy.Destroy();  Cz.Destroy();  Var.Destroy();}
+  void Destroy() {Var.Destroy();}
 
 private:
 
-  void CalculateCoefficients();
-
   //! calculate dV/dx at i +/- 1/2, dV/dy at j +/- 1/2, or dV/dz at k +/- 1/2
   void CentralDifferencingAtCellInterfaces(int dir/*0~d/dx,1~d/dy,2~d/dz*/,
                                            SpaceVariable3D &V, std::vector<int> &input_dof,
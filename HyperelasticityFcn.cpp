@@ -20,7 +20,7 @@ HyperelasticityFcnBase::EvaluateHyperelasticFluxFunction_F(double* flux, double*
   }
 
   double sigma[6];
-  GetCauchyStressTensor(F, sigma, V);
+  GetCauchyStressTensor(F, V, sigma);
 
   if(deviatoric_only) {
     double p = -1.0/3.0*(sigma[0] + sigma[3] + sigma[5]); //hydrostatic pressure
@@ -49,7 +49,7 @@ HyperelasticityFcnBase::EvaluateHyperelasticFluxFunction_G(double* flux, double*
   }
 
   double sigma[6];
-  GetCauchyStressTensor(F, sigma, V);
+  GetCauchyStressTensor(F, V, sigma);
 
   if(deviatoric_only) {
     double p = -1.0/3.0*(sigma[0] + sigma[3] + sigma[5]); //hydrostatic pressure
@@ -78,7 +78,7 @@ HyperelasticityFcnBase::EvaluateHyperelasticFluxFunction_H(double* flux, double*
   }
 
   double sigma[6];
-  GetCauchyStressTensor(F, sigma, V);
+  GetCauchyStressTensor(F, V, sigma);
 
   if(deviatoric_only) {
     double p = -1.0/3.0*(sigma[0] + sigma[3] + sigma[5]); //hydrostatic pressure
@@ -101,6 +101,7 @@ void
 HyperelasticityFcnBase::ConvertPK2ToCauchy(double* P, double *F, double J, double *sigma)
 {
   assert(J!=0.0);
+  double M3x3[9], N3x3[9];
   MathTools::LinearAlgebra::CalculateCTimesMatrixA3x3(1.0/J, F, M3x3); //M = 1/J*F
   MathTools::LinearAlgebra::CalculateMatrixMatrixProduct3x3(M3x3, P, N3x3); //N = M*P 
   MathTools::LinearAlgebra::CalculateABTranspose3x3(N3x3, F, M3x3); //M = N*F'
@@ -137,6 +138,8 @@ void
 HyperelasticityFcnSaintVenantKirchhoff::GetCauchyStressTensor(double *F, [[maybe_unused]] double *V, double *sigma)
 {
 
+  double M3x3[9];
+
   MathTools::LinearAlgebra::CalculateATransposeA3x3(F,M3x3); //M(C) = F'F: right Cauchy-Green def. tensor
   M3x3[0] -= 1.0;
   M3x3[4] -= 1.0;
@@ -183,6 +186,8 @@ HyperelasticityFcnModifiedSaintVenantKirchhoff::GetCauchyStressTensor(double *F,
                                                                       [[maybe_unused]] double *V, double *sigma)
 {
 
+  double M3x3[9], N3x3[9];
+
   MathTools::LinearAlgebra::CalculateATransposeA3x3(F,N3x3); //N(C) = F'F: right Cauchy-Green def. tensor
   for(int i=0; i<9; i++)
     M3x3[i] = N3x3[i];  //M = N
@@ -228,6 +233,8 @@ void
 HyperelasticityFcnNeoHookean::GetCauchyStressTensor(double *F, [[maybe_unused]] double *V, double *sigma)
 {
 
+  double N3x3[9];
+
   MathTools::LinearAlgebra::CalculateAATranspose3x3(F,N3x3); //N(B) = FF': left Cauchy-Green def. tensor
 
   // calculate I1, I2, I3 (principal invariants)
@@ -284,6 +291,8 @@ void
 HyperelasticityFcnMooneyRivlin::GetCauchyStressTensor(double *F, [[maybe_unused]] double *V, double *sigma)
 {
 
+  double M3x3[9], N3x3[9];
+
   MathTools::LinearAlgebra::CalculateAATranspose3x3(F,N3x3); //N(B) = FF': left Cauchy-Green def. tensor
   MathTools::LinearAlgebra::CalculateMatrixMatrixProduct3x3(N3x3,N3x3,M3x3); //M = B*B
 
@@ -41,8 +41,6 @@ protected:
 
   VarFcnBase &vf;
 
-  double M3x3[9], N3x3[9]; //!< for temporary use
-
 public:
 
   enum Type {NONE = 0, SAINTVENANT_KIRCHHOFF = 1, MODIFIED_SAINTVENANT_KIRCHHOFF = 2,
@@ -72,7 +70,7 @@ protected:
 
 //---------------------------------------------------------------------------------
 
-class HyperelasticityFcnSaintVenantKirchhoff : public HyperelasticityFcnBase {
+class HyperelasticityFcnSaintVenantKirchhoff final : public HyperelasticityFcnBase {
 
   double lambda, mu; //first and second Lame constants
 
@@ -87,7 +85,7 @@ public:
 
 //---------------------------------------------------------------------------------
 
-class HyperelasticityFcnModifiedSaintVenantKirchhoff : public HyperelasticityFcnBase {
+class HyperelasticityFcnModifiedSaintVenantKirchhoff final : public HyperelasticityFcnBase {
 
   double kappa, mu; //bulk modulus and the second Lame constant (i.e. shear modulus)
 
@@ -102,7 +100,7 @@ public:
 
 //---------------------------------------------------------------------------------
 
-class HyperelasticityFcnNeoHookean: public HyperelasticityFcnBase {
+class HyperelasticityFcnNeoHookean final : public HyperelasticityFcnBase {
 
   double kappa, mu; //bulk modulus and the second Lame constant (i.e. shear modulus)
 
@@ -117,7 +115,7 @@ public:
 
 //---------------------------------------------------------------------------------
 
-class HyperelasticityFcnMooneyRivlin: public HyperelasticityFcnBase {
+class HyperelasticityFcnMooneyRivlin final : public HyperelasticityFcnBase {
 
   double kappa, C01, C10; //kappa: bulk modulus, C01+C10 = mu/2
 
@@ -13,33 +13,24 @@
 HyperelasticityOperator::HyperelasticityOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, 
                              IoData &iod_, vector<VarFcnBase*> &varFcn_, SpaceVariable3D &coordinates_,
                              SpaceVariable3D &delta_xyz_, GlobalMeshInfo &global_mesh_,
-                             InterpolatorBase &interpolator_, GradientCalculatorBase &grad_,
+                             GradientCalculatorBase &grad_,
                              std::vector<GhostPoint> &ghost_nodes_inner_,
                              std::vector<GhostPoint> &ghost_nodes_outer_)
-                       : comm(comm_), iod(iod_), varFcn(varFcn_), global_mesh(global_mesh_),
-                         interpolator(interpolator_), grad(grad_),
+                       : comm(comm_), iod(iod_), global_mesh(global_mesh_), varFcn(varFcn_),
                          refmap(comm_, dm_all_, iod_, coordinates_, delta_xyz_,
                                 global_mesh_, ghost_nodes_inner_, ghost_nodes_outer_),
+                         grad(grad_),
                          F(comm_, &(dm_all_.ghosted1_9dof)),
                          DetF(comm_, &(dm_all_.ghosted1_1dof)),
                          Var1(comm_, &(dm_all_.ghosted1_3dof)),
                          Var2(comm_, &(dm_all_.ghosted1_3dof)),
-                         Var3(comm_, &(dm_all_.ghosted1_3dof)),
-                         V_i_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         V_j_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         V_k_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidx_i_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidx_j_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidx_k_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidy_i_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidy_j_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidy_k_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidz_i_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidz_j_minus_half(comm_, &(dm_all_.ghosted1_3dof)),
-                         dXidz_k_minus_half(comm_, &(dm_all_.ghosted1_3dof))
+                         Var3(comm_, &(dm_all_.ghosted1_3dof))
 {
   coordinates_.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
   coordinates_.GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+  coordinates_.GetGlobalSize(&NX, &NY, &NZ);
+
+  metrics.Setup(coordinates_, delta_xyz_);
 
 
   // Create a HyperelasticitFcn for each material.
@@ -98,19 +89,6 @@ HyperelasticityOperator::Destroy()
   Var1.Destroy();
   Var2.Destroy();
   Var3.Destroy();
-  
-  V_i_minus_half.Destroy();
-  V_j_minus_half.Destroy();
-  V_k_minus_half.Destroy();
-  dXidx_i_minus_half.Destroy();
-  dXidx_j_minus_half.Destroy();
-  dXidx_k_minus_half.Destroy();
-  dXidy_i_minus_half.Destroy();
-  dXidy_j_minus_half.Destroy();
-  dXidy_k_minus_half.Destroy();
-  dXidz_i_minus_half.Destroy();
-  dXidz_j_minus_half.Destroy();
-  dXidz_k_minus_half.Destroy();
 }
 
 //------------------------------------------------------------
@@ -156,7 +134,7 @@ HyperelasticityOperator::ComputeDeformationGradientAtNodes(SpaceVariable3D &Xi)
   // dxi/dy
   grad.CalculateFirstDerivativeAtNodes(1 /*dy*/, Xi, deriv_dofs, Var2, deriv_dofs);
   // dxi/dz
-  grad.CalculateFirstDerivativeAtNodes(2 /*dy*/, Xi, deriv_dofs, Var2, deriv_dofs);
+  grad.CalculateFirstDerivativeAtNodes(2 /*dz*/, Xi, deriv_dofs, Var3, deriv_dofs);
 
 
   // ------------------------------------
@@ -182,7 +160,7 @@ HyperelasticityOperator::ComputeDeformationGradientAtNodes(SpaceVariable3D &Xi)
           gradxi[6+dim] = dXidz[k][j][i][dim];
 
         invertible = MathTools::LinearAlgebra::
-                     CalculateMatrixInverseAndDeterminant3x3(gradxi, &f[k][j][i], &detf[k][j][i]);
+                     CalculateMatrixInverseAndDeterminant3x3(gradxi, &f[k][j][9*i], &detf[k][j][i]);
         if(!invertible)
           fprintf(stdout,"\033[0;35mWarning: Jacobian of ref. map at (%d,%d,%d) is not invertible."
                          " determinant = %e.\033[0m\n", i,j,k, detf[k][j][i]);
@@ -204,6 +182,38 @@ HyperelasticityOperator::ComputeDeformationGradientAtNodes(SpaceVariable3D &Xi)
 
 //------------------------------------------------------------
 
+void
+HyperelasticityOperator::ComputeGradXiAtCellInterface(Vec3D*** xi, int dir, int i, int j, int k,
+                                                      double &cl, double &cr, double *gradxi)
+{
+  int n  = dir==0 ? i : (dir==1 ? j : k);
+  int im = dir==0 ? i-1 : i, jm = dir==1 ? j-1 : j, km = dir==2 ? k-1 : k;
+
+  // interpolation coefficients. Note that the interface is NOT at the middle if the two cells
+  // have different widths.
+  double h  = metrics.Coord(dir,n) - metrics.Coord(dir,n-1);
+  double xh = metrics.Coord(dir,n) - 0.5*metrics.Width(dir,n);
+  cl = (metrics.Coord(dir,n) - xh)/h;
+  cr = (xh - metrics.Coord(dir,n-1))/h;
+
+  // normal derivative: two-point difference
+  for(int p=0; p<3; p++)
+    gradxi[3*dir+p] = (xi[k][j][i][p] - xi[km][jm][im][p])/h;
+
+  // tangential derivatives: interpolation of nodal derivatives
+  double dl[3], dr[3];
+  for(int d=0; d<3; d++) {
+    if(d==dir)
+      continue;
+    NodalDerivative(xi, d, im, jm, km, dl);
+    NodalDerivative(xi, d, i, j, k, dr);
+    for(int p=0; p<3; p++)
+      gradxi[3*d+p] = cl*dl[p] + cr*dr[p];
+  }
+}
+
+//------------------------------------------------------------
+
 void
 HyperelasticityOperator::AddHyperelasticityFluxes(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &Xi,
                                                   vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS,
@@ -213,140 +223,79 @@ HyperelasticityOperator::AddHyperelasticityFluxes(SpaceVariable3D &V, SpaceVaria
   if(EBDS)
     print_warning("Warning: AddHyperelasticityFluxes: Not able to account for embedded surfaces.\n");
 
-  std::vector<int> i123{1,2,3}, i012{0,1,2};
-
-  //1. Calculate the x, y, and z velocities at cell interfaces by interpolation
-  interpolator.InterpolateAtCellInterfaces(0/*x-dir*/, V, i123, V_i_minus_half, i012);
-  interpolator.InterpolateAtCellInterfaces(1/*y-dir*/, V, i123, V_j_minus_half, i012);
-  interpolator.InterpolateAtCellInterfaces(2/*z-dir*/, V, i123, V_k_minus_half, i012); 
-
-  //2. Calculate Xi derivatives at cell interfaces
-  grad.CalculateFirstDerivativeAtCellInterfaces(0, 0, Xi, i012, dXidx_i_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(0, 1, Xi, i012, dXidx_j_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(0, 2, Xi, i012, dXidx_k_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(1, 0, Xi, i012, dXidy_i_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(1, 1, Xi, i012, dXidy_j_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(1, 2, Xi, i012, dXidy_k_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(2, 0, Xi, i012, dXidz_i_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(2, 1, Xi, i012, dXidz_j_minus_half, i012);
-  grad.CalculateFirstDerivativeAtCellInterfaces(2, 2, Xi, i012, dXidz_k_minus_half, i012);
-
-  //3. Loop through cell interfaces and calculate fluxes
-  Vec3D*** dxidx_i = (Vec3D***)dXidx_i_minus_half.GetDataPointer();
-  Vec3D*** dxidx_j = (Vec3D***)dXidx_j_minus_half.GetDataPointer();
-  Vec3D*** dxidx_k = (Vec3D***)dXidx_k_minus_half.GetDataPointer();
-  Vec3D*** dxidy_i = (Vec3D***)dXidy_i_minus_half.GetDataPointer();
-  Vec3D*** dxidy_j = (Vec3D***)dXidy_j_minus_half.GetDataPointer();
-  Vec3D*** dxidy_k = (Vec3D***)dXidy_k_minus_half.GetDataPointer();
-  Vec3D*** dxidz_i = (Vec3D***)dXidz_i_minus_half.GetDataPointer();
-  Vec3D*** dxidz_j = (Vec3D***)dXidz_j_minus_half.GetDataPointer();
-  Vec3D*** dxidz_k = (Vec3D***)dXidz_k_minus_half.GetDataPointer();
+  // At each cell interface, grad(xi), F = inv(grad(xi)), the Cauchy stress, and the flux are
+  // computed in one pass, and added to R directly. Nothing is stored at cell interfaces.
 
+  Vec3D*** xi   = (Vec3D***)Xi.GetDataPointer();
   Vec5D*** v    = (Vec5D***)V.GetDataPointer();
   Vec5D*** res  = (Vec5D***)R.GetDataPointer();
   double*** id  = (double***)ID.GetDataPointer();
 
-  int myid = 0;
+  // entries of sigma (dim:6) that form the x, y, and z rows of the stress tensor
+  const int row[3][3] = {{0,1,2}, {1,3,4}, {2,4,5}};
+
+  HyperelasticityFcnBase *fcn;
   double gradxi[9], f[9]; //nabla xi and deformation gradient
-  double dx = 0.0, dy = 0.0, dz = 0.0, detf;
+  double sigma[6], vf[3], detf, cl, cr, area, p;
   Vec5D flux;
   bool invertible;
   for(int k=k0; k<kkmax; k++)
     for(int j=j0; j<jjmax; j++)
       for(int i=i0; i<iimax; i++) {
 
-        myid = id[k][j][i];
-        dx   = global_mesh.dx_glob[i];
-        dy   = global_mesh.dy_glob[j];
-        dz   = global_mesh.dz_glob[k];
-
-        //*****************************************
-        //calculate flux function F_{i-1/2,j,k}
-        //*****************************************
-        if(k!=kkmax-1 && j!=jjmax-1) {
+        fcn = hyperFcn[(int)id[k][j][i]]; //TODO: multi-material
+        if(fcn->type == HyperelasticityFcnBase::NONE)
+          continue; //zero flux
 
-          for(int dim=0; dim<3; dim++)
-            gradxi[dim]   = dxidx_i[k][j][i][dim];
-          for(int dim=0; dim<3; dim++)
-            gradxi[3+dim] = dxidy_i[k][j][i][dim];
-          for(int dim=0; dim<3; dim++)
-            gradxi[6+dim] = dxidz_i[k][j][i][dim];
+        //*****************************************************
+        //calculate flux functions F_{i-1/2,j,k}, G_{i,j-1/2,k},
+        //and H_{i,j,k-1/2}
+        //*****************************************************
+        for(int dir=0; dir<3; dir++) {
 
-          invertible = MathTools::LinearAlgebra::
-                       CalculateMatrixInverseAndDeterminant3x3(gradxi, f, &detf);
-          if(!invertible)
-            fprintf(stdout,"\033[0;35mWarning: Jacobian of ref. map at (%d-1/2,%d,%d) is not invertible."
-                           " determinant = %e.\033[0m\n", i,j,k, detf);
-
-          hyperFcn[myid]->EvaluateHyperelasticFluxFunction_F(flux, f, v[k][j][i], true);//TODO: multi-material
-          flux *= dy*dz;
-          res[k][j][i]   += flux;
-          res[k][j][i-1] -= flux;
-        }
+          if((dir!=0 && i==iimax-1) || (dir!=1 && j==jjmax-1) || (dir!=2 && k==kkmax-1))
+            continue;
 
+          int im = dir==0 ? i-1 : i, jm = dir==1 ? j-1 : j, km = dir==2 ? k-1 : k;
 
-        //*****************************************
-        //calculate flux function G_{i,j-1/2,k}
-        //*****************************************
-        if(i!=iimax-1 && k!=kkmax-1) {
-
-          for(int dim=0; dim<3; dim++)
-            gradxi[dim]   = dxidx_j[k][j][i][dim];
-          for(int dim=0; dim<3; dim++)
-            gradxi[3+dim] = dxidy_j[k][j][i][dim];
-          for(int dim=0; dim<3; dim++)
-            gradxi[6+dim] = dxidz_j[k][j][i][dim];
-
-          invertible = MathTools::LinearAlgebra::
-                       CalculateMatrixInverseAndDeterminant3x3(gradxi, f, &detf);
-          if(!invertible)
-            fprintf(stdout,"\033[0;35mWarning: Jacobian of ref. map at (%d,%d-1/2,%d) is not invertible."
-                           " determinant = %e.\033[0m\n", i,j,k, detf);
-
-          hyperFcn[myid]->EvaluateHyperelasticFluxFunction_G(flux, f, v[k][j][i], true);//TODO: multi-material
-          flux *= dx*dz;
-          res[k][j][i]   += flux;
-          res[k][j-1][i] -= flux;
-        }
-
-        //*****************************************
-        //calculate flux function H_{i,j,k-1/2}
-        //*****************************************
-        if(i!=iimax-1 && j!=jjmax-1) {
-
-          for(int dim=0; dim<3; dim++)
-            gradxi[dim]   = dxidx_k[k][j][i][dim];
-          for(int dim=0; dim<3; dim++)
-            gradxi[3+dim] = dxidy_k[k][j][i][dim];
-          for(int dim=0; dim<3; dim++)
-            gradxi[6+dim] = dxidz_k[k][j][i][dim];
+          ComputeGradXiAtCellInterface(xi, dir, i, j, k, cl, cr, gradxi);
 
           invertible = MathTools::LinearAlgebra::
                        CalculateMatrixInverseAndDeterminant3x3(gradxi, f, &detf);
           if(!invertible)
-            fprintf(stdout,"\033[0;35mWarning: Jacobian of ref. map at (%d,%d,%d-1/2) is not invertible."
-                           " determinant = %e.\033[0m\n", i,j,k, detf);
-
-          hyperFcn[myid]->EvaluateHyperelasticFluxFunction_H(flux, f, v[k][j][i], true);//TODO: multi-material!
-          flux *= dx*dy;
-          res[k][j][i]   += flux;
-          res[k-1][j][i] -= flux;
+            fprintf(stdout,"\033[0;35mWarning: Jacobian of ref. map at the %c-1/2 interface of (%d,%d,%d) is not "
+                           "invertible. determinant = %e.\033[0m\n", "ijk"[dir], i,j,k, detf);
+
+          GetCauchyStressTensor(fcn, f, v[k][j][i], sigma);
+
+          // deviatoric stress
+          p = -1.0/3.0*(sigma[0] + sigma[3] + sigma[5]); //hydrostatic pressure
+          sigma[0] += p;
+          sigma[3] += p;
+          sigma[5] += p;
+
+          // velocity at the cell interface
+          for(int q=0; q<3; q++)
+            vf[q] = cl*v[km][jm][im][1+q] + cr*v[k][j][i][1+q];
+
+          flux[0] = 0.0;
+          flux[4] = 0.0;
+          for(int q=0; q<3; q++) {
+            flux[1+q] = sigma[row[dir][q]];
+            flux[4]  += vf[q]*sigma[row[dir][q]];
+          }
+
+          area = dir==0 ? global_mesh.dy_glob[j]*global_mesh.dz_glob[k]
+               : (dir==1 ? global_mesh.dx_glob[i]*global_mesh.dz_glob[k]
+                         : global_mesh.dx_glob[i]*global_mesh.dy_glob[j]);
+          flux *= area;
+          res[k][j][i]    += flux;
+          res[km][jm][im] -= flux;
         }
 
       }
 
-  V_i_minus_half.RestoreDataPointerToLocalVector();
-  V_j_minus_half.RestoreDataPointerToLocalVector();
-  V_k_minus_half.RestoreDataPointerToLocalVector();
-  dXidx_i_minus_half.RestoreDataPointerToLocalVector();
-  dXidx_j_minus_half.RestoreDataPointerToLocalVector();
-  dXidx_k_minus_half.RestoreDataPointerToLocalVector();
-  dXidy_i_minus_half.RestoreDataPointerToLocalVector();
-  dXidy_j_minus_half.RestoreDataPointerToLocalVector();
-  dXidy_k_minus_half.RestoreDataPointerToLocalVector();
-  dXidz_i_minus_half.RestoreDataPointerToLocalVector();
-  dXidz_j_minus_half.RestoreDataPointerToLocalVector();
-  dXidz_k_minus_half.RestoreDataPointerToLocalVector();
+  Xi.RestoreDataPointerToLocalVector();
   ID.RestoreDataPointerToLocalVector();
   V.RestoreDataPointerToLocalVector();
 
@@ -356,7 +305,3 @@ HyperelasticityOperator::AddHyperelasticityFluxes(SpaceVariable3D &V, SpaceVaria
 }
 
 //------------------------------------------------------------
-
-
-//------------------------------------------------------------
-
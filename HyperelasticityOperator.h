@@ -7,7 +7,10 @@
 #define _VISCOELASTICITY_OPERATOR_H_
 #include<ReferenceMapOperator.h>
 #include<HyperelasticityFcn.h>
-#include<Interpolator.h>
+#include<GradientCalculatorBase.h>
+#include<MeshMetrics.h>
+#include<Vector3D.h>
+#include<Utils.h>
 
 class EmbeddedBoundaryDataSet;
 
@@ -40,9 +43,6 @@ class HyperelasticityOperator
   //! Gradient calculator
   GradientCalculatorBase &grad;
 
-  //! Interpolator
-  InterpolatorBase &interpolator;
-
   //! Deformation gradient (dim = 9, i.e. 3x3 matrix)
   SpaceVariable3D F;
 
@@ -52,29 +52,17 @@ class HyperelasticityOperator
   //! Internal variables (for temporary use), dim = 3
   SpaceVariable3D Var1, Var2, Var3;
 
+  //! 1D mesh tables (for the stencil coefficients of grad(xi) at cell interfaces)
+  MeshMetrics metrics;
 
-  //! internal variables -- storing data at cell interfaces
-  SpaceVariable3D V_i_minus_half;//!< velocity (dim = 3)
-  SpaceVariable3D V_j_minus_half;//!< velocity (dim = 3)
-  SpaceVariable3D V_k_minus_half;//!< velocity (dim = 3)
-  SpaceVariable3D dXidx_i_minus_half;  //!< dxi_x/dx, dxi_y/dx, dxi_z/dx at i +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidx_j_minus_half;  //!< dxi_x/dx, dxi_y/dx, dxi_z/dx at j +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidx_k_minus_half;  //!< dxi_x/dx, dxi_y/dx, dxi_z/dx at k +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidy_i_minus_half;  //!< dxi_x/dy, dxi_y/dy, dxi_z/dy at i +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidy_j_minus_half;  //!< dxi_x/dy, dxi_y/dy, dxi_z/dy at j +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidy_k_minus_half;  //!< dxi_x/dy, dxi_y/dy, dxi_z/dy at k +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidz_i_minus_half;  //!< dxi_x/dz, dxi_y/dz, dxi_z/dz at i +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidz_j_minus_half;  //!< dxi_x/dz, dxi_y/dz, dxi_z/dz at j +/- 1/2 (dim = 3)
-  SpaceVariable3D dXidz_k_minus_half;  //!< dxi_x/dz, dxi_y/dz, dxi_z/dz at k +/- 1/2 (dim = 3)
-
+  int NX, NY, NZ; //!< global mesh size
 
 public:
 
   HyperelasticityOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_,
                           vector<VarFcnBase*> &varFcn_,
                           SpaceVariable3D &coordinates_, SpaceVariable3D &delta_xyz_,
-                          GlobalMeshInfo &global_mesh_,
-                          InterpolatorBase &interpolator_, GradientCalculatorBase &grad_,
+                          GlobalMeshInfo &global_mesh_, GradientCalculatorBase &grad_,
                           std::vector<GhostPoint> &ghost_nodes_inner_,
                           std::vector<GhostPoint> &ghost_nodes_outer_);
   ~HyperelasticityOperator();
@@ -89,9 +77,68 @@ public:
 
   void ComputeDeformationGradientAtNodes(SpaceVariable3D &Xi); //!< Only within the physical domain
 
+  //! grad(xi), F = inv(grad(xi)), and the stress are computed face by face (not stored)
   void AddHyperelasticityFluxes(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &Xi,
                                 vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS,
                                 SpaceVariable3D &R);
+
+private:
+
+  //! d(xi)/dx_d at node (i,j,k), with d in the interior range. Same stencil as
+  //! GradientCalculatorCentral::CalculateFirstDerivativeAtNodes
+  inline void NodalDerivative(Vec3D*** xi, int d, int i, int j, int k, double *dxi) {
+    int n = d==0 ? i : (d==1 ? j : k);
+    int si = d==0, sj = d==1, sk = d==2;
+    Vec3D &xm(xi[k-sk][j-sj][i-si]), &x0(xi[k][j][i]), &xp(xi[k+sk][j+sj][i+si]);
+    bool outside = (d!=0 && (i<0 || i>=NX)) || (d!=1 && (j<0 || j>=NY)) || (d!=2 && (k<0 || k>=NZ));
+    if(outside && n==0) { //v[k][-1][-1] (for example) is not populated. Switch to one-sided difference
+      double coeff = 1.0/(metrics.Coord(d,n+1) - metrics.Coord(d,n));
+      for(int p=0; p<3; p++)
+        dxi[p] = coeff*(xp[p] - x0[p]);
+    }
+    else if(outside && n==(d==0 ? NX : (d==1 ? NY : NZ))-1) {
+      double coeff = 1.0/(metrics.Coord(d,n) - metrics.Coord(d,n-1));
+      for(int p=0; p<3; p++)
+        dxi[p] = coeff*(x0[p] - xm[p]);
+    }
+    else {
+      const double *c = metrics.CentralDifferenceCoefficients(d,n);
+      for(int p=0; p<3; p++)
+        dxi[p] = c[0]*xm[p] + c[1]*x0[p] + c[2]*xp[p];
+    }
+  }
+
+  //! grad(xi) (column-major) at the interface between (i,j,k) and its neighbor on the "left" along dir.
+  //! cl and cr are the linear interpolation coefficients of the two nodes (as in InterpolatorLinear)
+  void ComputeGradXiAtCellInterface(Vec3D*** xi, int dir, int i, int j, int k, double &cl, double &cr,
+                                    double *gradxi);
+
+  //! Cauchy stress of material "fcn", without virtual dispatch. Materials without a hyperelasticity
+  //! model (type NONE) must be skipped by the caller
+  inline void GetCauchyStressTensor(HyperelasticityFcnBase *fcn, double *f, double *v, double *sigma) {
+    switch (fcn->type) {
+      case HyperelasticityFcnBase::SAINTVENANT_KIRCHHOFF :
+        static_cast<HyperelasticityFcnSaintVenantKirchhoff*>(fcn)->
+          HyperelasticityFcnSaintVenantKirchhoff::GetCauchyStressTensor(f, v, sigma);
+        break;
+      case HyperelasticityFcnBase::MODIFIED_SAINTVENANT_KIRCHHOFF :
+        static_cast<HyperelasticityFcnModifiedSaintVenantKirchhoff*>(fcn)->
+          HyperelasticityFcnModifiedSaintVenantKirchhoff::GetCauchyStressTensor(f, v, sigma);
+        break;
+      case HyperelasticityFcnBase::NEO_HOOKEAN :
+        static_cast<HyperelasticityFcnNeoHookean*>(fcn)->
+          HyperelasticityFcnNeoHookean::GetCauchyStressTensor(f, v, sigma);
+        break;
+      case HyperelasticityFcnBase::MOONEY_RIVLIN :
+        static_cast<HyperelasticityFcnMooneyRivlin*>(fcn)->
+          HyperelasticityFcnMooneyRivlin::GetCauchyStressTensor(f, v, sigma);
+        break;
+      default :
+        print_error("*** Error: Unknown hyperelasticity model (type = %d).\n", (int)fcn->type);
+        exit_mpi();
+    }
+  }
+
 };
 
 #endif
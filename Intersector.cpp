@@ -59,12 +59,15 @@ Intersector::Intersector(MPI_Comm &comm_, DataManagers3D &dms_, EmbeddedSurfaceD
   coordinates.GetInternalGhostedCornerIndices(&ii0_in, &jj0_in, &kk0_in, &iimax_in, &jjmax_in, &kkmax_in);
   coordinates.GetGlobalSize(&NX, &NY, &NZ);
 
+  for(NodeSet* ns : {&occluded, &firstLayer, &imposed_occluded, &swept, &previously_occluded_but_not_now, &nodes2fill})
+    ns->Setup(ii0, jj0, kk0, iimax, jjmax, kkmax);
+
   // Set the capacity of internal vectors, so we don't frequently reallocate memory
   int capacity = (imax-i0)*(jmax-j0)*(kmax-k0)/4; //should be big enough
   intersections.reserve(capacity);
-  candidates_1.reserve(capacity*2);
+  candidates_1.reserve(capacity*2, capacity*8);
   scope_1.reserve(surface.elems.size());
-  candidates_n.reserve(capacity*2);
+  candidates_n.reserve(capacity*2, capacity*8);
   scope_n.reserve(surface.elems.size());
 
   //sanity checks on the triangulated surface
@@ -315,7 +318,7 @@ Intersector::BuildSubdomainScopeAndKDTree(const Vec3D &subD_bbmin, const Vec3D &
 void
 Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax, KDTree<MyTriangle, 3> *tree,
                                  SpaceVariable3D &CandidatesIndex, 
-                                 vector<pair<Int3, vector<MyTriangle> > > &candidates)
+                                 NodalCandidates &candidates)
 {
 
   candidates.clear();
@@ -340,12 +343,11 @@ Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax,
         if(nFound==0) {
           candid[k][j][i] = -1;
         } else {
-          candidates.push_back(std::make_pair(Int3(i,j,k), vector<MyTriangle>())); 
-          vector<MyTriangle>& tri(candidates.back().second);
-          tri.reserve(nFound);
-          for(int i=0; i<nFound; i++)
-            tri.push_back(tmp[i]); 
-          candid[k][j][i] = candidates.size() - 1; //index of this node in candidates
+          // append a row (only triangle ids are stored)
+          for(int n=0; n<nFound; n++)
+            candidates.tid.push_back(tmp[n].trId()); 
+          candidates.offset.push_back(candidates.tid.size());
+          candid[k][j][i] = candidates.size() - 1; //row of this node in candidates
         }
 
       }
@@ -787,6 +789,8 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
         } else if(layer[k][j][i]==1) 
           firstLayer.insert(Int3(i,j,k));
       }
+  occluded.Sort(); //same order as std::set<Int3> (nodes were inserted in k-j-i order)
+  firstLayer.Sort();
 
   TMP2.RestoreDataPointerToLocalVector();
 
@@ -847,7 +851,7 @@ Intersector::FloodFillColors()
   // ----------------------------------------------------------------
   // Call floodfiller to do the work.
   // ----------------------------------------------------------------
-  int nColors = floodfiller.FillBasedOnEdgeObstructions(XForward, -1/*xf==-1 means no intersection*/, occluded, Color);
+  int nColors = floodfiller.FillBasedOnEdgeObstructions(XForward, -1/*xf==-1 means no intersection*/, occluded.GetNodes(), Color);
 
   // ----------------------------------------------------------------
   // Now we need to convert the color map to what we want: 0~occluded, 1, 2,...: regions connected to Dirichlet
@@ -993,8 +997,8 @@ Intersector::RefillAfterSurfaceUpdate()
   double*** candid = CandidatesIndex_1.GetDataPointer();
   
   //add swept nodes to nodes2fill (including internal ghosts)
-  std::set<Int3> nodes2fill = swept;
-  std::set<Int3> nodes2fill2;
+  nodes2fill.clear();
+  nodes2fill.Union(swept);
 
   // go over swept nodes, correct their colors
   int i0,j0,k0;
@@ -1024,9 +1028,10 @@ Intersector::RefillAfterSurfaceUpdate()
     if(!color) //first iteration
       color = Color.GetDataPointer();
 
-    nodes2fill2 = nodes2fill;
-
-    for(auto it = nodes2fill.begin(); it != nodes2fill.end(); it++) {
+    // Nodes are erased from nodes2fill while looping over its vector. The membership queries below see the
+    // latest (updated) set. The vector is compacted after the loop.
+    const vector<Int3> &nodes2fill_vec(nodes2fill.GetNodes());
+    for(auto it = nodes2fill_vec.begin(); it != nodes2fill_vec.end(); it++) {
       i0 = (*it)[0];
       j0 = (*it)[1];
       k0 = (*it)[2]; 
@@ -1035,7 +1040,7 @@ Intersector::RefillAfterSurfaceUpdate()
         continue; //this is an internal ghost. we let its owner fix it.
 
       if(color[k0][j0][i0] == 0) { //occluded
-        nodes2fill2.erase(nodes2fill2.find(*it)); 
+        nodes2fill.erase(*it); 
         continue;
       }
 
@@ -1043,8 +1048,10 @@ Intersector::RefillAfterSurfaceUpdate()
 
       // if this node is swept, candidates must exist. Otherwise, the surface moved too much!
       assert(candid[k0][j0][i0]>=0);
-      vector<MyTriangle> &cands(candidates_1[candid[k0][j0][i0]].second);
-      assert(cands.size()>0);
+      int row = candid[k0][j0][i0];
+      const int* cands = candidates_1.Row(row);
+      int nCands = candidates_1.Count(row);
+      assert(nCands>0);
 
       //go over first layer neighbors, find a nonblocked reliable neighbor
       for(int k=k0-1; k<=k0+1; k++)
@@ -1054,15 +1061,15 @@ Intersector::RefillAfterSurfaceUpdate()
             if(coordinates.OutsidePhysicalDomain(i,j,k) || (i==i0 && j==j0 && k==k0))
               continue; //this neighbor is out of physical domain, or just the same node
 
-            if(nodes2fill2.find(Int3(i,j,k)) != nodes2fill2.end()) //uses "nodes2fill2", the latest updated list
+            if(nodes2fill.Contains(i,j,k)) //the latest updated set
               continue; //this neighbor is in trouble as well...
 
             if(color[k][j][i] == 0) //this neighbor is occluded (naturally or "forced"). Either way, it cannot be used.
               continue;
 
             bool blocked = false;
-            for(auto it2 = cands.begin(); it2 != cands.end(); it2++) {
-              int id = it2->trId();
+            for(int c=0; c<nCands; c++) {
+              int id = cands[c];
               Int3 &nodes(Es[id]);
               blocked = GeoTools::LineSegmentIntersectsTriangle(Vec3D(x_glob[i],y_glob[j],z_glob[k]),
                                                                 Vec3D(x_glob[i0],y_glob[j0],z_glob[k0]), 
@@ -1077,14 +1084,14 @@ Intersector::RefillAfterSurfaceUpdate()
 
             // If the above checks are all passed, this neighbor is in the same region as me.
             color[k0][j0][i0] = color[k][j][i];
-            nodes2fill2.erase(nodes2fill2.find(*it)); //erase from nodes2fill2, NOT from nodes2fill (would mess up pointer!)
+            nodes2fill.erase(*it); //only clears the flag (the vector is not changed)
             goto DONE_WITH_THIS_NODE; 
          }
 
       DONE_WITH_THIS_NODE:
       continue; //need this to make "GOTO" work
     }
-    nodes2fill = nodes2fill2;
+    nodes2fill.Compact();
 
     Color.RestoreDataPointerAndInsert();
 
@@ -1092,17 +1099,16 @@ Intersector::RefillAfterSurfaceUpdate()
     color = Color.GetDataPointer();
 
     // remove filled internal ghosts (filled by their owners) from "nodes2fill"
-    for(auto it = nodes2fill.begin(); it != nodes2fill.end(); it++) {
+    for(auto it = nodes2fill_vec.begin(); it != nodes2fill_vec.end(); it++) {
       i0 = (*it)[0];
       j0 = (*it)[1];
       k0 = (*it)[2]; 
       if(!coordinates.IsHere(i0,j0,k0,false)) { //this is an internal ghost
         if(color[k0][j0][i0] != BAD_SIGN) //must have been fixed by its owner
-          nodes2fill2.erase(nodes2fill2.find(*it)); 
+          nodes2fill.erase(*it); 
       }
     }
-    if(nodes2fill.size() != nodes2fill2.size()) //some node(s) got erased
-      nodes2fill = nodes2fill2;
+    nodes2fill.Compact();
 
   }
 
@@ -1111,7 +1117,7 @@ Intersector::RefillAfterSurfaceUpdate()
   if(total_remaining_nodes>0) {
     print_warning("Warning: Found %d unresolved nodes after performing %d iterations of refill. Setting them to be occluded.\n",
                    total_remaining_nodes, max_it);
-    imposed_occluded = nodes2fill;
+    imposed_occluded.Union(nodes2fill);
     for(auto it = imposed_occluded.begin(); it != imposed_occluded.end(); it++) 
       color[(*it)[2]][(*it)[1]][(*it)[0]] = 0; //set it to occluded. BUT NO NEW INTERSECTIONS!
       //color must be valid (i.e. not NULL) if total_remaining_nodes>0
@@ -1162,7 +1168,7 @@ Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
 
   int i,j,k;
   for(auto it = firstLayer.begin(); it != firstLayer.end(); it++) {
-    if(occluded.find(*it) != occluded.end())
+    if(occluded.Contains(*it))
       continue; //we don't store nodes that are currently occluded
 
     i = (*it)[0];
@@ -1170,11 +1176,13 @@ Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
     k = (*it)[2];
 
     assert(candid[k][j][i]>=0);
-    vector<MyTriangle> &cands(candidates_1[candid[k][j][i]].second);
-    assert(cands.size()>0);
+    int row = candid[k][j][i];
+    const int* cands = candidates_1.Row(row);
+    int nCands = candidates_1.Count(row);
+    assert(nCands>0);
 
-    for(auto it2 = cands.begin(); it2 != cands.end(); it2++) {
-      int id = it2->trId();
+    for(int c=0; c<nCands; c++) {
+      int id = cands[c];
       Int3 &nodes(Es[id]);
       Vec3D coords(x_glob[(*it)[0]], y_glob[(*it)[1]], z_glob[(*it)[2]]); //inside physical domain (safe)
       if(GeoTools::IsPointSweptByTriangle(coords, X0[nodes[0]], X0[nodes[1]], X0[nodes[2]],
@@ -1189,7 +1197,7 @@ Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
       
   // Verification
   for(auto&& ijk : previously_occluded_but_not_now) {
-    if(swept.find(ijk) == swept.end()) {
+    if(!swept.Contains(ijk)) {
       fprintf(stdout,"\033[0;31m*** Error: Conflict between 'swept' and 'occluded': %d %d %d. A software bug.\033[0m\n",
               ijk[0], ijk[1], ijk[2]);
       exit(-1);
@@ -1238,7 +1246,7 @@ Intersector::CalculateUnsignedDistanceNearSurface(int nL)
   vector<Int3>&   Es(surface.elems);
   vector<Vec3D>&  Ns(surface.elemNorm);
   vector<double>& As(surface.elemArea); 
-  std::set<Int3> this_layer = firstLayer;
+  std::set<Int3> this_layer(firstLayer.begin(), firstLayer.end());
 
   for(int layer=1; layer<=nLayer; layer++) {
 
@@ -1254,15 +1262,17 @@ Intersector::CalculateUnsignedDistanceNearSurface(int nL)
       k = (*it)[2];
 
       assert(candid[k][j][i]>=0);
-      vector<MyTriangle> &cands(candidates_n[candid[k][j][i]].second);
-      assert(cands.size()>0);
+      int row = candid[k][j][i];
+      const int* cands = candidates_n.Row(row);
+      int nCands = candidates_n.Count(row);
+      assert(nCands>0);
 
       double dist = DBL_MAX, new_dist;
       ClosestPoint cp(-1,DBL_MAX,xi); //initialize to garbage
 
       int id;
-      for(int tri=0; tri<(int)cands.size(); tri++) {
-        id = cands[tri].trId();
+      for(int tri=0; tri<nCands; tri++) {
+        id = cands[tri];
         Int3 &nodes(Es[id]);
         Vec3D coords(x_glob[i], y_glob[j], z_glob[k]); //inside physical domain (safe)
         
@@ -57,6 +57,20 @@ class Intersector {
   };
 
 
+  //! Compressed (CSR) storage of the candidate triangles of near-surface nodes. Row n (stored in CandidatesIndex)
+  //! contains the triangle ids tid[offset[n]], ..., tid[offset[n+1]-1]. The capacity is reused across time steps.
+  struct NodalCandidates {
+    std::vector<int> offset; //!< size: number of rows + 1
+    std::vector<int> tid;
+    NodalCandidates() : offset(1,0) {}
+    void clear() {offset.resize(1); tid.clear();} //keeps capacity
+    void reserve(int rows, int entries) {offset.reserve(rows+1); tid.reserve(entries);}
+    int size() const {return (int)offset.size() - 1;} //!< number of rows (nodes)
+    int Count(int n) const {return offset[n+1] - offset[n];}
+    const int* Row(int n) const {return tid.data() + offset[n];}
+  };
+
+
   MPI_Comm& comm;
 
   EmbeddedSurfaceData &iod_surface;
@@ -108,11 +122,11 @@ class Intersector {
    * Results
    ************************/
   //! "CandidatesIndex" and "candidates" account for internal ghost nodes, but not ghost nodes outside physical domain.
-  SpaceVariable3D CandidatesIndex_1; //!< index in the vector "candidates" (-1 means no candidates)
-  std::vector<std::pair<Int3, std::vector<MyTriangle> > > candidates_1;
+  SpaceVariable3D CandidatesIndex_1; //!< row in "candidates" (-1 means no candidates)
+  NodalCandidates candidates_1;
 
   SpaceVariable3D CandidatesIndex_n;
-  std::vector<std::pair<Int3, std::vector<MyTriangle> > > candidates_n;
+  NodalCandidates candidates_n;
 
 
 
@@ -144,20 +158,21 @@ class Intersector {
                                                      and XBackward. When there are occluded nodes, "intersections" \n
                                                      may contain points that are actually not used/registered! */ 
 
-  //! "occluded" and "firstLayer" account for the internal ghost nodes.
-  std::set<Int3> occluded;
-  std::set<Int3> firstLayer; //!< nodes that belong to intersecting edges (naturally, including occluded nodes)
-  std::set<Int3> imposed_occluded; /**< tracks nodes whose color cannot be resolved; these nodes are FORCED to have\n
+  //! "occluded" and "firstLayer" account for the internal ghost nodes. (NodeSet: O(1) membership queries)
+  NodeSet occluded;
+  NodeSet firstLayer; //!< nodes that belong to intersecting edges (naturally, including occluded nodes)
+  NodeSet imposed_occluded; /**< tracks nodes whose color cannot be resolved; these nodes are FORCED to have\n
                                         the color of occluded(0), but intersections from these nodes to neighbors\n
                                         may not exist! Includes internal ghost nodes.*/
                                         
 
   //! tracks nodes that are swept by the surface during small motion (e.g., in one time step)
   //! Does not include nodes that are occluded at present. Includes internal ghost nodes.
-  std::set<Int3> swept;
+  NodeSet swept;
 
-  //! an internally used vector
-  std::set<Int3> previously_occluded_but_not_now;
+  //! internally used sets
+  NodeSet previously_occluded_but_not_now;
+  NodeSet nodes2fill; //!< used in RefillAfterSurfaceUpdate
 
 public:
 
@@ -198,7 +213,7 @@ public:
   //! find nearby triangles for each node based on bounding boxes and KDTree
   void FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax, KDTree<MyTriangle, 3> *tree,
                            SpaceVariable3D &CandidatesIndex,
-                           std::vector<std::pair<Int3, std::vector<MyTriangle> > > &candidates); 
+                           NodalCandidates &candidates); 
 
   void FindIntersections(); //!< find occluded nodes, intersections, and first layer nodes
 
@@ -1156,6 +1156,9 @@ SchemeData::SchemeData()
   flux = HLLC;
 
   delta = 0.2; //the coefficient in Harten's entropy fix (for Roe flux)
+
+  active_tile_size = 0;
+  active_tile_report_frequency = 100;
 }
 
 //------------------------------------------------------------------------------
@@ -1164,7 +1167,7 @@ void SchemeData::setup(const char *name, ClassAssigner *father)
 {
 
   ClassAssigner* ca;
-  ca = new ClassAssigner(name, 4, father);
+  ca = new ClassAssigner(name, 6, father);
 
   new ClassToken<SchemeData>
     (ca, "Flux", this,
@@ -1177,6 +1180,9 @@ void SchemeData::setup(const char *name, ClassAssigner *father)
 
   smooth.setup("Smoothing", ca);
 
+  new ClassInt<SchemeData>(ca, "ActiveTileSize", this, &SchemeData::active_tile_size);
+  new ClassInt<SchemeData>(ca, "ActiveTileReportFrequency", this, &SchemeData::active_tile_report_frequency);
+
 }
 
 //------------------------------------------------------------------------------
@@ -1472,6 +1478,12 @@ void MultiPhaseData::setup(const char *name, ClassAssigner *father)
 ExplicitData::ExplicitData()
 {
   type = RUNGE_KUTTA_2;
+  low_storage = OFF;
+  packed_level_sets = OFF;
+
+  transport_update_interval = 1;
+  transport_cfl = 0.5;
+  transport_max_displacement = 1.0;
 }
 
 //------------------------------------------------------------------------------
@@ -1479,13 +1491,49 @@ ExplicitData::ExplicitData()
 void ExplicitData::setup(const char *name, ClassAssigner *father)
 {
 
- ClassAssigner *ca = new ClassAssigner(name, 1, father);
+ ClassAssigner *ca = new ClassAssigner(name, 6, father);
 
   new ClassToken<ExplicitData>
     (ca, "Type", this,
      reinterpret_cast<int ExplicitData::*>(&ExplicitData::type), 3,
      "ForwardEuler", 0, "RungeKutta2", 1, "RungeKutta3", 2);
 
+  new ClassToken<ExplicitData>
+    (ca, "LowStorage", this,
+     reinterpret_cast<int ExplicitData::*>(&ExplicitData::low_storage), 2,
+     "Off", 0, "On", 1);
+
+  new ClassToken<ExplicitData>
+    (ca, "PackedLevelSets", this,
+     reinterpret_cast<int ExplicitData::*>(&ExplicitData::packed_level_sets), 2,
+     "Off", 0, "On", 1);
+
+  new ClassInt<ExplicitData>(ca, "TransportUpdateInterval", this, &ExplicitData::transport_update_interval);
+  new ClassDouble<ExplicitData>(ca, "TransportCFL", this, &ExplicitData::transport_cfl);
+  new ClassDouble<ExplicitData>(ca, "TransportMaxDisplacement", this, &ExplicitData::transport_max_displacement);
+
+}
+
+//------------------------------------------------------------------------------
+
+MultigridData::MultigridData()
+{
+  num_levels = 1;
+  pre_smoothing = 1;
+  post_smoothing = 1;
+  coarsest_smoothing = 2;
+}
+
+//------------------------------------------------------------------------------
+
+void MultigridData::setup(const char *name, ClassAssigner *father)
+{
+  ClassAssigner *ca = new ClassAssigner(name, 4, father);
+
+  new ClassInt<MultigridData>(ca, "NumberOfLevels", this, &MultigridData::num_levels);
+  new ClassInt<MultigridData>(ca, "PreSmoothingIterations", this, &MultigridData::pre_smoothing);
+  new ClassInt<MultigridData>(ca, "PostSmoothingIterations", this, &MultigridData::post_smoothing);
+  new ClassInt<MultigridData>(ca, "CoarsestLevelIterations", this, &MultigridData::coarsest_smoothing);
 }
 
 //------------------------------------------------------------------------------
@@ -1501,6 +1549,12 @@ TsData::TsData()
 
   convergence_tolerance = -1.0; //!< activated only for steady-state computations
   local_dt = NO;
+  lts_max_level = 4;
+  residual_history_file = "";
+
+  wallclock_limit = -1.0;
+  wallclock_reserve = -1.0;
+  perf_report_frequency = 100;
 
 }
 
@@ -1509,7 +1563,7 @@ TsData::TsData()
 void TsData::setup(const char *name, ClassAssigner *father)
 {
 
-  ClassAssigner *ca = new ClassAssigner(name, 8, father);
+  ClassAssigner *ca = new ClassAssigner(name, 14, father);
 
   new ClassToken<TsData>(ca, "Type", this,
                          reinterpret_cast<int TsData::*>(&TsData::type), 2,
@@ -1523,7 +1577,13 @@ void TsData::setup(const char *name, ClassAssigner *father)
   new ClassToken<TsData>(ca, "LocalTimeStepping", this,
                          reinterpret_cast<int TsData::*>(&TsData::local_dt), 2,
                          "Off", 0, "On", 1);
+  new ClassInt<TsData>(ca, "LocalTimeSteppingMaxLevel", this, &TsData::lts_max_level);
+  mg.setup("Multigrid", ca);
+  new ClassStr<TsData>(ca, "ResidualHistoryFile", this, &TsData::residual_history_file);
 
+  new ClassDouble<TsData>(ca, "WallClockTimeLimit", this, &TsData::wallclock_limit);
+  new ClassDouble<TsData>(ca, "WallClockTimeReserve", this, &TsData::wallclock_reserve);
+  new ClassInt<TsData>(ca, "PerformanceReportFrequency", this, &TsData::perf_report_frequency);
 
   expl.setup("Explicit", ca);
 }
@@ -2292,6 +2352,9 @@ LaserData::LaserData() {
   max_iter = 400;
   relax_coeff = 1.0;
 
+  stage_coupling = EVERY_STAGE;
+  stage_coupling_tol = 0.01;
+
 }
 
 //------------------------------------------------------------------------------
@@ -2299,7 +2362,7 @@ LaserData::LaserData() {
 
 void LaserData::setup(const char *name, ClassAssigner *father) {
 
-  ClassAssigner *ca = new ClassAssigner(name, 23, father); 
+  ClassAssigner *ca = new ClassAssigner(name, 25, father); 
 
   //Physical Parameters
   new ClassDouble<LaserData>(ca, "SourceIntensity", this, &LaserData::source_intensity);
@@ -2333,6 +2396,12 @@ void LaserData::setup(const char *name, ClassAssigner *father) {
   new ClassDouble<LaserData>(ca, "MaxIts", this, &LaserData::max_iter);
   new ClassDouble<LaserData>(ca, "RelaxationCoefficient", this, &LaserData::relax_coeff);
 
+  //Coupling with multi-stage time integrators
+  new ClassToken<LaserData> (ca, "StageCoupling", this,
+        reinterpret_cast<int LaserData::*>(&LaserData::stage_coupling), 3,
+        "EveryStage", 0, "Adaptive", 1, "OncePerStep", 2);
+  new ClassDouble<LaserData>(ca, "StageCouplingTolerance", this, &LaserData::stage_coupling_tol);
+
 }
 
 //------------------------------------------------------------------------------
@@ -2844,10 +2913,12 @@ EmbeddedSurfaceData::EmbeddedSurfaceData()
   // force calculation
   gauss_points_lofting = 0.0;
   internal_pressure = 0.0;
+  stencil_reuse_tol = 0.0; //reuse only if the surface does not move
   quadrature = ONE_POINT;
   twoD_to_threeD = RADIAL_BASIS;
 
   filename = "";
+  mesh_cache = NO;
   type = None;
   thermal  = Adiabatic;
   wall_temperature = 300.0; //!< Kelvin
@@ -2864,7 +2935,7 @@ EmbeddedSurfaceData::EmbeddedSurfaceData()
 Assigner *EmbeddedSurfaceData::getAssigner()
 {
 
-  ClassAssigner *ca = new ClassAssigner("normal", 14, nullAssigner);
+  ClassAssigner *ca = new ClassAssigner("normal", 16, nullAssigner);
 
   new ClassToken<EmbeddedSurfaceData> (ca, "SurfaceProvidedByAnotherSolver", this,
      reinterpret_cast<int EmbeddedSurfaceData::*>(&EmbeddedSurfaceData::provided_by_another_solver), 2,
@@ -2875,6 +2946,10 @@ Assigner *EmbeddedSurfaceData::getAssigner()
 
   new ClassStr<EmbeddedSurfaceData>(ca, "MeshFile", this, &EmbeddedSurfaceData::filename);
 
+  new ClassToken<EmbeddedSurfaceData> (ca, "MeshCache", this,
+     reinterpret_cast<int EmbeddedSurfaceData::*>(&EmbeddedSurfaceData::mesh_cache), 2,
+     "No", 0, "Yes", 1);
+
   new ClassStr<EmbeddedSurfaceData>(ca, "ContactSurfaceOutput", this, &EmbeddedSurfaceData::wetting_output_filename);
 
 
@@ -2887,6 +2962,9 @@ Assigner *EmbeddedSurfaceData::getAssigner()
 
   new ClassDouble<EmbeddedSurfaceData>(ca, "InternalPressure", this, &EmbeddedSurfaceData::internal_pressure);
 
+  new ClassDouble<EmbeddedSurfaceData>(ca, "GaussPointStencilReuseTolerance", this,
+                                       &EmbeddedSurfaceData::stencil_reuse_tol);
+
   new ClassToken<EmbeddedSurfaceData> (ca, "TwoDimensionalToThreeDimensionalMapping", this,
       reinterpret_cast<int EmbeddedSurfaceData::*>(&EmbeddedSurfaceData::twoD_to_threeD), 2,
       "RadialBasisInterpolation", 0, "NearestNeighbor", 1);
@@ -2962,17 +3040,22 @@ void EmbeddedBoundaryMethodData::setup(const char *name, ClassAssigner *father)
 AerosCouplingData::AerosCouplingData()
 {
   fsi_algo = NONE;
+  exchange = CENTRALIZED;
 }
 
 //------------------------------------------------------------------------------
 
 void AerosCouplingData::setup(const char *name, ClassAssigner *father)
 {
-  ClassAssigner *ca = new ClassAssigner(name, 1, father);
+  ClassAssigner *ca = new ClassAssigner(name, 2, father);
 
   new ClassToken<AerosCouplingData> (ca, "FSIAlgorithm", this,
      reinterpret_cast<int AerosCouplingData::*>(&AerosCouplingData::fsi_algo), 4,
      "None", 0, "ByAeroS", 1, "C0", 2, "A6", 3);
+
+  new ClassToken<AerosCouplingData> (ca, "DataExchange", this,
+     reinterpret_cast<int AerosCouplingData::*>(&AerosCouplingData::exchange), 2,
+     "Centralized", 0, "Distributed", 1);
 }
 
 //------------------------------------------------------------------------------
@@ -600,6 +600,10 @@ struct SchemeData {
 
   SmoothingData smooth;
 
+  //! Skipping quiescent regions (See ActiveTiles)
+  int active_tile_size; //!< number of cells along each edge of a tile (<=0: no skipping)
+  int active_tile_report_frequency; //!< report the fraction of computed cells every N time steps (<=0: never)
+
   SchemeData();
   ~SchemeData() {}
 
@@ -762,6 +766,19 @@ struct ExplicitData {
 //!time-integration scheme used
   enum Type {FORWARD_EULER = 0, RUNGE_KUTTA_2 = 1, RUNGE_KUTTA_3 = 2} type;
 
+  //! low-storage: the intermediate state of Runge-Kutta schemes is not stored. V is overwritten, and the
+  //! conservative stage state is recovered from it. (RK2/RK3 keep U(n), R, and V: 3 instead of 5 arrays)
+  enum OnOff {OFF = 0, ON = 1} low_storage;
+
+  //! packed: level sets are advected together (shared velocity reconstruction, fused stage updates)
+  OnOff packed_level_sets;
+
+  //! multi-rate transport: level sets and the reference map are advanced every N flow steps (at most),
+  //! with their own CFL-based sub-steps and time-interpolated velocity. N = 1: lock-step with N-S.
+  int transport_update_interval;
+  double transport_cfl; //!< CFL number of the transport sub-steps (based on the velocity only)
+  double transport_max_displacement; //!< max. interface travel between two updates (in cells)
+
   ExplicitData();
   ~ExplicitData() {}
 
@@ -771,6 +788,25 @@ struct ExplicitData {
 
 //------------------------------------------------------------------------------
 
+struct MultigridData {
+
+  //! number of levels, including the fine level (1: no multigrid)
+  int num_levels;
+
+  //! number of smoothing iterations on each coarse level (before and after the coarse-grid correction)
+  int pre_smoothing;
+  int post_smoothing;
+  int coarsest_smoothing; //!< on the coarsest level
+
+  MultigridData();
+  ~MultigridData() {}
+
+  void setup(const char *, ClassAssigner * = 0);
+
+};
+
+//------------------------------------------------------------------------------
+
 struct TsData {
 
   enum Type {EXPLICIT = 0, IMPLICIT = 1} type;
@@ -782,6 +818,16 @@ struct TsData {
   //! Parameters for steady-state computations
   double convergence_tolerance; //!< tolerance for residual.
   enum YesNo {NO = 0, YES = 1} local_dt; //!< each control volume applies its own time step size
+  //! Unsteady computations with local time-stepping (See TimeIntegratorLTS)
+  int lts_max_level; //!< max number of halvings of the largest cluster time step (max ratio: 2^lts_max_level)
+  //! Steady-state computations: nonlinear multigrid (See MultigridOperator)
+  MultigridData mg;
+  const char *residual_history_file; //!< residual norms of each iteration (steady-state only; "": no output)
+
+  //! Run control based on wall-clock time (See RunControl)
+  double wallclock_limit; //!< wall-clock time budget in seconds (<=0: no limit)
+  double wallclock_reserve; //!< time reserved for the final outputs, in seconds (<0: 5% of the budget)
+  int perf_report_frequency; //!< report throughput & predicted time-to-finish every N steps (<=0: never)
 
   ExplicitData expl;
 
@@ -956,6 +1002,10 @@ struct LaserData {
   double max_iter;
   double relax_coeff;
 
+  //! coupling with multi-stage time integrators (e.g., RK2, RK3)
+  enum StageCoupling {EVERY_STAGE = 0, ADAPTIVE = 1, ONCE_PER_STEP = 2} stage_coupling;
+  double stage_coupling_tol; //!< (ADAPTIVE) max. relative change of absorption coeff. without re-solving
+
   LaserData();
   ~LaserData() {}
 
@@ -1285,6 +1335,7 @@ struct EmbeddedSurfaceData {
              Size = 6} type;
   enum YesNo {NO = 0, YES = 1} provided_by_another_solver;
   const char *filename; //!< file for nodal coordinates and elements
+  YesNo mesh_cache; //!< store a binary copy of the mesh ("<filename>.bin") and load it in later runs
   enum ThermalCondition {Adiabatic = 0, Isothermal = 1, Source = 2} thermal;
   double wall_temperature; //!< used only in the case of isothermal wall 
   double heat_source;
@@ -1301,6 +1352,7 @@ struct EmbeddedSurfaceData {
                             SIX_POINT = 4} quadrature;
   double gauss_points_lofting; //!< non-dimensional, relative to local element size
   double internal_pressure; //!< pressure applied on the inactive side (i.e. inside solid body)
+  double stencil_reuse_tol; //!< Gauss point stencils are reused while the surface moves less than this (<0: never)
 
   enum TwoDimensionalToThreeDimensionalMapping {RADIAL_BASIS = 0, 
                                                 NEAREST_NEIGHBOR = 1} twoD_to_threeD; //!< only for 2->3D
@@ -1359,6 +1411,10 @@ struct AerosCouplingData {
 
   enum FSICouplingAlgorithm {NONE = 0, BY_AEROS = 1, C0 = 2, A6 = 3} fsi_algo;
 
+  //! Centralized: proc 0 exchanges data with all the AERO-S procs. Distributed: each proc exchanges
+  //! data for a block of nodes of the wet surface.
+  enum ExchangeMode {CENTRALIZED = 0, DISTRIBUTED = 1} exchange;
+
   AerosCouplingData();
   ~AerosCouplingData() {}
 
@@ -107,35 +107,46 @@ IonizationOperator::ComputeIonization(SpaceVariable3D &V, SpaceVariable3D &ID)
 
   Vec5D***   v  = (Vec5D***)V.GetDataPointer();
   double*** id  = ID.GetDataPointer();
-  double*** zav = Zav.GetDataPointer();
+  double*** zav = Zav.GetDataPointer(); //values from the previous call are used as initial guesses
   double*** nh  = Nh.GetDataPointer();
   double*** ne  = Ne.GetDataPointer();
 
-  std::map<int, double***> alphas;
-  std::map<int, vector<double> > nodal_alphas;
-
+  int stride = max_charge_in_output+2;
+  std::vector<int> species;
+  std::vector<double***> alphas;
   for(auto it = AlphaRJ.begin(); it != AlphaRJ.end(); it++) {
-    alphas[it->first] = it->second->GetDataPointer();
-    nodal_alphas[it->first] = vector<double>(max_charge_in_output+2);
+    species.push_back(it->first);
+    alphas.push_back(it->second->GetDataPointer());
   }
+  int nSpecies = species.size();
 
-  // Main loop
+  // Main loop: Each batch contains the cells of one material in a row (along x)
   int k0, kmax, j0, jmax, i0, imax;
   ID.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
+  std::vector<std::vector<int> > points(saha.size());
+  std::vector<double> alpha_row((imax-i0)*nSpecies*stride);
 
-        saha[id[k][j][i]]->Solve(v[k][j][i], zav[k][j][i], nh[k][j][i], ne[k][j][i], nodal_alphas);
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++) {
+
+      for(auto&& pts : points)
+        pts.clear();
+      for(int i=i0; i<imax; i++)
+        points[(int)id[k][j][i]].push_back(i-i0);
+
+      for(int m=0; m<(int)saha.size(); m++) {
+        if(points[m].empty())
+          continue;
+        saha[m]->SolveBatch(points[m], (double*)&v[k][j][i0], &zav[k][j][i0], &nh[k][j][i0], &ne[k][j][i0],
+                            species, stride, alpha_row.data(), true);
+      }
 
-        auto it0 = nodal_alphas.begin();
-        for(auto it = alphas.begin(); it != alphas.end(); it++) {
-          for(int p=0; p<max_charge_in_output+2; p++) 
-            (it->second)[k][j][i*(max_charge_in_output+2)+p] = (it0->second)[p];
-          it0++;
-        }
+      for(int s=0; s<nSpecies; s++)
+        for(int i=i0; i<imax; i++)
+          for(int p=0; p<stride; p++) 
+            alphas[s][k][j][i*stride+p] = alpha_row[((i-i0)*nSpecies+s)*stride+p];
 
-      }
+    }
 
 
   V.RestoreDataPointerToLocalVector();
@@ -41,6 +41,10 @@ LaserAbsorptionSolver::LaserAbsorptionSolver(MPI_Comm &comm_, DataManagers3D &dm
 
   L_initialized = false;
 
+  power_solved = 0.0;
+  lag_error = 0.0;
+  stage_solves = stage_skips = 0;
+
   // Check input parameters
   CheckForInputErrors();
 
@@ -110,6 +114,10 @@ LaserAbsorptionSolver::LaserAbsorptionSolver(MPI_Comm &comm_, DataManagers3D &dm
 
   L_initialized = false;
 
+  power_solved = 0.0;
+  lag_error = 0.0;
+  stage_solves = stage_skips = 0;
+
   // Check input parameters
   CheckForInputErrors();
 
@@ -1863,11 +1871,14 @@ LaserAbsorptionSolver::ComputeLaserRadiance(SpaceVariable3D &V_, SpaceVariable3D
     power_current = GetSourcePower(t);
     if(power_current < 1.0e-18/*eps*/) {
       if(!L_is_already_set_to_zero0) {
-        L_.SetConstantValue(0.0, false); //use "false" to trigger "Restore...Insert" because L_ may be printed to file.
+        L_.SetConstantValue(0.0, false); //ghosts marked stale; exchanged when next needed (e.g., output)
         L_is_already_set_to_zero0 = true;
       }
       L_initialized = false; 
       power_previous = power_current;
+      power_solved = power_current;
+      stage_solves = stage_skips = 0; //the lagged-radiance report starts over with the next solve
+      lag_error = 0.0;
       return;
     }
     L_is_already_set_to_zero0 = false;
@@ -1877,6 +1888,23 @@ LaserAbsorptionSolver::ComputeLaserRadiance(SpaceVariable3D &V_, SpaceVariable3D
 
   PopulateLaserMesh(V_, ID_, L_); //get Temperature, ID, and L on the laser mesh (may or may not be the same as the N-S mesh)
 
+  // Report the error of the lagged radiance in the time step that has just been completed
+  if(stage_skips>0) {
+    lag_error = std::max(lag_error, EstimateLagError(t));
+    print("- Laser radiance: %d stage solve(s), %d lagged. Est. error (rel. change of abs. coeff.): %e.\n",
+          stage_solves, stage_skips, lag_error);
+  }
+  stage_solves = stage_skips = 0;
+  lag_error = 0.0;
+
+  SolveAndPopulateRadiance(L_, t);
+}
+
+//--------------------------------------------------------------------------
+
+void
+LaserAbsorptionSolver::SolveAndPopulateRadiance(SpaceVariable3D &L_, const double t)
+{
   // Compute L on the laser mesh
   if(active_core) {
     bool success;
@@ -1907,12 +1935,113 @@ LaserAbsorptionSolver::ComputeLaserRadiance(SpaceVariable3D &V_, SpaceVariable3D
 
     if(!success)
       print_error(comm,"*** Error: Laser radiance solver failed to converge.\n");
+
+    if(iod.laser.stage_coupling != LaserData::EVERY_STAGE)
+      StoreAbsorptionCoefficients();
   }
 
   PopulateRadianceOnNavierStokesMesh(L_);
 
-  if(!source_power_timehistory.empty())
+  if(!source_power_timehistory.empty()) {
     power_previous = power_current;
+    power_solved = power_current;
+  }
+}
+
+//--------------------------------------------------------------------------
+
+void
+LaserAbsorptionSolver::ComputeLaserRadianceInStage(SpaceVariable3D &V_, SpaceVariable3D &ID_, SpaceVariable3D &L_,
+                                                   const double t)
+{
+  if(iod.laser.stage_coupling == LaserData::EVERY_STAGE) {
+    ComputeLaserRadiance(V_, ID_, L_, t);
+    return;
+  }
+
+  if(!source_power_timehistory.empty()) {
+    power_current = GetSourcePower(t);
+    if(power_current < 1.0e-18/*eps*/) {
+      ComputeLaserRadiance(V_, ID_, L_, t); //sets L = 0
+      return;
+    }
+  }
+
+  // Temperature (and ID) in the laser domain must be updated anyway, as they are used to compute the heat source
+  // (AddHeatToNavierStokesResidual). This is cheap compared to the mean flux iterations.
+  PopulateLaserMesh(V_, ID_, L_);
+
+  double err = EstimateLagError(t);
+
+  if(iod.laser.stage_coupling == LaserData::ADAPTIVE && err > iod.laser.stage_coupling_tol) {
+    // The previous L is used as the initial guess (L_initialized == true).
+    L_is_already_set_to_zero0 = false;
+    SolveAndPopulateRadiance(L_, t);
+    stage_solves++;
+  } else {
+    // re-use (lagged) L
+    stage_skips++;
+    lag_error = std::max(lag_error, err);
+  }
+}
+
+//--------------------------------------------------------------------------
+
+double
+LaserAbsorptionSolver::EstimateLagError(const double t)
+{
+  // The radiance depends on the state only through the absorption coefficient (a function of T and ID) and the
+  // source power. Here, the error of a lagged radiance is estimated by the max. relative change of these quantities.
+  double buf[2] = {0.0, 0.0}; //max change of eta, max eta at the last solve
+
+  if(active_core) {
+    // GetDataPointer may exchange ghosts (collective), so it is called on every active core
+    double*** T  = Temperature.GetDataPointer();
+    double*** id = ID->GetDataPointer();
+    if(eta_solved.size() != sortedNodes.size())
+      buf[0] = DBL_MAX; //never solved
+    else {
+      for(int n = queueCounter[0]; n < (int)sortedNodes.size(); n++) {
+        int i(sortedNodes[n].i), j(sortedNodes[n].j), k(sortedNodes[n].k);
+        double eta = GetAbsorptionCoefficient(T[k][j][i], id[k][j][i]);
+        buf[0] = std::max(buf[0], fabs(eta - eta_solved[n]));
+        buf[1] = std::max(buf[1], fabs(eta_solved[n]));
+      }
+    }
+    Temperature.RestoreDataPointerToLocalVector();
+    ID->RestoreDataPointerToLocalVector();
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, buf, 2, MPI_DOUBLE, MPI_MAX, nscomm); //all the N-S cores make the same decision
+
+  double err = buf[0]==0.0 ? 0.0 : (buf[1]>0.0 ? buf[0]/buf[1] : DBL_MAX);
+
+  if(!source_power_timehistory.empty()) {
+    double power = GetSourcePower(t);
+    if(power_solved < 1.0e-18/*eps*/)
+      err = DBL_MAX;
+    else
+      err = std::max(err, fabs(power - power_solved)/power_solved);
+  }
+
+  return err;
+}
+
+//--------------------------------------------------------------------------
+
+void
+LaserAbsorptionSolver::StoreAbsorptionCoefficients()
+{
+  eta_solved.assign(sortedNodes.size(), 0.0);
+
+  double*** T  = Temperature.GetDataPointer();
+  double*** id = ID->GetDataPointer();
+  for(int n = queueCounter[0]; n < (int)sortedNodes.size(); n++) {
+    int i(sortedNodes[n].i), j(sortedNodes[n].j), k(sortedNodes[n].k);
+    eta_solved[n] = GetAbsorptionCoefficient(T[k][j][i], id[k][j][i]);
+  }
+  Temperature.RestoreDataPointerToLocalVector();
+  ID->RestoreDataPointerToLocalVector();
 }
 
 //--------------------------------------------------------------------------
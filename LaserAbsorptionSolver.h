@@ -149,6 +149,12 @@ class LaserAbsorptionSolver {
   double mfm_alpha;
   double sor_relax;
 
+  //! lagged coupling with multi-stage time integrators (see LaserData::stage_coupling)
+  std::vector<double> eta_solved; //!< absorption coeff. at sorted nodes, at the last solve
+  double power_solved; //!< source power at the last solve (if time-history is specified)
+  double lag_error; //!< max. estimated error of the lagged radiance in the current time step
+  int stage_solves, stage_skips; //!< counters for the current time step
+
 public:
 
   LaserAbsorptionSolver(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_, std::vector<VarFcnBase*> &varFcn_,
@@ -169,6 +175,10 @@ public:
   void ComputeLaserRadiance(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &L, 
                             const double t); 
 
+  //! Called within the stages of a multi-stage time integrator. Depending on iod.laser.stage_coupling, L may be
+  //! re-used from the previous solve (i.e. lagged) instead of re-computed.
+  void ComputeLaserRadianceInStage(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &L, const double t);
+
   //! Compute eta*L and add to the 5th entry of R. (Not multiplying cell volume)
   void AddHeatToNavierStokesResidual(SpaceVariable3D &R, SpaceVariable3D &L, SpaceVariable3D &ID, 
                                      SpaceVariable3D *V = NULL); //if NULL, use stored temperature
@@ -213,6 +223,13 @@ private:
 
   bool ComputeLaserRadianceMeanFluxMethod(const double t, double alpha, double relax_coeff);
 
+  //! solve for L on the laser mesh, then transfer it to the N-S mesh (called after PopulateLaserMesh)
+  void SolveAndPopulateRadiance(SpaceVariable3D &L_, const double t);
+
+  // functions for lagged coupling (called after PopulateLaserMesh)
+  double EstimateLagError(const double t); //!< relative change of absorption coeff. since the last solve
+  void StoreAbsorptionCoefficients();
+
   //-------------------------------------------------------------
   // functions called by ComputeLaserRadianceMeanFluxMethod
   void ComputeTemperatureInLaserDomain(Vec5D*** v, double*** id, double*** T);
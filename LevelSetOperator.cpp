@@ -931,7 +931,7 @@ LevelSetOperator::ApplyInitialConditionWithinEnclosure(UserSpecifiedEnclosureDat
 //-----------------------------------------------------
 
 // Apply boundary conditions by populating ghost cells of Phi
-void LevelSetOperator::ApplyBoundaryConditions(SpaceVariable3D &Phi)
+void LevelSetOperator::ApplyBoundaryConditions(SpaceVariable3D &Phi, bool exchange)
 {
 
   double*** phi = (double***) Phi.GetDataPointer();
@@ -1027,7 +1027,10 @@ void LevelSetOperator::ApplyBoundaryConditions(SpaceVariable3D &Phi)
 
   }
 
-  Phi.RestoreDataPointerAndInsert();
+  if(exchange)
+    Phi.RestoreDataPointerAndInsert();
+  else //external ghosts do not participate in communications anyway
+    Phi.RestoreDataPointerToLocalVector();
 
   coordinates.RestoreDataPointerToLocalVector();
 
@@ -1036,7 +1039,8 @@ void LevelSetOperator::ApplyBoundaryConditions(SpaceVariable3D &Phi)
 //-----------------------------------------------------
 
 void LevelSetOperator::ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R,
-                                       [[maybe_unused]] double time, [[maybe_unused]] double dt)
+                                       [[maybe_unused]] double time, [[maybe_unused]] double dt,
+                                       LevelSetOperator *velocity_source)
 {
 
 #ifdef LEVELSET_TEST
@@ -1044,7 +1048,7 @@ void LevelSetOperator::ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &Phi,
 #endif
 
   if(iod_ls.solver == LevelSetSchemeData::FINITE_VOLUME)
-    ComputeResidualFVM(V,Phi,R);
+    ComputeResidualFVM(V,Phi,R,velocity_source);
   else if(iod_ls.solver == LevelSetSchemeData::FINITE_DIFFERENCE)
     ComputeResidualFDM(V,Phi,R);
 
@@ -1052,6 +1056,89 @@ void LevelSetOperator::ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &Phi,
 
 //-----------------------------------------------------
 
+void LevelSetOperator::ComputeResiduals(vector<LevelSetOperator*> &lso, SpaceVariable3D &V,
+                                        vector<SpaceVariable3D*> &Phi, vector<SpaceVariable3D*> &R,
+                                        double time, double dt)
+{
+  assert(lso.size() == Phi.size() && lso.size() == R.size());
+
+  for(int i=0; i<(int)lso.size(); i++) {
+    LevelSetOperator *source = NULL;
+    for(int j=0; j<i; j++)
+      if(lso[i]->SharesVelocityReconstruction(*lso[j])) {
+        source = lso[j];
+        break;
+      }
+    lso[i]->ComputeResidual(V, *Phi[i], *R[i], time, dt, source);
+  }
+}
+
+//-----------------------------------------------------
+
+static bool HasReconstructionFixes(ReconstructionData &rec)
+{
+  FixData &fixes(rec.fixes);
+  return !fixes.sphereMap.dataMap.empty() || !fixes.parallelepipedMap.dataMap.empty() ||
+         !fixes.spheroidMap.dataMap.empty() || !fixes.cylinderconeMap.dataMap.empty() ||
+         !fixes.cylindersphereMap.dataMap.empty();
+}
+
+//-----------------------------------------------------
+
+bool LevelSetOperator::SharesVelocityReconstruction(LevelSetOperator &other)
+{
+#ifdef LEVELSET_TEST
+  return false; //velocity is prescribed by each level set operator
+#endif
+
+  // The narrow-band version reconstructs velocity only within the band (which is different for each level set)
+  if(&other == this || narrow_band || other.narrow_band)
+    return false;
+
+  if(iod_ls.solver != LevelSetSchemeData::FINITE_VOLUME ||
+     other.iod_ls.solver != LevelSetSchemeData::FINITE_VOLUME)
+    return false;
+
+  ReconstructionData &r0(iod_ls.rec), &r1(other.iod_ls.rec);
+  return r0.type == r1.type && r0.limiter == r1.limiter && r0.slopeNearInterface == r1.slopeNearInterface &&
+         r0.generalized_minmod_coeff == r1.generalized_minmod_coeff &&
+         !HasReconstructionFixes(r0) && !HasReconstructionFixes(r1); //fixes are not compared (conservative)
+}
+
+//-----------------------------------------------------
+
+void LevelSetOperator::AdvanceStage(double a, SpaceVariable3D &X, double b, SpaceVariable3D &Y, double c,
+                                    SpaceVariable3D &Z)
+{
+  double*** x = X.GetDataPointer();
+  double*** y = &X == &Y ? x : Y.GetDataPointerInteriorOnly();
+  double*** z = Z.GetDataPointerInteriorOnly();
+
+  if(!narrow_band) {
+    for(int k=k0; k<kmax; k++)
+      for(int j=j0; j<jmax; j++)
+        for(int i=i0; i<imax; i++)
+          x[k][j][i] = a*x[k][j][i] + b*y[k][j][i] + c*z[k][j][i];
+  }
+  else { //narrow-band
+    for(auto it = useful_nodes.begin(); it != useful_nodes.end(); it++) {
+      int i((*it)[0]), j((*it)[1]), k((*it)[2]);
+      if(!X.IsHere(i,j,k,false)) 
+        continue;
+      x[k][j][i] = a*x[k][j][i] + b*y[k][j][i] + c*z[k][j][i];
+    }    
+  }
+
+  X.RestoreDataPointerAndInsert();
+  if(&X != &Y)
+    Y.RestoreDataPointerToLocalVector();
+  Z.RestoreDataPointerToLocalVector();
+
+  ApplyBoundaryConditions(X, false);
+}
+
+//-----------------------------------------------------
+
 void LevelSetOperator::ComputeResidualFDM(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R)
 {
 
@@ -1067,7 +1154,7 @@ void LevelSetOperator::ComputeResidualFDM_FullDomain(SpaceVariable3D &V, SpaceVa
 {
   Vec5D***    v = (Vec5D***) V.GetDataPointer();
   double*** phi = Phi.GetDataPointer();
-  double*** res = R.GetDataPointer(); //residual, on the right-hand-side of the ODE 
+  double*** res = R.GetDataPointerInteriorOnly(); //residual, on the right-hand-side of the ODE 
 
   //***************************************************************
   // Step 1: Calculate partial derivatives of phi
@@ -1135,7 +1222,7 @@ void LevelSetOperator::ComputeResidualFDM_FullDomain(SpaceVariable3D &V, SpaceVa
   V.RestoreDataPointerToLocalVector();
   Phi.RestoreDataPointerToLocalVector();
 
-  R.RestoreDataPointerAndInsert();
+  R.RestoreDataPointerAndMarkGhostsStale(); //ghosts of R are usually not needed
 
 }
 
@@ -1145,7 +1232,7 @@ void LevelSetOperator::ComputeResidualFDM_NarrowBand(SpaceVariable3D &V, SpaceVa
 {
   Vec5D***    v = (Vec5D***) V.GetDataPointer();
   double*** phi = Phi.GetDataPointer();
-  double*** res = R.GetDataPointer(); //residual, on the right-hand-side of the ODE 
+  double*** res = R.GetDataPointerInteriorOnly(); //residual, on the right-hand-side of the ODE 
 
   //***************************************************************
   // Step 1: Calculate partial derivatives of phi
@@ -1228,22 +1315,26 @@ void LevelSetOperator::ComputeResidualFDM_NarrowBand(SpaceVariable3D &V, SpaceVa
   V.RestoreDataPointerToLocalVector();
   Phi.RestoreDataPointerToLocalVector();
 
-  R.RestoreDataPointerAndInsert();
+  R.RestoreDataPointerAndMarkGhostsStale(); //ghosts of R are usually not needed
 
 }
 
 //-----------------------------------------------------
 
-void LevelSetOperator::ComputeResidualFVM(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R)
+void LevelSetOperator::ComputeResidualFVM(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R,
+                                          LevelSetOperator *velocity_source)
 {
 
   if(!narrow_band) {
 
-    Reconstruct(V, Phi); // => ul, ur, dudx, vb, vt, dvdy, wk, wf, dwdz, Phil, Phir, Phib, Phit, Phik, Phif
+    LevelSetOperator &vel(velocity_source ? *velocity_source : *this);
+    assert(&vel == this || SharesVelocityReconstruction(vel));
 
-    ComputeAdvectionFlux(R);  //Advection flux, on the right-hand-side
+    Reconstruct(V, Phi, &vel == this); // => ul, ur, dudx, vb, vt, dvdy, wk, wf, dwdz, Phil, Phir, Phib, Phit, Phik, Phif
 
-    AddSourceTerm(Phi, R);
+    ComputeAdvectionFlux(R, vel);  //Advection flux, on the right-hand-side
+
+    AddSourceTerm(Phi, R, vel);
   }
   else {
 
@@ -1259,8 +1350,13 @@ void LevelSetOperator::ComputeResidualFVM(SpaceVariable3D &V, SpaceVariable3D &P
 
 //-----------------------------------------------------
 
-void LevelSetOperator::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi)
+void LevelSetOperator::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi, bool reconstruct_velocity)
 {
+  if(!reconstruct_velocity) { //reuse the velocity reconstructed by another level set operator
+    rec->Reconstruct(Phi, Phil, Phir, Phib, Phit, Phik, Phif);
+    return;
+  }
+
   Vec5D*** v = (Vec5D***) V.GetDataPointer();
    
   // Reconstruction: x-velocity
@@ -1339,7 +1435,7 @@ void LevelSetOperator::ReconstructInBand(SpaceVariable3D &V, SpaceVariable3D &Ph
 
 //-----------------------------------------------------
 
-void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R)
+void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R, LevelSetOperator &vel)
 {
   Vec3D*** dxyz = (Vec3D***)delta_xyz.GetDataPointer();
 
@@ -1349,13 +1445,13 @@ void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R)
   double*** phit   = Phit.GetDataPointer();
   double*** phik   = Phik.GetDataPointer();
   double*** phif   = Phif.GetDataPointer();
-  double*** uldata = ul.GetDataPointer();
-  double*** urdata = ur.GetDataPointer();
-  double*** vbdata = vb.GetDataPointer();
-  double*** vtdata = vt.GetDataPointer();
-  double*** wkdata = wk.GetDataPointer();
-  double*** wfdata = wf.GetDataPointer();
-  double*** res    = R.GetDataPointer(); //residual, on the right-hand-side of the ODE
+  double*** uldata = vel.ul.GetDataPointer();
+  double*** urdata = vel.ur.GetDataPointer();
+  double*** vbdata = vel.vb.GetDataPointer();
+  double*** vtdata = vel.vt.GetDataPointer();
+  double*** wkdata = vel.wk.GetDataPointer();
+  double*** wfdata = vel.wf.GetDataPointer();
+  double*** res    = R.GetDataPointerInteriorOnly(); //residual, on the right-hand-side of the ODE
 
   //initialize R to 0
   for(int k=kk0; k<kkmax; k++)
@@ -1408,14 +1504,14 @@ void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R)
   Phit.RestoreDataPointerToLocalVector();
   Phik.RestoreDataPointerToLocalVector();
   Phif.RestoreDataPointerToLocalVector();
-  ul.RestoreDataPointerToLocalVector();
-  ur.RestoreDataPointerToLocalVector();
-  vb.RestoreDataPointerToLocalVector();
-  vt.RestoreDataPointerToLocalVector();
-  wk.RestoreDataPointerToLocalVector();
-  wf.RestoreDataPointerToLocalVector();
-
-  R.RestoreDataPointerAndInsert(); //insert
+  vel.ul.RestoreDataPointerToLocalVector();
+  vel.ur.RestoreDataPointerToLocalVector();
+  vel.vb.RestoreDataPointerToLocalVector();
+  vel.vt.RestoreDataPointerToLocalVector();
+  vel.wk.RestoreDataPointerToLocalVector();
+  vel.wf.RestoreDataPointerToLocalVector();
+
+  R.RestoreDataPointerToLocalVector(); //no exchange; AddSourceTerm follows
 }
 
 //-----------------------------------------------------
@@ -1436,7 +1532,7 @@ void LevelSetOperator::ComputeAdvectionFluxInBand(SpaceVariable3D &R)
   double*** vtdata = vt.GetDataPointer();
   double*** wkdata = wk.GetDataPointer();
   double*** wfdata = wf.GetDataPointer();
-  double*** res    = R.GetDataPointer(); //residual, on the right-hand-side of the ODE
+  double*** res    = R.GetDataPointerInteriorOnly(); //residual, on the right-hand-side of the ODE
   double*** active = Active.GetDataPointer();
   //double*** useful = UsefulG2.GetDataPointer();
 
@@ -1508,7 +1604,7 @@ void LevelSetOperator::ComputeAdvectionFluxInBand(SpaceVariable3D &R)
   Active.RestoreDataPointerToLocalVector();
   //UsefulG2.RestoreDataPointerToLocalVector();
 
-  R.RestoreDataPointerAndInsert(); //insert
+  R.RestoreDataPointerToLocalVector(); //no exchange; AddSourceTermInBand follows
 }
 
 //-----------------------------------------------------
@@ -1549,13 +1645,13 @@ double LevelSetOperator::ComputeLocalAdvectionFlux(double phim, double phip, dou
 } 
 //-----------------------------------------------------
 
-void LevelSetOperator::AddSourceTerm(SpaceVariable3D &Phi, SpaceVariable3D &R)
+void LevelSetOperator::AddSourceTerm(SpaceVariable3D &Phi, SpaceVariable3D &R, LevelSetOperator &vel)
 {
   double*** phi = (double***) Phi.GetDataPointer();
-  double*** u_x = (double***) dudx.GetDataPointer();
-  double*** v_y = (double***) dvdy.GetDataPointer();
-  double*** w_z = (double***) dwdz.GetDataPointer();
-  double*** res = (double***) R.GetDataPointer();
+  double*** u_x = (double***) vel.dudx.GetDataPointer();
+  double*** v_y = (double***) vel.dvdy.GetDataPointer();
+  double*** w_z = (double***) vel.dwdz.GetDataPointer();
+  double*** res = (double***) R.GetDataPointerInteriorOnly();
 
   for(int k=k0; k<kmax; k++)
     for(int j=j0; j<jmax; j++) 
@@ -1563,10 +1659,10 @@ void LevelSetOperator::AddSourceTerm(SpaceVariable3D &Phi, SpaceVariable3D &R)
         res[k][j][i] += phi[k][j][i]*(u_x[k][j][i] + v_y[k][j][i] + w_z[k][j][i]);
 
   Phi.RestoreDataPointerToLocalVector();
-  dudx.RestoreDataPointerToLocalVector();
-  dvdy.RestoreDataPointerToLocalVector();
-  dwdz.RestoreDataPointerToLocalVector();
-  R.RestoreDataPointerAndInsert();
+  vel.dudx.RestoreDataPointerToLocalVector();
+  vel.dvdy.RestoreDataPointerToLocalVector();
+  vel.dwdz.RestoreDataPointerToLocalVector();
+  R.RestoreDataPointerAndMarkGhostsStale(); //ghosts of R are usually not needed
 }
 
 //-----------------------------------------------------
@@ -1577,7 +1673,7 @@ void LevelSetOperator::AddSourceTermInBand(SpaceVariable3D &Phi, SpaceVariable3D
   double*** u_x = (double***) dudx.GetDataPointer();
   double*** v_y = (double***) dvdy.GetDataPointer();
   double*** w_z = (double***) dwdz.GetDataPointer();
-  double*** res = (double***) R.GetDataPointer();
+  double*** res = (double***) R.GetDataPointerInteriorOnly();
 
   for(auto it = active_nodes.begin(); it != active_nodes.end(); it++) {
     int i((*it)[0]), j((*it)[1]), k((*it)[2]);
@@ -1590,7 +1686,7 @@ void LevelSetOperator::AddSourceTermInBand(SpaceVariable3D &Phi, SpaceVariable3D
   dudx.RestoreDataPointerToLocalVector();
   dvdy.RestoreDataPointerToLocalVector();
   dwdz.RestoreDataPointerToLocalVector();
-  R.RestoreDataPointerAndInsert();
+  R.RestoreDataPointerAndMarkGhostsStale(); //ghosts of R are usually not needed
 }
 
 
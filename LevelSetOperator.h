@@ -81,9 +81,23 @@ public:
                            std::unique_ptr<vector<std::unique_ptr<EmbeddedBoundaryDataSet> > > EBDS = nullptr,
                            vector<std::pair<int,int> > *surf_and_color = NULL);
 
-  void ApplyBoundaryConditions(SpaceVariable3D &Phi);
+  void ApplyBoundaryConditions(SpaceVariable3D &Phi, bool exchange = true); //!< b.c. only affect external ghosts
 
-  void ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R, double time, double dt);
+  //! If velocity_source is given, the velocity reconstructed by it (in the same stage) is reused.
+  void ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R, double time, double dt,
+                       LevelSetOperator *velocity_source = NULL);
+
+  //! Compute the residuals of multiple level sets. Level sets that can share the reconstruction of the
+  //! velocity field (see SharesVelocityReconstruction) reuse the one done for the first of them.
+  static void ComputeResiduals(vector<LevelSetOperator*> &lso, SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi,
+                               vector<SpaceVariable3D*> &R, double time, double dt);
+
+  //! whether the reconstructed velocity of "other" can be used by this level set operator
+  bool SharesVelocityReconstruction(LevelSetOperator &other);
+
+  //! X = a*X + b*Y + c*Z, followed by boundary conditions, with a single halo exchange (of X). Only the
+  //! subdomain interior of Y and Z is accessed (so, Z may carry stale ghosts, e.g., a residual)
+  void AdvanceStage(double a, SpaceVariable3D &X, double b, SpaceVariable3D &Y, double c, SpaceVariable3D &Z);
 
   bool Reinitialize(double time, double dt, int time_step,
                     SpaceVariable3D &Phi, int special_maxIts = 0,//!< if >0, will use it instead of iod value
@@ -120,11 +134,12 @@ private:
   void ComputeResidualFDM_NarrowBand(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R);
 
   //! Finite volume method
-  void ComputeResidualFVM(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R);
+  void ComputeResidualFVM(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R,
+                          LevelSetOperator *velocity_source = NULL);
 
-  void Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi);
-  void ComputeAdvectionFlux(SpaceVariable3D &R);
-  void AddSourceTerm(SpaceVariable3D &Phi, SpaceVariable3D &R);
+  void Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi, bool reconstruct_velocity = true);
+  void ComputeAdvectionFlux(SpaceVariable3D &R, LevelSetOperator &vel); //!< vel: owner of reconstructed velocity
+  void AddSourceTerm(SpaceVariable3D &Phi, SpaceVariable3D &R, LevelSetOperator &vel);
 
   void ReconstructInBand(SpaceVariable3D &V, SpaceVariable3D &Phi); //!< the narrow-band version
   void ComputeAdvectionFluxInBand(SpaceVariable3D &R); //!< the narrow-band version
@@ -4,7 +4,6 @@
  ************************************************************************/
 
 #include<M2CTwinMessenger.h>
-#include<trilinear_interpolation.h>
 #include<cassert>
 #include<climits>
 #include<algorithm> //std::find
@@ -22,7 +21,7 @@ M2CTwinMessenger::M2CTwinMessenger(IoData &iod_, MPI_Comm &m2c_comm_, MPI_Comm &
                                    int status_)
               : iod(iod_), m2c_comm(m2c_comm_), joint_comm(joint_comm_),
                 coordinates(NULL), ghost_nodes_inner(NULL), ghost_nodes_outer(NULL),
-                global_mesh(NULL), TMP(NULL), TMP3(NULL), Color(NULL), floodfiller(NULL)
+                global_mesh(NULL), exchange_dim(-1), TMP(NULL), TMP3(NULL), Color(NULL), floodfiller(NULL)
 {
 
   MPI_Comm_rank(m2c_comm, &m2c_rank);
@@ -54,6 +53,13 @@ M2CTwinMessenger::~M2CTwinMessenger()
 void
 M2CTwinMessenger::Destroy()
 {
+  for(auto&& req : data_send_requests)
+    MPI_Request_free(&req);
+  for(auto&& req : data_recv_requests)
+    MPI_Request_free(&req);
+  data_send_requests.clear();
+  data_recv_requests.clear();
+
   if(TMP)
     TMP->Destroy();
   if(TMP3)
@@ -690,13 +696,13 @@ M2CTwinMessenger::CommunicateBeforeTimeStepping(SpaceVariable3D &coordinates_, D
 
     // verify that the green boxes (tag = 2) form a closed interface in the outer
     // mesh that separates nodes that are "active" and "inactive"
-    std::set<Int3> occluded_nodes; //to be filled w/ green boxes, including internal ghosts
+    std::vector<Int3> occluded_nodes; //to be filled w/ green boxes, including internal ghosts
     tag = TMP->GetDataPointer();
     for(int k=kk0; k<kkmax; k++)
       for(int j=jj0; j<jjmax; j++)
         for(int i=ii0; i<iimax; i++)
           if(tag[k][j][i]==2)
-            occluded_nodes.insert(Int3(i,j,k)); // green box
+            occluded_nodes.push_back(Int3(i,j,k)); // green box
     TMP->RestoreDataPointerToLocalVector();
     
     int nReg = floodfiller->FillBasedOnEdgeObstructions(*TMP3, 0/*non_obstruction_flag*/, 
@@ -814,6 +820,8 @@ M2CTwinMessenger::CommunicateBeforeTimeStepping(SpaceVariable3D &coordinates_, D
 
   }
 
+  SetupExchangePattern(V);
+
   ExchangeData(V);
 
   if(twinning_status == FOLLOWER) {
@@ -880,114 +888,135 @@ M2CTwinMessenger::FinalExchange(SpaceVariable3D &V)
 //---------------------------------------------------------------
 
 void
-M2CTwinMessenger::ExchangeData(SpaceVariable3D &V)
+M2CTwinMessenger::SetupExchangePattern(SpaceVariable3D &V)
 {
-  //First send data from follower to leader, then the opposite way (See KW's notes)
-  InterpolateDataAndTransfer(V, FOLLOWER);
-  InterpolateDataAndTransfer(V, LEADER);
-}
-
-//---------------------------------------------------------------
-
-void
-M2CTwinMessenger::InterpolateDataAndTransfer(SpaceVariable3D &V, TwinningStatus sender)
-{
-
   int numTwinProcs(-1);
   MPI_Comm_remote_size(joint_comm, &numTwinProcs);
-
-  // ----------------------------------------
-  // Step 1. Check buffer size. Extend if needed.
-  // ----------------------------------------
-  int dim(-1);
-  if((int)import_buffer.size() != numTwinProcs)
-    import_buffer.resize(numTwinProcs);
+  assert((int)import_nodes.size() == numTwinProcs);
+  assert((int)export_points.size() == numTwinProcs);
+
+  exchange_dim = V.NumDOF();
+  int dim = exchange_dim;
+
+  // strides of the 8 nodes of an interpolation cell in the ghosted local array
+  int ii0, jj0, kk0, iimax, jjmax, kkmax;
+  coordinates->GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+  long sx = dim, sy = (long)(iimax-ii0)*dim, sz = (long)(jjmax-jj0)*sy;
+  for(int c=0; c<8; c++)
+    corner_stride[c] = (c&1 ? sx : 0) + (c&2 ? sy : 0) + (c&4 ? sz : 0);
+
+  // trilinear weights (corner c is (i+c&1, j+(c&2)/2, k+(c&4)/4))
+  export_weights.resize(numTwinProcs);
+  export_offsets.resize(numTwinProcs);
   for(int proc=0; proc<numTwinProcs; proc++) {
-    if(import_nodes[proc].size()>0) {
-      dim = import_buffer[proc].size()/import_nodes[proc].size();
-      break;
+    export_weights[proc].resize(8*export_points[proc].size());
+    export_offsets[proc].resize(export_points[proc].size());
+    for(int p=0; p<(int)export_points[proc].size(); p++) {
+      Int3 &ijk(export_points[proc][p].ijk);
+      Vec3D &xi(export_points[proc][p].xi);
+      export_offsets[proc][p] = (long)(ijk[2]-kk0)*sz + (long)(ijk[1]-jj0)*sy + (long)(ijk[0]-ii0)*sx;
+      double *w = &export_weights[proc][8*p];
+      for(int c=0; c<8; c++)
+        w[c] = (c&1 ? xi[0] : 1.0-xi[0])*(c&2 ? xi[1] : 1.0-xi[1])*(c&4 ? xi[2] : 1.0-xi[2]);
     }
   }
-  if(dim<V.NumDOF()) {
-    dim = V.NumDOF();
-    for(int proc=0; proc<numTwinProcs; proc++)
-      import_buffer[proc].resize(dim*import_nodes[proc].size());
-  }
 
-  dim = -1;
-  if((int)export_buffer.size() != numTwinProcs)
-    export_buffer.resize(numTwinProcs);
+  // buffers and persistent requests
+  import_buffer.resize(numTwinProcs);
+  export_buffer.resize(numTwinProcs);
   for(int proc=0; proc<numTwinProcs; proc++) {
+    import_buffer[proc].assign(dim*import_nodes[proc].size(), 0.0);
+    export_buffer[proc].assign(dim*export_points[proc].size(), 0.0);
+    if(import_nodes[proc].size()>0) {
+      data_recv_requests.push_back(MPI_Request());
+      MPI_Recv_init(import_buffer[proc].data(), import_buffer[proc].size(), MPI_DOUBLE,
+                    proc, proc, joint_comm, &data_recv_requests.back());
+    }
     if(export_points[proc].size()>0) {
-      dim = export_buffer[proc].size()/export_points[proc].size();
-      break;
+      data_send_requests.push_back(MPI_Request());
+      MPI_Send_init(export_buffer[proc].data(), export_buffer[proc].size(), MPI_DOUBLE,
+                    proc, m2c_rank/*tag*/, joint_comm, &data_send_requests.back());
     }
   }
-  if(dim<V.NumDOF()) {
-    dim = V.NumDOF();
-    for(int proc=0; proc<numTwinProcs; proc++)
-      export_buffer[proc].resize(dim*export_points[proc].size());
+}
+
+//---------------------------------------------------------------
+
+void
+M2CTwinMessenger::ExchangeData(SpaceVariable3D &V)
+{
+  assert(exchange_dim == V.NumDOF());
+
+  // First send data from follower to leader, then the opposite way (See KW's notes). The receives
+  // are posted right away, so the data of both transfers can arrive at any time.
+  if(!data_recv_requests.empty())
+    MPI_Startall(data_recv_requests.size(), data_recv_requests.data());
+
+  if(twinning_status == FOLLOWER) {
+    InterpolateExportData(V);
+    if(!data_send_requests.empty())
+      MPI_Startall(data_send_requests.size(), data_send_requests.data());
   }
 
-  // ----------------------------------------
-  // Step 2. Interpolate data and transfer
-  // ----------------------------------------
-  dim = V.NumDOF();
+  if(!data_recv_requests.empty())
+    MPI_Waitall(data_recv_requests.size(), data_recv_requests.data(), MPI_STATUSES_IGNORE);
+  UnpackImportData(V);
 
-  if(twinning_status == sender) { 
+  if(twinning_status == LEADER) { //the leader's interpolation uses the data just received
+    InterpolateExportData(V);
+    if(!data_send_requests.empty())
+      MPI_Startall(data_send_requests.size(), data_send_requests.data());
+  }
 
-    vector<MPI_Request> send_requests;
-    double*** v = V.GetDataPointer();
-    for(int proc=0; proc<numTwinProcs; proc++) {
+  if(!data_send_requests.empty())
+    MPI_Waitall(data_send_requests.size(), data_send_requests.data(), MPI_STATUSES_IGNORE);
+}
 
-      if(export_points[proc].size()==0)
-        continue;
+//---------------------------------------------------------------
 
-      for(int p=0; p<(int)export_points[proc].size(); p++) {
-        int i = export_points[proc][p].ijk[0]; 
-        int j = export_points[proc][p].ijk[1]; 
-        int k = export_points[proc][p].ijk[2]; 
-        for(int d=0; d<dim; d++)     
-          export_buffer[proc][dim*p+d] 
-              = MathTools::trilinear_interpolation(v[k][j][i*dim+d], v[k][j][(i+1)*dim+d], 
-                    v[k][j+1][i*dim+d], v[k][j+1][(i+1)*dim+d], v[k+1][j][i*dim+d], 
-                    v[k+1][j][(i+1)*dim+d], v[k+1][j+1][i*dim+d], v[k+1][j+1][(i+1)*dim+d],
-                    (double*)export_points[proc][p].xi);
+void
+M2CTwinMessenger::InterpolateExportData(SpaceVariable3D &V)
+{
+  int dim = exchange_dim;
+
+  double*** v = V.GetDataPointer();
+  int ii0, jj0, kk0, iimax, jjmax, kkmax;
+  coordinates->GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+  const double *v0 = &v[kk0][jj0][ii0*dim]; //the ghosted local array is contiguous
+
+  for(int proc=0; proc<(int)export_points.size(); proc++) {
+    double *buf = export_buffer[proc].data();
+    for(int p=0; p<(int)export_offsets[proc].size(); p++) {
+      const double *w = &export_weights[proc][8*p];
+      const double *vp = v0 + export_offsets[proc][p];
+      for(int d=0; d<dim; d++) {
+        double sum = 0.0;
+        for(int c=0; c<8; c++)
+          sum += w[c]*vp[corner_stride[c]+d];
+        buf[dim*p+d] = sum;
       }
-      
-      send_requests.push_back(MPI_Request());
-      MPI_Isend(export_buffer[proc].data(), dim*export_points[proc].size(), MPI_DOUBLE, proc, 
-                m2c_rank/*tag*/, joint_comm, &send_requests.back());
     }
-    MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
-    send_requests.clear();
+  }
 
-    V.RestoreDataPointerToLocalVector();
-  
-  } else { //receiver
+  V.RestoreDataPointerToLocalVector();
+}
 
-    vector<MPI_Request> recv_requests;
-    for(int proc=0; proc<numTwinProcs; proc++) {
-      if(import_nodes[proc].size()>0) {
-        recv_requests.push_back(MPI_Request());
-        MPI_Irecv(import_buffer[proc].data(), dim*import_nodes[proc].size(), MPI_DOUBLE, 
-                  proc, proc, joint_comm, &recv_requests.back()); 
-      }
-    }
-    MPI_Waitall(recv_requests.size(), recv_requests.data(), MPI_STATUSES_IGNORE);
-    recv_requests.clear();
+//---------------------------------------------------------------
 
-    double*** v = V.GetDataPointer();
-    for(int proc=0; proc<numTwinProcs; proc++) {
-      for(int p=0; p<(int)import_nodes[proc].size(); p++) {
-        Int3 &ijk(import_nodes[proc][p]);
-        for(int d=0; d<dim; d++) 
-          v[ijk[2]][ijk[1]][ijk[0]*dim+d] = import_buffer[proc][p*dim+d];
-      }
+void
+M2CTwinMessenger::UnpackImportData(SpaceVariable3D &V)
+{
+  int dim = exchange_dim;
+
+  double*** v = V.GetDataPointer();
+  for(int proc=0; proc<(int)import_nodes.size(); proc++) {
+    for(int p=0; p<(int)import_nodes[proc].size(); p++) {
+      Int3 &ijk(import_nodes[proc][p]);
+      for(int d=0; d<dim; d++) 
+        v[ijk[2]][ijk[1]][ijk[0]*dim+d] = import_buffer[proc][p*dim+d];
     }
-    V.RestoreDataPointerAndInsert();
-
   }
+  V.RestoreDataPointerAndInsert();
 }
 
 //---------------------------------------------------------------
@@ -39,6 +39,15 @@ class M2CTwinMessenger {
   std::vector<std::vector<GhostPoint> > export_points;
   GlobalMeshInfo global_mesh_twin;
 
+  //! The exchange pattern, frozen at the end of CommunicateBeforeTimeStepping (see SetupExchangePattern).
+  //! Each export point has 8 trilinear weights, and the offset of its lower-left corner in the ghosted
+  //! local array of V. The other 7 nodes are at fixed strides from it.
+  int exchange_dim; //!< number of DOFs per node (<0: pattern not set up)
+  std::vector<std::vector<double> > export_weights;
+  std::vector<std::vector<long> > export_offsets;
+  long corner_stride[8];
+  std::vector<MPI_Request> data_send_requests, data_recv_requests; //!< persistent requests
+
   //! For the ``follower''
   SpaceVariable3D *TMP; //!< dim = 1
   SpaceVariable3D *TMP3; //!< dim = 3
@@ -80,11 +89,17 @@ public:
 
 private:
 
-  //! Exchange data between M2C twins
+  //! Exchange data between M2C twins (using the persistent requests)
   void ExchangeData(SpaceVariable3D &V);
 
-  //! Interpolate and transfer
-  void InterpolateDataAndTransfer(SpaceVariable3D &V, TwinningStatus sender);
+  //! Freeze the exchange pattern: buffers, interpolation weights, and persistent requests
+  void SetupExchangePattern(SpaceVariable3D &V);
+
+  //! Interpolate V at the export points (using the precomputed weights)
+  void InterpolateExportData(SpaceVariable3D &V);
+
+  //! Copy the received data to the import nodes
+  void UnpackImportData(SpaceVariable3D &V);
 
 };
 
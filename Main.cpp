@@ -22,6 +22,7 @@
 #include <GradientCalculatorCentral.h>
 #include <IonizationOperator.h>
 #include <HyperelasticityOperator.h>
+#include <RunControl.h>
 #include <SpecialToolsDriver.h>
 #include <set>
 #include <string>
@@ -38,7 +39,6 @@ using std::to_string;
 
 int verbose;
 double domain_diagonal;
-clock_t start_time;
 MPI_Comm m2c_comm;
 
 int INACTIVE_MATERIAL_ID;
@@ -48,10 +48,9 @@ int INACTIVE_MATERIAL_ID;
  ************************************/
 int main(int argc, char* argv[])
 {
-  start_time = clock(); //for timing purpose only
-
   //! Initialize MPI 
   MPI_Init(NULL,NULL); //called together with all concurrent programs -> MPI_COMM_WORLD
+  double wall_start = MPI_Wtime(); //for timing purpose only (includes setup)
 
   //! Print header (global proc #0, assumed to be a M2C proc)
   m2c_comm = MPI_COMM_WORLD; //temporary, just for the next few lines of code
@@ -338,13 +337,24 @@ int main(int argc, char* argv[])
     }
   if(activate_heo) {
     heo = new HyperelasticityOperator(comm, dms, iod, vf, spo.GetMeshCoordinates(),
-                                      spo.GetMeshDeltaXYZ(), global_mesh, *interp, *grad,
+                                      spo.GetMeshDeltaXYZ(), global_mesh, *grad,
                                       *(spo.GetPointerToInnerGhostNodes()),
                                       *(spo.GetPointerToOuterGhostNodes()));
     spo.SetHyperelasticityOperatorPointer(heo);
     Xi = new SpaceVariable3D(comm, &(dms.ghosted1_3dof));
     heo->InitializeReferenceMap(*Xi);
   }
+
+
+  //! Setup skipping of quiescent tiles (if needed)
+  if(iod.schemes.ns.active_tile_size>0) {
+    if(lso.size()>0 || embed || laser || heo || iod.ts.local_dt == TsData::YES) {
+      print_error("*** Error: Skipping quiescent tiles cannot be used with level sets, embedded boundaries, "
+                  "lasers, hyperelasticity, or local time-stepping.\n");
+      exit_mpi();
+    }
+    spo.SetupActiveTiles();
+  }
        
 /*
   ID.StoreMeshCoordinates(spo.GetMeshCoordinates());
@@ -367,7 +377,9 @@ int main(int argc, char* argv[])
   //! Initialize time integrator
   TimeIntegratorBase *integrator = NULL;
   if(iod.ts.type == TsData::EXPLICIT) {
-    if(iod.ts.expl.type == ExplicitData::FORWARD_EULER)
+    if(iod.ts.local_dt == TsData::YES && iod.ts.convergence_tolerance<=0.0) //unsteady, local time-stepping
+      integrator = new TimeIntegratorLTS(comm, iod, dms, spo, lso, mpo, laser, embed, heo);
+    else if(iod.ts.expl.type == ExplicitData::FORWARD_EULER)
       integrator = new TimeIntegratorFE(comm, iod, dms, spo, lso, mpo, laser, embed, heo);
     else if(iod.ts.expl.type == ExplicitData::RUNGE_KUTTA_2)
       integrator = new TimeIntegratorRK2(comm, iod, dms, spo, lso, mpo, laser, embed, heo);
@@ -387,8 +399,8 @@ int main(int argc, char* argv[])
   SpaceVariable3D *LocalDt = NULL;
   bool steady_state = iod.ts.convergence_tolerance>0.0;
   if(iod.ts.local_dt == TsData::YES) {//local time-stepping
-    if(!steady_state) {
-      print_error("*** Error: Local time-stepping can be used only for steady-state computations.\n");
+    if(!steady_state && concurrent.Coupled()) {
+      print_error("*** Error: Time-accurate local time-stepping cannot be used with concurrent programs.\n");
       exit_mpi();
     }
     if(iod.ts.timestep > 0.0) {
@@ -510,8 +522,12 @@ int main(int argc, char* argv[])
   int maxIts = concurrent.GetTwinningStatus() == ConcurrentProgramsHandler::FOLLOWER ? INT_MAX 
              : iod.ts.maxIts;
 
+  //! Initialize run control (wall-clock time budget, signals, and performance report)
+  RunControl run_control(comm, iod, V, concurrent.Coupled(), wall_start);
+
   // Time-Stepping
-  while(t<tmax && time_step<maxIts && !integrator->Converged()) {// the last one is for steady-state
+  while(t<tmax && time_step<maxIts && !integrator->Converged() && // the last one is for steady-state
+        !run_control.StopRequested()) {
 
     double dtleft = dts;
 
@@ -522,6 +538,7 @@ int main(int argc, char* argv[])
 
       // Compute time step size
       spo.ComputeTimeStepSize(V, ID, dt, cfl, LocalDt); 
+      integrator->ClusterLocalTimeSteps(LocalDt, dt); //only for time-accurate local time-stepping
 
       // Modify dt and cfl, dtleft if needed
       if(concurrent.GetTimeStepSize()>0) {//concurrent solver provides a "dts"
@@ -556,10 +573,10 @@ int main(int argc, char* argv[])
       else { //unsteady
         if(dts<=dt)
           print("Step %d: t = %e, dt = %e, cfl = %.4e. Computation time: %.4e s.\n", 
-                time_step, t, dt, cfl, ((double)(clock()-start_time))/CLOCKS_PER_SEC);
+                time_step, t, dt, cfl, run_control.GetElapsedTime());
         else
           print("Step %d(%d): t = %e, dt = %e, cfl = %.4e. Computation time: %.4e s.\n", 
-                time_step, subcycle+1, t, dt, cfl, ((double)(clock()-start_time))/CLOCKS_PER_SEC);
+                time_step, subcycle+1, t, dt, cfl, run_control.GetElapsedTime());
       }
 
       //----------------------------------------------------
@@ -573,12 +590,20 @@ int main(int argc, char* argv[])
 
     } while (concurrent.Coupled() && dtleft != 0.0);
 
+    // Check wall-clock time & signals (collective). If the run is about to be stopped, outputs are written after
+    // the loop. If the time budget is almost used up, write a snapshot now, in case the job gets killed.
+    run_control.EndOfStep(time_step, t, dt, tmax, maxIts);
+    bool force_output = run_control.ForceOutputNow();
+
+    // Multi-rate transport: bring Phi and Xi (and ID) up to date before they are written to file
+    if(run_control.StopRequested() || out.IsTimeToWrite(t, dts, time_step, force_output))
+      integrator->FinishTransportWindow(V, ID, Phi, L, Xi, t, time_step);
 
     if(embed) {
       embed->ComputeForces(V, ID);
       embed->UpdateSurfacesPrevAndFPrev();
 
-      embed->OutputResults(t, dts, time_step, false/*force_write*/); //!< write displacement and nodal loads to file
+      embed->OutputResults(t, dts, time_step, force_output); //!< write displacement and nodal loads to file
     }
 
 
@@ -616,10 +641,13 @@ int main(int argc, char* argv[])
       }
     }
 
-    out.OutputSolutions(t, dts0, time_step, V, ID, Phi, L, Xi, false/*force_write*/);
+    out.OutputSolutions(t, dts0, time_step, V, ID, Phi, L, Xi, force_output);
 
   }
 
+  // Multi-rate transport: the loop may stop in the middle of a transport window
+  integrator->FinishTransportWindow(V, ID, Phi, L, Xi, t, time_step);
+
   if(concurrent.Coupled())
     concurrent.FinalExchange(&V);
 
@@ -635,7 +663,12 @@ int main(int argc, char* argv[])
   print("\033[0;32m==========================================\033[0m\n");
   print("\033[0;32m   NORMAL TERMINATION (t = %e)  \033[0m\n", t); 
   print("\033[0;32m==========================================\033[0m\n");
-  print("Total Computation Time: %f sec.\n", ((double)(clock()-start_time))/CLOCKS_PER_SEC);
+  run_control.PrintFinalSummary(time_step);
+  long n_exchanges, n_deferred, n_lazy;
+  SpaceVariable3D::GetHaloExchangeCounts(&n_exchanges, &n_deferred, &n_lazy);
+  print("Halo Exchanges (proc 0): %ld immediate, %ld deferred (%ld performed later, %ld avoided).\n",
+        n_exchanges, n_deferred, n_lazy, n_deferred - n_lazy);
+  spo.PrintResidualProfile();
   print("\n");
 
 
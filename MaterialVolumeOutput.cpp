@@ -50,6 +50,14 @@ MaterialVolumeOutput::~MaterialVolumeOutput()
 
 //-------------------------------------------------------------------------
 
+bool
+MaterialVolumeOutput::IsTimeToWrite(double time, double dt, int time_step)
+{
+  return file && isTimeToWrite(time, dt, time_step, frequency_dt, frequency, last_snapshot_time, false);
+}
+
+//-------------------------------------------------------------------------
+
 void
 MaterialVolumeOutput::WriteSolution(double time, double dt, int time_step, SpaceVariable3D& ID, 
                                     bool force_write)
@@ -33,6 +33,9 @@ public:
 
   void WriteSolution(double time, double dt, int time_step, SpaceVariable3D& ID, bool force_write);  
 
+  //! whether WriteSolution would write at this time (without force_write)
+  bool IsTimeToWrite(double time, double dt, int time_step);
+
 private:
 
   void ComputeMaterialVolumes(SpaceVariable3D& ID, double* vol);
@@ -0,0 +1,95 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include <MeshMetrics.h>
+#include <Vector3D.h>
+#include <cmath>
+
+//------------------------------------------------------------------
+
+MeshMetrics::MeshMetrics()
+{
+  for(int d=0; d<3; d++) {
+    g0[d] = gmax[d] = N[d] = 0;
+    uniform[d] = false;
+  }
+}
+
+//------------------------------------------------------------------
+
+void
+MeshMetrics::Setup(SpaceVariable3D &coordinates, SpaceVariable3D &delta_xyz)
+{
+  int i0, j0, k0;
+  coordinates.GetCornerIndices(&i0, &j0, &k0);
+  coordinates.GetGhostedCornerIndices(&g0[0], &g0[1], &g0[2], &gmax[0], &gmax[1], &gmax[2]);
+  coordinates.GetGlobalSize(&N[0], &N[1], &N[2]);
+
+  Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
+  Vec3D*** dxyz   = (Vec3D***)delta_xyz.GetDataPointer();
+
+  // Extract one "pencil" along each axis. The pencils pass through the interior corner (i0,j0,k0),
+  // so the ghost nodes they contain are all populated.
+  for(int d=0; d<3; d++) {
+    int size = gmax[d] - g0[d];
+    x[d].resize(size);
+    dx[d].resize(size);
+    for(int n=g0[d]; n<gmax[d]; n++) {
+      int i = d==0 ? n : i0;
+      int j = d==1 ? n : j0;
+      int k = d==2 ? n : k0;
+      x[d][n-g0[d]]  = coords[k][j][i][d];
+      dx[d][n-g0[d]] = dxyz[k][j][i][d];
+    }
+  }
+
+  coordinates.RestoreDataPointerToLocalVector();
+  delta_xyz.RestoreDataPointerToLocalVector();
+
+  // Central differencing coefficients (i.e. centered quadratic interpolation + differentiation)
+  for(int d=0; d<3; d++) {
+    cdc[d].assign(3*x[d].size(), 0.0);
+    for(int n=g0[d]; n<gmax[d]; n++) {
+      double *c = &cdc[d][3*(n-g0[d])];
+      bool has_left  = n-1>=g0[d];
+      bool has_right = n+1<gmax[d];
+      if(n>=0 && n<N[d] && has_left && has_right) {
+        double h0 = Coord(d,n) - Coord(d,n-1);
+        double h1 = Coord(d,n+1) - Coord(d,n);
+        double h2 = h0 + h1;
+        c[0] = -h1/(h0*h2);
+        c[1] = 1.0/h0 - 1.0/h1;
+        c[2] = h0/(h1*h2);
+      }
+      else if(n==-1 && has_right) { //one-sided (1st order)
+        double coeff = 1.0/(Coord(d,n+1) - Coord(d,n));
+        c[1] = -coeff;
+        c[2] = coeff;
+      }
+      else if(n==N[d] && has_left) { //one-sided (1st order)
+        double coeff = 1.0/(Coord(d,n) - Coord(d,n-1));
+        c[0] = -coeff;
+        c[1] = coeff;
+      }
+      //otherwise, the derivative cannot be computed locally. Coefficients are 0.
+    }
+  }
+
+  // Check for uniform spacing
+  for(int d=0; d<3; d++) {
+    uniform[d] = true;
+    double h = dx[d][0];
+    for(int n=0; n<(int)dx[d].size(); n++) {
+      if(std::fabs(dx[d][n] - h) > 1.0e-12*h ||
+         (n>0 && std::fabs(x[d][n] - x[d][n-1] - h) > 1.0e-12*h)) {
+        uniform[d] = false;
+        break;
+      }
+    }
+  }
+
+}
+
+//------------------------------------------------------------------
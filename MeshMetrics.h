@@ -0,0 +1,73 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _MESH_METRICS_H_
+#define _MESH_METRICS_H_
+
+#include <SpaceVariable.h>
+#include <vector>
+#include <cassert>
+
+/*****************************************************************************
+ * class MeshMetrics stores 1D tables of the (local, ghosted) mesh along each
+ * axis: cell-center coordinates, cell widths, and central differencing
+ * coefficients. Because the mesh is a tensor product, these tables carry all
+ * the information in the 3D fields "coordinates" and "delta_xyz", but can be
+ * accessed in stencil kernels without streaming 3D arrays through memory.
+ * For example, the area of the x-face between (i-1,j,k) and (i,j,k) is
+ * Dy(j)*Dz(k), and the volume of cell (i,j,k) is Dx(i)*Dy(j)*Dz(k).
+ * Note: The tables must be re-computed (Setup) whenever the ghost layer is
+ *       reset (See SpaceOperator::ResetGhostLayer).
+ ****************************************************************************/
+
+class MeshMetrics {
+
+  int g0[3];   //!< ghosted lower corner (i.e., ii0, jj0, kk0)
+  int gmax[3]; //!< ghosted upper corner (i.e., iimax, jjmax, kkmax)
+  int N[3];    //!< global size (i.e., NX, NY, NZ)
+
+  std::vector<double> x[3];  //!< cell centers
+  std::vector<double> dx[3]; //!< cell widths
+
+  //! central differencing coefficients: du/dx(i) = c[3i]*u(i-1) + c[3i+1]*u(i) + c[3i+2]*u(i+1).
+  //! In the ghost layer outside the physical domain, the stencil is one-sided (1st order).
+  std::vector<double> cdc[3];
+
+  bool uniform[3]; //!< whether cell widths are constant along each axis (within this subdomain)
+
+public:
+
+  MeshMetrics();
+  ~MeshMetrics() {}
+
+  //! Extract the 1D tables from the 3D mesh fields (no communication)
+  void Setup(SpaceVariable3D &coordinates, SpaceVariable3D &delta_xyz);
+
+  inline double X(int i) {return x[0][i-g0[0]];}
+  inline double Y(int j) {return x[1][j-g0[1]];}
+  inline double Z(int k) {return x[2][k-g0[2]];}
+  inline double Dx(int i) {return dx[0][i-g0[0]];}
+  inline double Dy(int j) {return dx[1][j-g0[1]];}
+  inline double Dz(int k) {return dx[2][k-g0[2]];}
+
+  //! generic version (d = 0, 1, 2)
+  inline double Coord(int d, int n) {return x[d][n-g0[d]];}
+  inline double Width(int d, int n) {return dx[d][n-g0[d]];}
+
+  //! area of the cell interfaces at i-1/2, j-1/2, and k-1/2 respectively
+  inline double FaceAreaX(int j, int k) {return Dy(j)*Dz(k);}
+  inline double FaceAreaY(int i, int k) {return Dx(i)*Dz(k);}
+  inline double FaceAreaZ(int i, int j) {return Dx(i)*Dy(j);}
+
+  inline double Volume(int i, int j, int k) {return Dx(i)*Dy(j)*Dz(k);}
+
+  //! pointer to the three central differencing coefficients at node n along axis d
+  inline const double* CentralDifferenceCoefficients(int d, int n) {return &cdc[d][3*(n-g0[d])];}
+
+  inline bool IsUniform(int d) {return uniform[d];}
+
+};
+
+#endif
@@ -508,7 +508,7 @@ MultiPhaseOperator::UpdateCellsSweptByEmbeddedSurfaces(SpaceVariable3D &V, Space
   for(auto&& ebds : *EBDS) {
     phi_ebm.push_back(ebds->Phi_ptr->GetDataPointer());
 
-    swept.push_back(*ebds->swept_ptr);
+    swept.push_back(ebds->swept_ptr->ToSet()); //a copy that can be modified
     // remove cells that are internal ghosts
     for(auto it = swept.back().begin(); it != swept.back().end();) {
       if(!ID.IsHere((*it)[0],(*it)[1],(*it)[2],false))
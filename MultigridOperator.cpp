@@ -0,0 +1,351 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include <MultigridOperator.h>
+#include <Vector5D.h>
+#include <Utils.h>
+#include <algorithm>
+
+//-------------------------------------------------------------------------
+
+MultigridOperator::MultigridOperator(MPI_Comm &comm_, IoData &iod_, DataManagers3D &dms, SpaceOperator &spo)
+                 : comm(comm_), iod(iod_)
+{
+  MultigridData &iod_mg(iod.ts.mg);
+  pre_smoothing      = iod_mg.pre_smoothing;
+  post_smoothing     = iod_mg.post_smoothing;
+  coarsest_smoothing = iod_mg.coarsest_smoothing;
+
+  if(pre_smoothing<0 || post_smoothing<0 || coarsest_smoothing<1) {
+    print_error(comm, "*** Error: Invalid number of multigrid smoothing iterations (%d, %d, %d).\n",
+                pre_smoothing, post_smoothing, coarsest_smoothing);
+    exit_mpi();
+  }
+  if(iod.eqs.materials.dataMap.size()>1) {
+    print_error(comm, "*** Error: Multigrid is currently limited to single-material problems.\n");
+    exit_mpi();
+  }
+  if(iod.schemes.ns.active_tile_size>0) {
+    print_error(comm, "*** Error: Multigrid cannot be used with active tiles (ActiveTileSize > 0).\n");
+    exit_mpi();
+  }
+
+  // Shu-Osher coefficients of the smoother (same scheme as the fine level)
+  for(int s=0; s<3; s++)
+    rk_a[s] = rk_b[s] = rk_c[s] = 0.0;
+  nstages = 1;
+  rk_a[0] = 1.0;  rk_c[0] = 1.0;
+  if(iod.ts.expl.type == ExplicitData::RUNGE_KUTTA_2) {
+    nstages = 2;
+    rk_a[1] = 0.5;  rk_b[1] = 0.5;  rk_c[1] = 0.5;
+  }
+  else if(iod.ts.expl.type == ExplicitData::RUNGE_KUTTA_3) {
+    nstages = 3;
+    rk_a[1] = 0.75;     rk_b[1] = 0.25;     rk_c[1] = 0.25;
+    rk_a[2] = 1.0/3.0;  rk_b[2] = 2.0/3.0;  rk_c[2] = 2.0/3.0;
+  }
+
+  // the fine level
+  MultigridLevel *fine = new MultigridLevel();
+  fine->dms  = &dms;
+  fine->mesh = &spo.GetGlobalMeshInfo();
+  fine->spo  = &spo;
+  fine->U    = new SpaceVariable3D(comm, &(dms.ghosted1_5dof));
+  fine->R    = new SpaceVariable3D(comm, &(dms.ghosted1_5dof));
+  levels.push_back(fine);
+
+  // coarse levels
+  for(int l=1; l<iod_mg.num_levels; l++) {
+    if(!AddCoarseLevel()) {
+      print_warning(comm, "Warning: Unable to coarsen the mesh (or its partition) further. Using %d multigrid "
+                    "levels.\n", (int)levels.size());
+      break;
+    }
+  }
+
+  print(comm, "- Multigrid (FAS) with %d levels. Coarsest mesh: %d x %d x %d cells.\n", (int)levels.size(),
+        (int)levels.back()->mesh->x_glob.size(), (int)levels.back()->mesh->y_glob.size(),
+        (int)levels.back()->mesh->z_glob.size());
+}
+
+//-------------------------------------------------------------------------
+
+MultigridOperator::~MultigridOperator()
+{
+  for(auto&& level : levels) {
+    if(level->owner) {
+      delete level->spo;
+      delete level->mesh;
+      delete level->dms;
+    }
+    delete level;
+  }
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::Destroy()
+{
+  for(auto&& level : levels) {
+    SpaceVariable3D *vars[] = {level->U, level->R, level->U0, level->Un, level->P, level->Dt};
+    for(auto&& var : vars)
+      if(var) {
+        var->Destroy();
+        delete var;
+      }
+    level->U = level->R = level->U0 = level->Un = level->P = level->Dt = NULL;
+
+    if(level->owner) {
+      level->V->Destroy();   delete level->V;
+      level->ID->Destroy();  delete level->ID;
+      level->V = level->ID = NULL;
+      level->spo->Destroy();
+      level->dms->DestroyAllDataManagers();
+    }
+  }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+MultigridOperator::CoarsenPartition(int nproc, const PetscInt *l, std::vector<PetscInt> &lc)
+{
+  lc.resize(nproc);
+  int lo = 0, hi;
+  for(int p=0; p<nproc; p++) {
+    hi = lo + l[p];
+    lc[p] = (hi+1)/2 - (lo+1)/2; //coarse cells [ceil(lo/2), ceil(hi/2))
+    if(nproc>1 && lc[p]<2) //DMDA requires the width of a subdomain to be at least the stencil width
+      return false;
+    lo = hi;
+  }
+  return true;
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::CoarsenMesh(std::vector<double> &x, std::vector<double> &dx, std::vector<double> &xc,
+                               std::vector<double> &dxc)
+{
+  int N = x.size();
+  int Nc = (N+1)/2;
+  xc.resize(Nc);
+  dxc.resize(Nc);
+  for(int I=0; I<Nc; I++) {
+    int i1 = 2*I, i2 = std::min(2*I+1, N-1);
+    double lo = x[i1] - 0.5*dx[i1], hi = x[i2] + 0.5*dx[i2];
+    xc[I]  = 0.5*(lo + hi);
+    dxc[I] = hi - lo;
+  }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+MultigridOperator::AddCoarseLevel()
+{
+  MultigridLevel &f(*levels.back());
+
+  int NX, NY, NZ, m, n, p;
+  DMDAGetInfo(f.dms->ghosted1_1dof, NULL, &NX, &NY, &NZ, &m, &n, &p, NULL, NULL, NULL, NULL, NULL, NULL);
+  if(NX<=1 && NY<=1 && NZ<=1)
+    return false;
+
+  const PetscInt *lx, *ly, *lz;
+  DMDAGetOwnershipRanges(f.dms->ghosted1_1dof, &lx, &ly, &lz);
+  std::vector<PetscInt> lxc, lyc, lzc;
+  if(!CoarsenPartition(m, lx, lxc) || !CoarsenPartition(n, ly, lyc) || !CoarsenPartition(p, lz, lzc))
+    return false;
+
+  MultigridLevel *c = new MultigridLevel();
+  c->owner = true;
+
+  c->dms = new DataManagers3D();
+  c->dms->CreateAllDataManagers(comm, (NX+1)/2, (NY+1)/2, (NZ+1)/2, m, n, p, lxc.data(), lyc.data(),
+                                lzc.data());
+
+  std::vector<double> x, y, z, dx, dy, dz;
+  CoarsenMesh(f.mesh->x_glob, f.mesh->dx_glob, x, dx);
+  CoarsenMesh(f.mesh->y_glob, f.mesh->dy_glob, y, dy);
+  CoarsenMesh(f.mesh->z_glob, f.mesh->dz_glob, z, dz);
+  c->mesh = new GlobalMeshInfo(x, y, z, dx, dy, dz);
+  c->mesh->GetSubdomainInfo(comm, *c->dms);
+
+  c->spo = new SpaceOperator(comm, *c->dms, iod, f.spo->GetVarFcn(), f.spo->GetFluxFcn(),
+                             f.spo->GetExactRiemannSolver(), *c->mesh, false);
+
+  c->V  = new SpaceVariable3D(comm, &(c->dms->ghosted1_5dof));
+  c->ID = new SpaceVariable3D(comm, &(c->dms->ghosted1_1dof));
+  c->U  = new SpaceVariable3D(comm, &(c->dms->ghosted1_5dof));
+  c->R  = new SpaceVariable3D(comm, &(c->dms->ghosted1_5dof));
+  c->U0 = new SpaceVariable3D(comm, &(c->dms->ghosted1_5dof));
+  c->Un = new SpaceVariable3D(comm, &(c->dms->ghosted1_5dof));
+  c->P  = new SpaceVariable3D(comm, &(c->dms->ghosted1_5dof));
+  c->Dt = new SpaceVariable3D(comm, &(c->dms->ghosted1_1dof));
+
+  c->ID->SetConstantValue(0.0, true); //single material
+
+  levels.push_back(c);
+  return true;
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::Cycle(SpaceVariable3D &V, SpaceVariable3D &ID)
+{
+  int nlevels = levels.size();
+  if(nlevels<2)
+    return;
+
+  MultigridLevel &fine(*levels[0]);
+  fine.V  = &V;
+  fine.ID = &ID;
+  fine.spo->ComputeResidual(V, ID, *fine.R);
+
+  // restriction and smoothing, from fine to coarse
+  for(int l=1; l<nlevels; l++) {
+    MultigridLevel &c(*levels[l]);
+    Restrict(*levels[l-1], c);
+
+    // forcing term: P = I(R_fine) - R(V0)
+    c.spo->ComputeResidual(*c.V, *c.ID, *c.R);
+    c.P->AXPlusBY(1.0, -1.0, *c.R);
+
+    Smooth(c, l==nlevels-1 ? coarsest_smoothing : pre_smoothing);
+
+    if(l<nlevels-1)
+      ComputeForcedResidual(c); //to be restricted to the next level
+  }
+
+  // prolongation of the corrections (with post-smoothing), from coarse to fine
+  for(int l=nlevels-1; l>=1; l--) {
+    Prolong(*levels[l], *levels[l-1]);
+    if(l-1>=1)
+      Smooth(*levels[l-1], post_smoothing);
+  }
+
+  fine.V = fine.ID = NULL;
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::Restrict(MultigridLevel &f, MultigridLevel &c)
+{
+  f.spo->PrimitiveToConservative(*f.V, *f.ID, *f.U);
+
+  // the residual is only computed in the interior: update the internal ghosts
+  f.R->GetDataPointer();
+  f.R->RestoreDataPointerAndInsert();
+
+  int NX, NY, NZ;
+  f.U->GetGlobalSize(&NX, &NY, &NZ);
+
+  Vec5D*** uf = (Vec5D***)f.U->GetDataPointer(); //exchanges the internal ghosts (deferred above)
+  Vec5D*** rf = (Vec5D***)f.R->GetDataPointer();
+  Vec5D*** u  = (Vec5D***)c.U->GetDataPointerInteriorOnly();
+  Vec5D*** p  = (Vec5D***)c.P->GetDataPointerInteriorOnly();
+
+  std::vector<double> &dxf(f.mesh->dx_glob), &dyf(f.mesh->dy_glob), &dzf(f.mesh->dz_glob);
+
+  int i0, j0, k0, imax, jmax, kmax;
+  c.U->GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+
+  // volume-weighted averages over the children (U and R are per unit volume)
+  double w, vol;
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++) {
+        Vec5D usum(0.0), rsum(0.0);
+        vol = 0.0;
+        for(int kk=2*k; kk<=std::min(2*k+1, NZ-1); kk++)
+          for(int jj=2*j; jj<=std::min(2*j+1, NY-1); jj++)
+            for(int ii=2*i; ii<=std::min(2*i+1, NX-1); ii++) {
+              w = dxf[ii]*dyf[jj]*dzf[kk];
+              usum += w*uf[kk][jj][ii];
+              rsum += w*rf[kk][jj][ii];
+              vol  += w;
+            }
+        u[k][j][i] = usum/vol;
+        p[k][j][i] = rsum/vol;
+      }
+
+  f.U->RestoreDataPointerToLocalVector();
+  f.R->RestoreDataPointerToLocalVector();
+  c.U->RestoreDataPointerAndMarkGhostsStale();
+  c.P->RestoreDataPointerAndMarkGhostsStale();
+
+  c.spo->ConservativeToPrimitive(*c.U, *c.ID, *c.V);
+  c.spo->ClipDensityAndPressure(*c.V, *c.ID);
+  c.spo->ApplyBoundaryConditions(*c.V);
+
+  // U0 must be consistent with V (which may have been clipped)
+  c.spo->PrimitiveToConservative(*c.V, *c.ID, *c.U0);
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::Prolong(MultigridLevel &c, MultigridLevel &f)
+{
+  // correction on the coarse level: U(V) - U0
+  c.spo->PrimitiveToConservative(*c.V, *c.ID, *c.U);
+  c.U->AXPlusBY(1.0, -1.0, *c.U0);
+
+  // piecewise-constant prolongation (f.R is used as workspace). The parent of a cell owned by this subdomain
+  // is either owned by, or in the ghost layer of, the coarse subdomain.
+  Vec5D*** du  = (Vec5D***)c.U->GetDataPointer(); //exchanges the internal ghosts
+  Vec5D*** duf = (Vec5D***)f.R->GetDataPointerInteriorOnly();
+
+  int i0, j0, k0, imax, jmax, kmax;
+  f.R->GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++)
+        duf[k][j][i] = du[k/2][j/2][i/2];
+
+  c.U->RestoreDataPointerToLocalVector();
+  f.R->RestoreDataPointerAndMarkGhostsStale();
+
+  // U = U + dU, V = V(U), clip (fused)
+  f.spo->PrimitiveToConservative(*f.V, *f.ID, *f.U);
+  f.spo->UpdateStageState(0.0, *f.U, 1.0, *f.U, 1.0, *f.R, NULL, *f.ID, *f.V);
+  f.spo->ApplyBoundaryConditions(*f.V);
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::ComputeForcedResidual(MultigridLevel &c)
+{
+  c.spo->ComputeResidual(*c.V, *c.ID, *c.R);
+  c.R->AXPlusBY(1.0, 1.0, *c.P);
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultigridOperator::Smooth(MultigridLevel &c, int iterations)
+{
+  double dt, cfl;
+  for(int iter=0; iter<iterations; iter++) {
+    c.spo->ComputeLocalTimeStepSizes(*c.V, *c.ID, dt, cfl, *c.Dt);
+    c.spo->PrimitiveToConservative(*c.V, *c.ID, *c.Un);
+
+    // low-storage: the intermediate state overwrites V (R is computed before each update)
+    for(int s=0; s<nstages; s++) {
+      ComputeForcedResidual(c);
+      c.spo->UpdateStageState(rk_a[s], *c.Un, rk_b[s], *c.U, rk_c[s], *c.R, c.Dt, *c.ID, *c.V);
+      c.spo->ApplyBoundaryConditions(*c.V);
+    }
+  }
+}
+
+//-------------------------------------------------------------------------
+
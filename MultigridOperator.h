@@ -0,0 +1,102 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _MULTIGRID_OPERATOR_H_
+#define _MULTIGRID_OPERATOR_H_
+
+#include <SpaceOperator.h>
+#include <vector>
+
+/*****************************************************************************
+ * class MultigridOperator accelerates steady-state computations using the
+ * nonlinear multigrid method (Full Approximation Scheme, FAS). Each coarse
+ * level is obtained by agglomerating 2x2x2 cells of the next finer level (if
+ * the number of cells is odd, the last one is not merged), and has its own
+ * DataManagers3D, GlobalMeshInfo, and SpaceOperator. So, the N-S residual is
+ * computed by the same code on all the levels. A V-cycle is applied after each
+ * iteration (time step) on the fine level, which serves as the pre-smoother:
+ *   (1) Restrict U (volume-weighted average) and R to the coarse level, and
+ *       compute the forcing term P = I(R_fine) - R_coarse(I(U_fine)).
+ *   (2) Apply a few Runge-Kutta iterations with local time-stepping to the
+ *       coarse-level system dU/dt = R(U) + P.
+ *   (3) Repeat (1) and (2) on coarser levels. Then, prolong the corrections
+ *       (piecewise constant) level by level, with post-smoothing.
+ * Note:
+ *   (1) Coarse cell I is owned by the core that owns fine cell 2I (in each
+ *       direction). So, restriction and prolongation only need the ghost
+ *       layer. Coarsening stops if a subdomain becomes too thin.
+ *   (2) The coarse-level operators are inviscid. Viscosity and heat diffusion
+ *       only enter through the forcing term, which does not affect the
+ *       converged solution.
+ *   (3) Currently limited to a single material, without level sets, embedded
+ *       boundaries, laser, hyperelasticity, or active tiles.
+ ****************************************************************************/
+
+class MultigridOperator {
+
+  //! a level of the grid hierarchy. Level 0 refers to the fine-level operator and state (not owned).
+  struct MultigridLevel {
+    DataManagers3D  *dms;
+    GlobalMeshInfo  *mesh;
+    SpaceOperator   *spo;
+    bool            owner; //!< whether dms, mesh, and spo are owned by this level
+
+    SpaceVariable3D *V, *ID; //!< state
+    SpaceVariable3D *U;      //!< conservative state (workspace)
+    SpaceVariable3D *R;      //!< residual (workspace)
+    SpaceVariable3D *U0, *Un, *P, *Dt; //!< coarse levels: restricted state, RK state, forcing term, local dt
+
+    MultigridLevel() : dms(NULL), mesh(NULL), spo(NULL), owner(false), V(NULL), ID(NULL), U(NULL), R(NULL),
+                       U0(NULL), Un(NULL), P(NULL), Dt(NULL) {}
+  };
+
+  MPI_Comm &comm;
+  IoData &iod;
+
+  std::vector<MultigridLevel*> levels;
+
+  int pre_smoothing, post_smoothing, coarsest_smoothing;
+
+  //! Runge-Kutta smoother (Shu-Osher form): U = a*Un + b*U + c*dt_loc*(R+P) in each stage
+  int nstages;
+  double rk_a[3], rk_b[3], rk_c[3];
+
+public:
+
+  MultigridOperator(MPI_Comm &comm_, IoData &iod_, DataManagers3D &dms, SpaceOperator &spo);
+  ~MultigridOperator();
+
+  void Destroy();
+
+  //! Applies one V-cycle (FAS) to the fine-level state V (which is updated, with boundary conditions applied)
+  void Cycle(SpaceVariable3D &V, SpaceVariable3D &ID);
+
+  int NumberOfLevels() {return levels.size();}
+
+private:
+
+  //! creates the next coarse level. Returns false if the last level cannot be coarsened
+  bool AddCoarseLevel();
+
+  //! coarse partition in one direction (see Note (1) above); returns false if it is too thin
+  bool CoarsenPartition(int nproc, const PetscInt *l, std::vector<PetscInt> &lc);
+
+  void CoarsenMesh(std::vector<double> &x, std::vector<double> &dx, std::vector<double> &xc,
+                   std::vector<double> &dxc);
+
+  //! f --> c: sets the state (V, U0) and the restricted residual (stored in P) of the coarse level
+  void Restrict(MultigridLevel &f, MultigridLevel &c);
+
+  //! c --> f: adds the coarse-level correction to the state of the fine level
+  void Prolong(MultigridLevel &c, MultigridLevel &f);
+
+  //! R = R(V) + P
+  void ComputeForcedResidual(MultigridLevel &c);
+
+  void Smooth(MultigridLevel &c, int iterations);
+
+};
+
+#endif
@@ -0,0 +1,151 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _NODE_SET_H_
+#define _NODE_SET_H_
+
+#include<Vector3D.h>
+#include<vector>
+#include<set>
+#include<algorithm>
+#include<cassert>
+
+/*****************************************************************************
+ * class NodeSet stores a set of nodes (i,j,k) within a (ghosted) subdomain.
+ * It replaces std::set<Int3> where the set is rebuilt frequently and queried
+ * inside loops: membership is tracked by a dense byte field over the box
+ * (O(1) query), and the members are stored in a flat vector (for iteration).
+ * Set operations (union, difference) are linear scans.
+ * Note:
+ *   (1) Nodes outside the box are never members (and cannot be inserted).
+ *   (2) "erase" only clears the flag; the vector is compacted by calling
+ *       "Compact". So, nodes can be erased inside a loop over the set (the
+ *       loop still visits them). But a new iteration (begin, GetNodes) can
+ *       only start after Compact has been called (asserted).
+ *   (3) Iteration follows the order of insertion. "Sort" gives the same
+ *       order as std::set<Int3>.
+ ****************************************************************************/
+
+class NodeSet {
+
+  int i0, j0, k0; //!< lower corner of the box
+  int nx, ny, nz; //!< size of the box
+  std::vector<unsigned char> flag; //!< 1: member, 0: not a member
+  std::vector<Int3> nodes;
+  int count; //!< number of members (can be smaller than nodes.size() before compaction)
+
+public:
+
+  NodeSet() : i0(0), j0(0), k0(0), nx(0), ny(0), nz(0), count(0) {}
+  ~NodeSet() {}
+
+  //! the box is [ii0, iimax) x [jj0, jjmax) x [kk0, kkmax), usually the ghosted subdomain
+  void Setup(int ii0, int jj0, int kk0, int iimax, int jjmax, int kkmax) {
+    i0 = ii0;  j0 = jj0;  k0 = kk0;
+    nx = iimax - ii0;  ny = jjmax - jj0;  nz = kkmax - kk0;
+    flag.assign((size_t)nx*ny*nz, 0);
+    nodes.clear();
+    count = 0;
+  }
+
+  inline bool Contains(int i, int j, int k) const {
+    if(i<i0 || i>=i0+nx || j<j0 || j>=j0+ny || k<k0 || k>=k0+nz)
+      return false;
+    return flag[Index(i,j,k)];
+  }
+  inline bool Contains(const Int3 &ijk) const {return Contains(ijk[0], ijk[1], ijk[2]);}
+
+  //! returns true if ijk is a new member
+  inline bool insert(const Int3 &ijk) {
+    assert(ijk[0]>=i0 && ijk[0]<i0+nx && ijk[1]>=j0 && ijk[1]<j0+ny && ijk[2]>=k0 && ijk[2]<k0+nz);
+    unsigned char &f(flag[Index(ijk[0], ijk[1], ijk[2])]);
+    if(f)
+      return false;
+    f = 1;
+    nodes.push_back(ijk);
+    count++;
+    return true;
+  }
+
+  //! clears the flag of ijk. (Call "Compact" to remove it from the vector.)
+  inline bool erase(const Int3 &ijk) {
+    if(!Contains(ijk))
+      return false;
+    flag[Index(ijk[0], ijk[1], ijk[2])] = 0;
+    count--;
+    return true;
+  }
+
+  //! removes erased nodes (and duplicates of re-inserted ones) from the vector, preserving the order
+  void Compact() {
+    if(count == (int)nodes.size())
+      return;
+    int n = 0;
+    for(auto&& ijk : nodes) {
+      unsigned char &f(flag[Index(ijk[0], ijk[1], ijk[2])]);
+      if(f==1) {
+        f = 2; //kept
+        nodes[n++] = ijk;
+      }
+    }
+    nodes.resize(n);
+    for(auto&& ijk : nodes)
+      flag[Index(ijk[0], ijk[1], ijk[2])] = 1;
+  }
+
+  //! O(size), not O(box)
+  void clear() {
+    for(auto&& ijk : nodes)
+      flag[Index(ijk[0], ijk[1], ijk[2])] = 0;
+    nodes.clear();
+    count = 0;
+  }
+
+  inline int size() const {return count;}
+  inline bool empty() const {return count==0;}
+
+  //! same order as std::set<Int3>
+  void Sort() {
+    Compact();
+    std::sort(nodes.begin(), nodes.end());
+  }
+
+  //! this = this U other (both must have the same box)
+  void Union(const NodeSet &other) {
+    for(auto&& ijk : other.nodes)
+      if(other.flag[other.Index(ijk[0], ijk[1], ijk[2])])
+        insert(ijk);
+  }
+
+  //! this = this \ other
+  void Difference(const NodeSet &other) {
+    for(auto&& ijk : nodes)
+      if(other.Contains(ijk))
+        erase(ijk);
+    Compact();
+  }
+
+  std::vector<Int3>::const_iterator begin() const {assert(count == (int)nodes.size()); return nodes.begin();}
+  std::vector<Int3>::const_iterator end() const {return nodes.end();}
+
+  //! the members (must be compacted)
+  const std::vector<Int3>& GetNodes() const {assert(count == (int)nodes.size()); return nodes;}
+
+  //! adapter (for code that still works with std::set)
+  std::set<Int3> ToSet() const {
+    std::set<Int3> s;
+    for(auto&& ijk : nodes)
+      if(flag[Index(ijk[0], ijk[1], ijk[2])])
+        s.insert(ijk);
+    return s;
+  }
+
+private:
+
+  inline size_t Index(int i, int j, int k) const {return ((size_t)(k-k0)*ny + (j-j0))*nx + (i-i0);}
+
+};
+
+#endif
@@ -0,0 +1,140 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _NODE_SHARED_VECTOR_H_
+#define _NODE_SHARED_VECTOR_H_
+
+#include <mpi.h>
+#include <vector>
+#include <cstring>
+#include <cassert>
+
+/*****************************************************************************
+ * class NodeSharedVector is a minimal vector for global, read-only data that
+ * is identical on all the processor cores (e.g., the connectivities of an
+ * embedded surface). It starts as an ordinary private array. After the data
+ * is complete, "MoveToSharedMemory" stores ONE copy per compute node in an
+ * MPI-3 shared-memory window (MPI_Comm_split_type + MPI_Win_allocate_shared)
+ * and releases the private copies.
+ * Note:
+ *   (1) MoveToSharedMemory and Destroy are collective over "comm". They must
+ *       be called by all the cores, in the same order for all the vectors.
+ *   (2) Once shared, the vector cannot be resized, and should not be written
+ *       (except collectively, by the root of each node, followed by Sync).
+ *   (3) A copy of a shared vector refers to the same window, but does not own
+ *       it. Only the original can Destroy it.
+ *   (4) If each node has only one core, the data stays private.
+ ****************************************************************************/
+
+template<typename T>
+class NodeSharedVector {
+
+  std::vector<T> local; //!< private storage (before MoveToSharedMemory)
+
+  T *shared_ptr; //!< the shared segment (NULL if private)
+  size_t shared_size;
+  bool owner; //!< whether this object owns the window
+  MPI_Win win;
+  MPI_Comm node_comm;
+
+public:
+
+  NodeSharedVector() : shared_ptr(NULL), shared_size(0), owner(false),
+                       win(MPI_WIN_NULL), node_comm(MPI_COMM_NULL) {}
+  NodeSharedVector(const NodeSharedVector &other) : local(other.local), shared_ptr(other.shared_ptr),
+                       shared_size(other.shared_size), owner(false), win(other.win), node_comm(other.node_comm) {}
+  NodeSharedVector& operator=(const NodeSharedVector &other) {
+    if(this != &other) {
+      assert(!owner); //would lose the window
+      local = other.local;
+      shared_ptr = other.shared_ptr;  shared_size = other.shared_size;
+      owner = false;
+      win = other.win;  node_comm = other.node_comm;
+    }
+    return *this;
+  }
+  ~NodeSharedVector() {}
+
+  inline bool IsShared() const {return shared_ptr != NULL;}
+
+  inline size_t size() const {return shared_ptr ? shared_size : local.size();}
+  inline bool empty() const {return size() == 0;}
+
+  inline T* data() {return shared_ptr ? shared_ptr : local.data();}
+  inline const T* data() const {return shared_ptr ? shared_ptr : local.data();}
+
+  inline T& operator[](size_t i) {return data()[i];}
+  inline const T& operator[](size_t i) const {return data()[i];}
+
+  inline T* begin() {return data();}
+  inline T* end() {return data() + size();}
+  inline const T* begin() const {return data();}
+  inline const T* end() const {return data() + size();}
+
+  void resize(size_t n) {assert(!shared_ptr); local.resize(n);}
+  void assign(size_t n, const T &val) {assert(!shared_ptr); local.assign(n, val);}
+  void clear() {assert(!owner); shared_ptr = NULL; shared_size = 0; local.clear();}
+
+  //! collective. Must be called with identical contents on all the cores.
+  void MoveToSharedMemory(MPI_Comm &comm) {
+    assert(!shared_ptr);
+
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int node_rank, node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    if(node_size == 1 || local.empty()) { //nothing to gain
+      MPI_Comm_free(&node_comm);
+      node_comm = MPI_COMM_NULL;
+      return;
+    }
+
+    // the root of each node allocates the entire segment; the others attach to it
+    MPI_Aint bytes = node_rank==0 ? (MPI_Aint)(local.size()*sizeof(T)) : 0;
+    T *base = NULL;
+    MPI_Win_allocate_shared(bytes, sizeof(T), MPI_INFO_NULL, node_comm, &base, &win);
+    if(node_rank != 0) {
+      MPI_Aint root_bytes;
+      int disp_unit;
+      MPI_Win_shared_query(win, 0, &root_bytes, &disp_unit, &base);
+    }
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win); //passive-target epoch, needed by MPI_Win_sync
+
+    if(node_rank == 0)
+      memcpy(base, local.data(), local.size()*sizeof(T));
+    Sync();
+
+    shared_ptr  = base;
+    shared_size = local.size();
+    owner       = true;
+    std::vector<T>().swap(local); //free the private copy
+  }
+
+  //! collective (on each node). Makes updates by the node root visible to the other cores.
+  void Sync() {
+    if(win == MPI_WIN_NULL)
+      return;
+    MPI_Win_sync(win);
+    MPI_Barrier(node_comm);
+    MPI_Win_sync(win);
+  }
+
+  //! collective. Frees the window (no-op for private vectors and copies).
+  void Destroy() {
+    if(owner) {
+      MPI_Win_unlock_all(win);
+      MPI_Win_free(&win);
+      MPI_Comm_free(&node_comm);
+      owner = false;
+    }
+    win = MPI_WIN_NULL;
+    node_comm = MPI_COMM_NULL;
+    shared_ptr = NULL;
+    shared_size = 0;
+  }
+
+};
+
+#endif
@@ -39,6 +39,28 @@ NonIdealSahaEquationSolver::~NonIdealSahaEquationSolver()
 
 //--------------------------------------------------------------------------
 
+void
+NonIdealSahaEquationSolver::SolveBatch(vector<int>& points, double* v, double* zav, double* nh, double* ne,
+                                       vector<int>& species, int stride, double* alpha,
+                                       [[maybe_unused]] bool warm_start)
+{
+  int nSpecies = species.size();
+  map<int, vector<double> > alpha_rj;
+  for(auto&& j : species)
+    alpha_rj[j] = vector<double>(stride, 0.0);
+
+  for(auto&& b : points) {
+    Solve(v + 5*b, zav[b], nh[b], ne[b], alpha_rj);
+    for(int s=0; s<nSpecies; s++) {
+      vector<double> &alpha_s(alpha_rj[species[s]]);
+      for(int r=0; r<stride; r++)
+        alpha[(b*nSpecies+s)*stride + r] = alpha_s[r];
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+
 double 
 NonIdealSahaEquationSolver::ComputeDeltaI(int r, [[maybe_unused]] int j, double T, double nh, double zav,
                                           double one_over_lambD)
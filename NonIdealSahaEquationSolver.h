@@ -36,6 +36,10 @@ public:
   void Solve(double* v, double& zav, double& nh, double& ne, std::map<int, std::vector<double> >& alpha_rj,
              double* lambD = NULL);
 
+  //! point-by-point (no warm start)
+  void SolveBatch(std::vector<int>& points, double* v, double* zav, double* nh, double* ne,
+                  std::vector<int>& species, int stride, double* alpha, bool warm_start = false);
+
 protected:
 
   // computes the depression of ionization energy, for a given Debye length lambD and temperature T
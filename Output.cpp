@@ -144,6 +144,30 @@ void Output::OutputSolutions(double time, double dt, int time_step, SpaceVariabl
 }
 //--------------------------------------------------------------------------
 
+bool Output::IsTimeToWrite(double time, double dt, int time_step, bool force_write)
+{
+  if(force_write)
+    return true;
+
+  bool yes = isTimeToWrite(time, dt, time_step, iod.output.frequency_dt, iod.output.frequency,
+                           last_snapshot_time, false);
+
+  yes = yes || probe_output.IsTimeToWrite(time, dt, time_step);
+
+  for(int i=0; i<(int)line_outputs.size(); i++)
+    yes = yes || line_outputs[i]->IsTimeToWrite(time, dt, time_step);
+
+  for(auto&& plane : plane_outputs)
+    yes = yes || plane->IsTimeToWrite(time, dt, time_step);
+
+  yes = yes || matvol_output.IsTimeToWrite(time, dt, time_step);
+
+  //terminal visualization may involve a collective operation. Always call it.
+  return terminal.IsTimeToPrint(time, dt, time_step) || yes;
+}
+
+//--------------------------------------------------------------------------
+
 void Output::WriteSolutionSnapshot(double time, [[maybe_unused]] int time_step, SpaceVariable3D &V, 
                                    SpaceVariable3D &ID, std::vector<SpaceVariable3D*> &Phi,
                                    SpaceVariable3D *L, SpaceVariable3D *Xi)
@@ -61,6 +61,9 @@ public:
                        SpaceVariable3D *Xi/*ref map for hyperelasticity*/,
                        bool force_write);
 
+  //! whether OutputSolutions would write anything (to any file or the terminal) at this time. Collective.
+  bool IsTimeToWrite(double time, double dt, int time_step, bool force_write);
+
   void FinalizeOutput();
 
 private:
@@ -469,6 +469,14 @@ PlaneOutput::InitializeOutput(SpaceVariable3D &coordinates)
 
 //-------------------------------------------------------------------------
 
+bool
+PlaneOutput::IsTimeToWrite(double time, double dt, int time_step)
+{
+  return isTimeToWrite(time, dt, time_step, frequency_dt, frequency, last_snapshot_time, false);
+}
+
+//-------------------------------------------------------------------------
+
 void
 PlaneOutput::WriteSolutionOnPlane(double time, double dt, int time_step, SpaceVariable3D &V,
                                   SpaceVariable3D &ID, std::vector<SpaceVariable3D*> &Phi,
@@ -70,6 +70,9 @@ public:
                             SpaceVariable3D &ID, std::vector<SpaceVariable3D*> &Phi, 
                             SpaceVariable3D* L, bool force_write);
 
+  //! whether WriteSolutionOnPlane would write at this time (without force_write)
+  bool IsTimeToWrite(double time, double dt, int time_step);
+
 private:
 
   void GetScalarSolutionAndWrite(double time, double*** v, int dim, int p, std::string& fname);
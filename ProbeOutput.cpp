@@ -337,6 +337,14 @@ ProbeOutput::SetupInterpolation(SpaceVariable3D &coordinates)
 
 //-------------------------------------------------------------------------
 
+bool
+ProbeOutput::IsTimeToWrite(double time, double dt, int time_step)
+{
+  return numNodes>0 && isTimeToWrite(time, dt, time_step, frequency_dt, frequency, last_snapshot_time, false);
+}
+
+//-------------------------------------------------------------------------
+
 void 
 ProbeOutput::WriteAllSolutionsAlongLine(double time, double dt, int time_step, SpaceVariable3D &V, SpaceVariable3D &ID,
                                         std::vector<SpaceVariable3D*> &Phi, SpaceVariable3D *L, bool force_write)
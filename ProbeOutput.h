@@ -63,6 +63,9 @@ public:
            std::vector<SpaceVariable3D*> &Phi, SpaceVariable3D* L /* laser radiance*/,
            bool force_write);
 
+  //! whether WriteSolutionAtProbes / WriteAllSolutionsAlongLine would write at this time (without force_write)
+  bool IsTimeToWrite(double time, double dt, int time_step);
+
 public:
   //! Utililty functions
   
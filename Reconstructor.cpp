@@ -23,7 +23,7 @@ Reconstructor::Reconstructor(MPI_Comm &comm_, DataManagers3D &dm_all_, Reconstru
                      CoeffK(comm_, &(dm_all_.ghosted1_3dof)),
                      U(comm_, &(dm_all_.ghosted1_5dof)),
                      ghost_nodes_inner(NULL), ghost_nodes_outer(NULL),
-                     FixedByUser(NULL)
+                     FixedByUser(NULL), tiles(NULL)
 {
   if(iod_rec.varType != ReconstructionData::PRIMITIVE && (!varFcn || !fluxFcn)) {
     print_error(comm, "*** Error: Reconstructor needs to know VarFcn and FluxFcn. (Software bug)\n");
@@ -430,6 +430,12 @@ void Reconstructor::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Vl, SpaceVa
         if(sel && do_nothing_if_not_selected && !sel[k][j][i])
           continue;
 
+        //---------------------------
+        // If the cell and its neighbors are quiescent, skip (see ActiveTiles)
+        //---------------------------
+        if(tiles && !tiles->NeedsReconstruction(i,j,k))
+          continue;
+
         //---------------------------
         // If node is 'fixed', trivial (const. rec.)
         //---------------------------
@@ -10,6 +10,7 @@
 #include <FluxFcnBase.h>
 #include <GhostPoint.h>
 #include <EmbeddedBoundaryDataSet.h>
+#include <ActiveTiles.h>
 using std::min;
 using std::max;
 
@@ -56,6 +57,9 @@ class Reconstructor
   /** Another internal variable for var. conversion*/
   SpaceVariable3D U;
 
+  /** Quiescent tiles (optional): cells that are not needed are not reconstructed */
+  ActiveTiles* tiles;
+
 public:
   Reconstructor(MPI_Comm &comm_, DataManagers3D &dm_all_, ReconstructionData &iod_rec_, 
                 SpaceVariable3D &coordinates_, SpaceVariable3D &delta_xyz_, 
@@ -65,6 +69,8 @@ public:
 
   void Setup(vector<GhostPoint>* inner, vector<GhostPoint>* outer); //!< compute AB and K
 
+  void SetActiveTiles(ActiveTiles* tiles_) {tiles = tiles_;}
+
   /** Linear reconstruction in 3D 
     * The input and output variables are assumed to be primitive variables. If IoData specifies a
     * different variable to be reconstructed (e.g., primitive or characterstic), a conversion is
@@ -0,0 +1,159 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include <RunControl.h>
+#include <Utils.h>
+#include <cfloat>
+#include <cmath>
+
+volatile sig_atomic_t RunControl::signal_received = 0;
+
+//-------------------------------------------------------------------------
+
+RunControl::RunControl(MPI_Comm &comm_, IoData &iod, SpaceVariable3D &V, bool coupled, double wall_start)
+          : comm(comm_), iod_ts(iod.ts)
+{
+  wall0 = wall_start;
+  loop_wall0 = MPI_Wtime();
+  last_wall = loop_wall0; //the first step does not include setup
+  ewma_step = -1.0;
+  ewma_weight = 0.2;
+
+  limit = iod_ts.wallclock_limit;
+  if(limit>0.0 && coupled) {
+    print_warning("Warning: Wall-clock time limit is ignored when coupled with another solver.\n");
+    limit = -1.0;
+  }
+  reserve = iod_ts.wallclock_reserve>=0.0 ? iod_ts.wallclock_reserve : 0.05*std::max(limit,0.0);
+  if(limit>0.0 && reserve>=limit) {
+    print_error("*** Error: Wall-clock time reserved for final outputs (%e s) exceeds the limit (%e s).\n",
+                reserve, limit);
+    exit_mpi();
+  }
+
+  int NX, NY, NZ;
+  V.GetGlobalSize(&NX, &NY, &NZ);
+  ncells = (double)NX*(double)NY*(double)NZ;
+
+  last_report_step = 0;
+  last_report_wall = last_wall;
+
+  stop = false;
+  deadline_near = false;
+  output_forced = false;
+
+  // Install signal handlers. (Coupled runs are stopped by the other solver.)
+  if(!coupled) {
+    struct sigaction sa;
+    sa.sa_handler = SignalHandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART; //do not interrupt MPI calls
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGUSR1, &sa, NULL);
+  }
+}
+
+//-------------------------------------------------------------------------
+
+void
+RunControl::SignalHandler(int signum)
+{
+  if(signal_received) { //second signal: give up on a clean exit
+    signal(signum, SIG_DFL);
+    raise(signum);
+    return;
+  }
+  signal_received = signum;
+}
+
+//-------------------------------------------------------------------------
+
+double
+RunControl::GetElapsedTime()
+{
+  return MPI_Wtime() - wall0;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+RunControl::EndOfStep(int time_step, double t, double dt, double tmax, int maxIts)
+{
+  double now = MPI_Wtime();
+  double step_time = now - last_wall;
+  last_wall = now;
+
+  // All the processor cores must make the same decision: use the max over all the cores
+  double buf[3] = {(double)signal_received, now - wall0, step_time};
+  MPI_Allreduce(MPI_IN_PLACE, buf, 3, MPI_DOUBLE, MPI_MAX, comm);
+  int signum = (int)buf[0];
+  double elapsed = buf[1];
+  step_time = buf[2];
+
+  ewma_step = ewma_step<0.0 ? step_time : ewma_weight*step_time + (1.0-ewma_weight)*ewma_step;
+
+  // predicted number of remaining steps
+  double remaining_steps = (double)(maxIts - time_step);
+  if(dt>0.0)
+    remaining_steps = std::min(remaining_steps, std::ceil((tmax - t)/dt));
+
+  if(signum) {
+    print("\n\033[0;35m- Received signal %d. Stopping after step %d (t = %e).\033[0m\n", signum,
+          time_step, t);
+    stop = true;
+  }
+  else if(limit>0.0) {
+    double time_left = limit - reserve - elapsed;
+    if(time_left < 1.5*ewma_step && remaining_steps>1) {
+      print("\n\033[0;35m- Wall-clock time limit (%e s) is about to be reached. Stopping after step %d "
+            "(t = %e).\033[0m\n", limit, time_step, t);
+      stop = true;
+    }
+    else if(time_left < 0.1*limit)
+      deadline_near = true;
+  }
+
+  if(iod_ts.perf_report_frequency>0 && time_step - last_report_step >= iod_ts.perf_report_frequency) {
+    double throughput = ncells*(time_step - last_report_step)/std::max(now - last_report_wall, DBL_MIN);
+    double eta = remaining_steps*ewma_step;
+    if(eta < 1.0e12)
+      print("- Performance: %.4e cell-steps/s, %.4e s/step (EWMA). Predicted time to finish: %.4e s.\n",
+            throughput, ewma_step, eta);
+    else
+      print("- Performance: %.4e cell-steps/s, %.4e s/step (EWMA).\n", throughput, ewma_step);
+    last_report_step = time_step;
+    last_report_wall = now;
+  }
+
+  return stop;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+RunControl::ForceOutputNow()
+{
+  if(deadline_near && !output_forced && !stop) {
+    output_forced = true;
+    return true;
+  }
+  return false;
+}
+
+//-------------------------------------------------------------------------
+
+void
+RunControl::PrintFinalSummary(int time_step)
+{
+  double now = MPI_Wtime();
+  double elapsed[2] = {now - wall0, now - loop_wall0}; //total, time-stepping
+  MPI_Allreduce(MPI_IN_PLACE, elapsed, 2, MPI_DOUBLE, MPI_MAX, comm);
+  print("Total Computation Time: %f sec (wall-clock, including setup).\n", elapsed[0]);
+  if(time_step>0 && elapsed[1]>0.0)
+    print("Average Throughput: %.4e cell-steps/s (time-stepping: %f sec).\n", ncells*time_step/elapsed[1],
+          elapsed[1]);
+}
+
+//-------------------------------------------------------------------------
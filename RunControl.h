@@ -0,0 +1,80 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _RUN_CONTROL_H_
+#define _RUN_CONTROL_H_
+
+#include <IoData.h>
+#include <SpaceVariable.h>
+#include <mpi.h>
+#include <csignal>
+
+/*****************************************************************************
+ * class RunControl tracks the wall-clock time of the simulation, and decides
+ * whether the time-stepping loop should stop before reaching MaxTime or
+ * MaxIts. A stop is requested when
+ *   (1) the wall-clock time budget ("WallClockTimeLimit") is about to be
+ *       exhausted, based on an exponentially weighted moving average (EWMA)
+ *       of the wall time per step, or
+ *   (2) the process receives SIGTERM or SIGUSR1 (sent by most job schedulers
+ *       before a job is killed).
+ * In both cases, the current step is completed, and the code exits through
+ * the normal termination path (i.e. final outputs are written). The decision
+ * is made collectively, so all the processor cores stop at the same step.
+ * Also, every "PerformanceReportFrequency" steps, this class prints the
+ * throughput (cells*steps per second) and the predicted time to finish.
+ ****************************************************************************/
+
+class RunControl {
+
+  MPI_Comm &comm;
+  TsData &iod_ts;
+
+  double wall0; //!< wall-clock time at the start of the program (i.e. including setup)
+  double loop_wall0; //!< wall-clock time at construction (i.e. beginning of time-stepping)
+  double last_wall; //!< wall-clock time at the end of the previous step
+  double ewma_step; //!< EWMA of the wall time per step (<0: not available yet)
+  double ewma_weight; //!< weight of the most recent step
+
+  double limit; //!< wall time budget (<=0: no limit)
+  double reserve; //!< time reserved for the final outputs
+
+  double ncells; //!< number of cells in the mesh, from the DMDA (for throughput)
+
+  int last_report_step;
+  double last_report_wall;
+
+  bool stop; //!< whether the time-stepping loop should stop
+  bool deadline_near; //!< whether the budget is almost used up
+  bool output_forced; //!< whether a snapshot has been forced before the deadline
+
+  static volatile sig_atomic_t signal_received;
+
+public:
+
+  //! V: any variable on the N-S mesh (for the number of cells); wall_start: MPI_Wtime() at startup
+  RunControl(MPI_Comm &comm_, IoData &iod, SpaceVariable3D &V, bool coupled, double wall_start);
+  ~RunControl() {}
+
+  //! wall-clock time since the beginning of the simulation (in seconds)
+  double GetElapsedTime();
+
+  //! to be called at the end of each time step (collective). Returns true if the loop should stop.
+  bool EndOfStep(int time_step, double t, double dt, double tmax, int maxIts);
+
+  bool StopRequested() {return stop;}
+
+  //! returns true ONCE when the budget is almost used up, so the caller can force an extra snapshot.
+  bool ForceOutputNow();
+
+  void PrintFinalSummary(int time_step);
+
+private:
+
+  static void SignalHandler(int signum);
+
+};
+
+#endif
@@ -121,36 +121,144 @@ SahaEquationSolver::Solve(double* v, double& zav, double& nh, double& ne,
   if(T<=Tmin) { //no ionization
     zav = 0.0;
     ne = 0.0;
-    for(auto it = alpha_rj.begin(); it != alpha_rj.end(); it++) {
-      vector<double> &alpha = it->second;
-      for(int r=0; r<(int)alpha.size(); r++)
-        alpha[r] = (r==0) ? elem[it->first].molar_fraction : 0.0;
-    }
+    for(auto it = alpha_rj.begin(); it != alpha_rj.end(); it++)
+      SetNeutralMolarFractions(it->first, it->second.data(), it->second.size());
     return;
   }
 
   // ------------------------------
   // Step 1: Solve for Zav 
   // ------------------------------
-  ZavEquation fun(kb, T, nh, me, h, elem);
+  ZavEquation fun(kb, T, nh, me, h, elem, fprod_buffer);
+
+  zav = SolveZavEquation(fun, -1.0, v[4], T);
+
+  if(!(zav>0)) {
+    zav = 0.0;
+    ne = 0.0;
+    for(auto it = alpha_rj.begin(); it != alpha_rj.end(); it++)
+      SetNeutralMolarFractions(it->first, it->second.data(), it->second.size());
+    return;
+  }
+
+  //post-processing.
+  ne = zav*nh;
+
+  for(auto it = alpha_rj.begin(); it != alpha_rj.end(); it++)
+    ComputeMolarFractions(fun, zav, it->first, it->second.data(), it->second.size());
+
+  //lambD is not calculated in the case of ideal Saha
+}
+
+//--------------------------------------------------------------------------
+
+void
+SahaEquationSolver::SolveBatch(vector<int>& points, double* v, double* zav, double* nh, double* ne,
+                               vector<int>& species, int stride, double* alpha, bool warm_start)
+{
+  int nSpecies = species.size();
+
+  if(!iod_ion_mat) { //dummy solver 
+    for(auto&& b : points) {
+      zav[b] = 0.0;
+      ne[b] = 0.0;
+      nh[b] = 0.0;
+      double *alpha_b = alpha + b*nSpecies*stride;
+      for(int q=0; q<nSpecies*stride; q++)
+        alpha_b[q] = 0.0;
+      if(nSpecies>0)
+        alpha_b[0] = 1.0;
+    }
+    return;
+  }
+
+  // Step 1: Compute T and nh. Points at or below Tmin are done here. 
+  active_points.clear();
+  active_T.clear();
+  for(auto&& b : points) {
+    double *vb = v + 5*b;
+    double T = vf->GetTemperature(vb[0], vf->GetInternalEnergyPerUnitMass(vb[0], vb[4]));
+    nh[b] = vb[0]/molar_mass*avogadro_number;
+    if(T<=Tmin) { //no ionization
+      zav[b] = 0.0;
+      ne[b] = 0.0;
+      for(int s=0; s<nSpecies; s++)
+        SetNeutralMolarFractions(species[s], alpha + (b*nSpecies+s)*stride, stride);
+      continue;
+    }
+    active_points.push_back(b);
+    active_T.push_back(T);
+  }
+
+  // Step 2: Solve the Saha equation at the remaining points
+  for(int a=0; a<(int)active_points.size(); a++) {
+
+    int b = active_points[a];
+    double T = active_T[a];
+
+    ZavEquation fun(kb, T, nh[b], me, h, elem, fprod_buffer);
+
+    zav[b] = SolveZavEquation(fun, warm_start ? zav[b] : -1.0, v[5*b+4], T);
+
+    if(!(zav[b]>0)) {
+      zav[b] = 0.0;
+      ne[b] = 0.0;
+      for(int s=0; s<nSpecies; s++)
+        SetNeutralMolarFractions(species[s], alpha + (b*nSpecies+s)*stride, stride);
+      continue;
+    }
+
+    ne[b] = zav[b]*nh[b];
+
+    for(int s=0; s<nSpecies; s++)
+      ComputeMolarFractions(fun, zav[b], species[s], alpha + (b*nSpecies+s)*stride, stride);
+  }
+}
+
+//--------------------------------------------------------------------------
+
+double
+SahaEquationSolver::SolveZavEquation(ZavEquation& fun, double zav_guess, double p, double T)
+{
+  double zav = 0.0;
 
   //Find initial bracketing interval (zav0, zav1)
   double zav0, zav1, f0, f1; 
-  zav0 = 0.0;
-  zav1 = max_mean_atomic_number; //zav1>zav0
-  f0 = fun(zav0);
   bool found_initial_interval = false;
-  for(int i=0; i<iod_ion_mat->maxIts; i++) {
-    f1 = fun(zav1);
-    if(f0*f1<=0.0) {
-      found_initial_interval = true;
-      break;
+
+  if(zav_guess>0.0) { //warm start: try a narrow interval around zav_guess (widened a few times, if needed)
+    double dz = 0.05*zav_guess;
+    for(int i=0; i<4; i++) {
+      zav0 = std::max(0.0, zav_guess - dz);
+      zav1 = std::min((double)max_mean_atomic_number, zav_guess + dz);
+      if(zav1<=zav0)
+        break;
+      f0 = fun(zav0);
+      f1 = fun(zav1);
+      if(f0*f1<=0.0) {
+        found_initial_interval = true;
+        break;
+      }
+      dz *= 4.0;
+    }
+  }
+
+  if(!found_initial_interval) {
+    zav0 = 0.0;
+    zav1 = max_mean_atomic_number; //zav1>zav0
+    f0 = fun(zav0);
+    for(int i=0; i<iod_ion_mat->maxIts; i++) {
+      f1 = fun(zav1);
+      if(f0*f1<=0.0) {
+        found_initial_interval = true;
+        break;
+      }
+      zav1 /= 2.0;
     }
-    zav1 /= 2.0;
   }
   if(!found_initial_interval) {
     fprintf(stdout,"\033[0;31m*** Error: Saha equation solver failed. "
-            "Cannot find an initial bracketing interval. (p = %e, T = %e)\n\033[0m", v[4], T);
+            "Cannot find an initial bracketing interval. (p = %e, T = %e)\n\033[0m", p, T);
     exit(-1);
   }
 
@@ -187,83 +295,78 @@ SahaEquationSolver::Solve(double* v, double& zav, double& nh, double& ne,
     }
   }
 
-  if(!(zav>0)) {
-    zav = 0.0;
-    ne = 0.0;
-    for(auto it = alpha_rj.begin(); it != alpha_rj.end(); it++) {
-      vector<double> &alpha = it->second;
-      for(int r=0; r<(int)alpha.size(); r++)
-        alpha[r] = (r==0) ? elem[it->first].molar_fraction : 0.0;
-    }
-    return;
-  }
-
-  //*******************************************************************
-
 #if DEBUG_SAHA_SOLVER == 1
   fprintf(stdout,"-- Saha equation solver converged in %d iterations, Zav = %.12e.\n", (int)maxit, zav);
 #endif
 
-  //post-processing.
-  ne = zav*nh;
+  return zav;
+}
 
-  for(auto it = alpha_rj.begin(); it != alpha_rj.end(); it++) {
-    int j = it->first; //element id
-    vector<double> &alpha = it->second; //alpha_r
+//--------------------------------------------------------------------------
 
-    if(j>=(int)elem.size()) {//this material does not have element j
-      for(int r=0; r<(int)alpha.size(); r++)
-        alpha[r] = 0.0;
-      continue;
-    }
+void
+SahaEquationSolver::ComputeMolarFractions(ZavEquation& fun, double zav, int j, double* alpha, int size)
+{
+  if(j>=(int)elem.size()) {//this material does not have element j
+    for(int r=0; r<size; r++)
+      alpha[r] = 0.0;
+    return;
+  }
 
-    double zej = fun.GetZej(zav, j);
-    //fprintf(stdout,"zej = %e for j = %d.\n", zej, j);
-    double denom = 0.0;
-    double zav_power = 1.0;
-    for(int i=1; i<=elem[j].rmax; i++) {
-      zav_power *= zav;
-      denom += (double)i/zav_power*fun.GetFProd(i,j);
-    }
+  double zej = fun.GetZej(zav, j);
+  //fprintf(stdout,"zej = %e for j = %d.\n", zej, j);
+  double denom = 0.0;
+  double zav_power = 1.0;
+  for(int i=1; i<=elem[j].rmax; i++) {
+    zav_power *= zav;
+    denom += (double)i/zav_power*fun.GetFProd(i,j);
+  }
 
-    if(denom>0)
-      alpha[0] = zej/denom;
-    else {
-      alpha[0] = 1.0;
-      for(int r=1; r<(int)alpha.size(); r++)
-        alpha[r] = 0.0;
-      return;
-    }
+  if(denom>0)
+    alpha[0] = zej/denom;
+  else {
+    alpha[0] = 1.0;
+    for(int r=1; r<size; r++)
+      alpha[r] = 0.0;
+    return;
+  }
  
-    double fr(0.0);
-    int max_size = std::min((int)alpha.size()-1, elem[j].rmax);
-    for(int r=1; r<max_size; r++) {
-      fr = (fun.GetFProd(r-1,j) == 0.0) ? 0.0 : fun.GetFProd(r,j)/fun.GetFProd(r-1,j);
-      alpha[r] = (r<=elem[j].rmax) ? alpha[r-1]/zav*fr : 0.0;
-    }
+  double fr(0.0);
+  int max_size = std::min(size-1, elem[j].rmax);
+  for(int r=1; r<max_size; r++) {
+    fr = (fun.GetFProd(r-1,j) == 0.0) ? 0.0 : fun.GetFProd(r,j)/fun.GetFProd(r-1,j);
+    alpha[r] = (r<=elem[j].rmax) ? alpha[r-1]/zav*fr : 0.0;
+  }
 
-    alpha[max_size] = elem[j].molar_fraction;
-    for(int r=0; r<max_size; r++)
-      alpha[max_size] -= alpha[r];
+  alpha[max_size] = elem[j].molar_fraction;
+  for(int r=0; r<max_size; r++)
+    alpha[max_size] -= alpha[r];
 
-    //allow some roundoff error
-    //assert(alpha[last_one]>=-1.0e-4);
-    if(alpha[max_size]<0)
-      alpha[max_size] = 0;
+  //allow some roundoff error
+  //assert(alpha[last_one]>=-1.0e-4);
+  if(alpha[max_size]<0)
+    alpha[max_size] = 0;
 
-    //too many slots? put 0
-    for(int r=max_size+1; r<(int)alpha.size(); r++)
-      alpha[r] = 0.0;
-  }
+  //too many slots? put 0
+  for(int r=max_size+1; r<size; r++)
+    alpha[r] = 0.0;
+}
 
-  //lambD is not calculated in the case of ideal Saha
+//--------------------------------------------------------------------------
+
+void
+SahaEquationSolver::SetNeutralMolarFractions(int j, double* alpha, int size)
+{
+  for(int r=0; r<size; r++)
+    alpha[r] = (r==0 && j<(int)elem.size()) ? elem[j].molar_fraction : 0.0;
 }
 
 //--------------------------------------------------------------------------
 
 SahaEquationSolver::ZavEquation::ZavEquation(double kb, double T, double nh, double me, double h, 
-                                             vector<AtomicIonizationData>& elem_)
-                               : elem(elem_)
+                                             vector<AtomicIonizationData>& elem_,
+                                             vector<vector<double> >& fprod_)
+                               : fprod(fprod_), elem(elem_)
 {
 
   double kbT = kb*T;
@@ -271,12 +374,12 @@ SahaEquationSolver::ZavEquation::ZavEquation(double kb, double T, double nh, dou
   double pi = 2.0*acos(0);
   double fcore = pow( (2.0*pi*(me/h)*(kbT/h)), 1.5)/nh;
 
-  // compute fprod
-  fprod.assign(elem.size(), vector<double>());
+  // compute fprod (reusing the memory of fprod_)
+  fprod.resize(elem.size());
   double Ur0, Ur1, f1;
   for(int j=0; j<(int)fprod.size(); j++) {
 
-    fprod[j].resize(elem[j].rmax+1, 0);
+    fprod[j].assign(elem[j].rmax+1, 0);
 
     fprod[j][0] = 1.0; //must be set to 1.0, s.t. fprod[j][1]/fprod[j][0] = f[j][1]
 
@@ -40,6 +40,11 @@ protected: //should be accessible for derived classes
 
   VarFcnBase* vf;
 
+  //! scratch space, reused across calls (to avoid reallocations)
+  std::vector<std::vector<double> > fprod_buffer;
+  std::vector<int> active_points;
+  std::vector<double> active_T;
+
 public:
 
   SahaEquationSolver(IoData& iod, VarFcnBase* vf_); //!< creates a dummy solver
@@ -51,16 +56,24 @@ public:
   virtual void Solve(double* v, double& zav, double& nh, double& ne, std::map<int, std::vector<double> >& alpha_rj,
                      double* lambD = NULL);
 
+  /** Solves for a batch of points (e.g., a row of cells of the same material), i.e. v[5*b], zav[b], nh[b], ne[b]
+   *  for b in "points". If warm_start is true, zav[b] carries an initial guess (e.g., from the previous output
+   *  frame; ignored if not positive). Molar fractions of element species[s] and charge r are stored in a flat
+   *  buffer: alpha[(b*species.size() + s)*stride + r]. */
+  virtual void SolveBatch(std::vector<int>& points, double* v, double* zav, double* nh, double* ne,
+                          std::vector<int>& species, int stride, double* alpha, bool warm_start = false);
+
   int GetNumberOfElements() {return elem.size();}
 
 protected:
 
   //! nested class / functor: nonlinear equation for Zav
   class ZavEquation {
-    std::vector<std::vector<double> > fprod; // f_{r,j}(T,...)*f_{r-1,j}(T,...)*...*f_{0,j}(T,...)
+    std::vector<std::vector<double> >& fprod; // f_{r,j}(T,...)*f_{r-1,j}(T,...)*...*f_{0,j}(T,...)
     std::vector<AtomicIonizationData>& elem;
   public:
-    ZavEquation(double kb, double T, double nh, double me, double h, std::vector<AtomicIonizationData>& elem_);
+    ZavEquation(double kb, double T, double nh, double me, double h, std::vector<AtomicIonizationData>& elem_,
+                std::vector<std::vector<double> >& fprod_);
     ~ZavEquation() {}
     double operator() (double zav) {return zav - ComputeRHS(zav);}
     double GetFProd(int r, int j) {assert(j<(int)fprod.size() && r<(int)fprod[j].size()); return fprod[j][r];}
@@ -70,6 +83,15 @@ protected:
     double ComputeRHS_ElementJ(double zav, int j);
   };
 
+  //! solves the Zav equation. zav_guess>0: try a narrow bracketing interval around it first
+  double SolveZavEquation(ZavEquation& fun, double zav_guess, double p, double T);
+
+  //! computes alpha_{r,j}, r = 0, ..., size-1 (given zav>0)
+  void ComputeMolarFractions(ZavEquation& fun, double zav, int j, double* alpha, int size);
+
+  //! alpha_{r,j} in the absence of ionization
+  void SetNeutralMolarFractions(int j, double* alpha, int size);
+
 };
 
 
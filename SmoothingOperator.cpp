@@ -20,6 +20,104 @@ SmoothingOperator::SmoothingOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, S
                 "NumberOfIteration = %d.\n", iod_smooth.type, iod_smooth.iteration);
     exit_mpi();
   }
+
+  coordinates.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+  coordinates.GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+  coordinates.GetGlobalSize(&NX, &NY, &NZ);
+
+  // 1D mesh info (the mesh is a tensor product): cell width, squared distances to the two neighbors
+  vector<double> width[3], dist2_l[3], dist2_r[3];
+  Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
+  Vec3D*** dxyz   = (Vec3D***)delta_xyz.GetDataPointer();
+  int lo[3] = {ii0, jj0, kk0}, hi[3] = {iimax, jjmax, kkmax}, N[3] = {NX, NY, NZ};
+  for(int d=0; d<3; d++) {
+    int n = hi[d] - lo[d];
+    vector<double> x(n, 0.0);
+    inside[d].assign(n, 0.0);
+    width[d].assign(n, 0.0);
+    dist2_l[d].assign(n, 0.0);
+    dist2_r[d].assign(n, 0.0);
+    for(int g=lo[d]; g<hi[d]; g++) {
+      int i = d==0 ? g : i0, j = d==1 ? g : j0, k = d==2 ? g : k0;
+      x[g-lo[d]]        = coords[k][j][i][d];
+      width[d][g-lo[d]] = dxyz[k][j][i][d];
+      inside[d][g-lo[d]] = (g>=0 && g<N[d]) ? 1.0 : 0.0;
+    }
+    for(int m=1; m<n; m++) {
+      dist2_l[d][m]   = (x[m]-x[m-1])*(x[m]-x[m-1]);
+      dist2_r[d][m-1] = dist2_l[d][m];
+    }
+  }
+  coordinates.RestoreDataPointerToLocalVector();
+  delta_xyz.RestoreDataPointerToLocalVector();
+
+  int nx = imax - i0;
+  pencil_id.assign(nx+2, 0.0);
+  zero_id.assign(nx+2, 0.0);
+  wl.assign(nx, 0.0);
+  wr.assign(nx, 0.0);
+
+  if(iod_smooth.type == SmoothingData::GAUSSIAN)
+    SetupGaussianWeights(width, dist2_l, dist2_r);
+}
+
+//--------------------------------------------------------------------------
+
+void SmoothingOperator::SetupGaussianWeights(vector<double> *width, vector<double> *dist2_l,
+                                             vector<double> *dist2_r)
+{
+  // In cell (i,j,k), sigma = sigma_factor*min(dx,dy,dz). The loops follow the three passes.
+  int nx = imax - i0;
+  int ny = jmax - j0, nyg = jjmax - jj0, nzg = kkmax - kk0;
+  int jA0 = std::max(jj0,0), jA1 = std::min(jjmax,NY);
+  int kA0 = std::max(kk0,0), kA1 = std::min(kkmax,NZ);
+
+  gauss_l[0].assign((size_t)nx*nyg*nzg, 0.0);
+  gauss_r[0].assign((size_t)nx*nyg*nzg, 0.0);
+  gauss_l[1].assign((size_t)nx*ny*nzg, 0.0);
+  gauss_r[1].assign((size_t)nx*ny*nzg, 0.0);
+  gauss_l[2].assign((size_t)nx*ny*(kmax-k0), 0.0);
+  gauss_r[2].assign((size_t)nx*ny*(kmax-k0), 0.0);
+
+  double f2 = iod_smooth.sigma_factor*iod_smooth.sigma_factor;
+  double h, s, inv_var;
+  size_t n;
+
+  for(int k=kA0; k<kA1; k++)
+    for(int j=jA0; j<jA1; j++) {
+      h = std::min(width[1][j-jj0], width[2][k-kk0]);
+      n = ((size_t)(k-kk0)*nyg + (j-jj0))*nx;
+      for(int i=i0; i<imax; i++, n++) {
+        s = std::min(width[0][i-ii0], h);
+        inv_var = 1.0/(f2*s*s);
+        gauss_l[0][n] = inside[0][i-1-ii0]*exp(-0.5*dist2_l[0][i-ii0]*inv_var);
+        gauss_r[0][n] = inside[0][i+1-ii0]*exp(-0.5*dist2_r[0][i-ii0]*inv_var);
+      }
+    }
+
+  for(int k=kA0; k<kA1; k++)
+    for(int j=j0; j<jmax; j++) {
+      h = std::min(width[1][j-jj0], width[2][k-kk0]);
+      n = ((size_t)(k-kk0)*ny + (j-j0))*nx;
+      for(int i=i0; i<imax; i++, n++) {
+        s = std::min(width[0][i-ii0], h);
+        inv_var = 1.0/(f2*s*s);
+        gauss_l[1][n] = inside[1][j-1-jj0]*exp(-0.5*dist2_l[1][j-jj0]*inv_var);
+        gauss_r[1][n] = inside[1][j+1-jj0]*exp(-0.5*dist2_r[1][j-jj0]*inv_var);
+      }
+    }
+
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++) {
+      h = std::min(width[1][j-jj0], width[2][k-kk0]);
+      n = ((size_t)(k-k0)*ny + (j-j0))*nx;
+      for(int i=i0; i<imax; i++, n++) {
+        s = std::min(width[0][i-ii0], h);
+        inv_var = 1.0/(f2*s*s);
+        gauss_l[2][n] = inside[2][k-1-kk0]*exp(-0.5*dist2_l[2][k-kk0]*inv_var);
+        gauss_r[2][n] = inside[2][k+1-kk0]*exp(-0.5*dist2_r[2][k-kk0]*inv_var);
+      }
+    }
 }
 
 //--------------------------------------------------------------------------
@@ -39,169 +137,159 @@ void SmoothingOperator::Destroy()
 void SmoothingOperator::ApplySmoothingFilter(SpaceVariable3D &V, SpaceVariable3D *ID)
 {
   if(iod_smooth.type == SmoothingData::BOX)
-    ApplyBoxFilter(V, ID);
+    ApplySeparableFilter(V, ID, false);
   else if(iod_smooth.type == SmoothingData::GAUSSIAN)
-    ApplyGausianFilter(V, ID);
+    ApplySeparableFilter(V, ID, true);
 }
 
 //--------------------------------------------------------------------------
 
-void SmoothingOperator::ApplyBoxFilter(SpaceVariable3D &V, SpaceVariable3D *ID)
+void SmoothingOperator::ApplySeparableFilter(SpaceVariable3D &V, SpaceVariable3D *ID, bool gaussian)
 {
 
-  int Vdim = V.NumDOF(), V0dim = V0.NumDOF();
-  if(Vdim>V0dim) {
+  int dof = V.NumDOF(), V0dim = V0.NumDOF();
+  bool conservation = iod_smooth.conservation == SmoothingData::ON;
+  if(conservation && dof>V0dim) {
     print_error("*** Error: Size of the internal variable in SmoothingOperator needs"
-                " to be increased (%d vs. %d).\n", V0dim, Vdim);
+                " to be increased (%d vs. %d).\n", V0dim, dof);
     exit_mpi();
   } 
 
-  int myid;
-  double sum_weight = 0;
+  //copy data from V to V0 (needed only for enforcing conservation)
+  if(conservation) {
+    vector<int> ind;
+    for(int i=0; i<dof; i++) 
+      ind.push_back(i);
+    V0.AXPlusBY(0.0, 1.0, V, ind, ind, true);
+  }
 
-  //copy data from V to V0
-  vector<int> ind;
-  for(int i=0; i<Vdim; i++) 
-    ind.push_back(i);
-  V0.AXPlusBY(0.0, 1.0, V, ind, ind, true);
+  int nx = imax - i0;
+  int ny = jmax - j0, nyg = jjmax - jj0, nzg = kkmax - kk0;
+  Wx.resize((size_t)nx*nyg*nzg*dof);
+  Wy.resize((size_t)nx*ny*nzg*dof);
+  pencil_v.resize((nx+2)*dof);
 
-  //get mesh info
-  int i0, j0, k0, imax, jmax, kmax;
-  coordinates.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+  // rows of the ghosted subdomain that are inside the physical domain
+  int jA0 = std::max(jj0,0), jA1 = std::min(jjmax,NY);
+  int kA0 = std::max(kk0,0), kA1 = std::min(kkmax,NZ);
 
   double*** v  = (double***)V.GetDataPointer();
-  double*** v0 = (double***)V0.GetDataPointer();
   double*** id = ID ? (double***)ID->GetDataPointer() : NULL;
- 
-  //apply smoothing in the interior of the subdomain
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
-            
-        myid = ID ? id[k][j][i] : 0;
-
-        // clear data
-        sum_weight = 0.0;
-        setValue(&v[k][j][i*Vdim], 0.0, Vdim);
-
-        for(int neighk=k-1; neighk<=k+1; neighk++)
-          for(int neighj=j-1; neighj<=j+1; neighj++)
-            for(int neighi=i-1; neighi<=i+1; neighi++) {
-
-              if(ID && myid != id[neighk][neighj][neighi])
-                continue;
-
-              //if(coordinates.OutsidePhysicalDomainAndUnpopulated(neighi,neighj,neighk))
-              if(coordinates.OutsidePhysicalDomain(neighi,neighj,neighk))
-                continue; //no valid data here.
-
-              //fprintf(stdout,"(%d %d %d) %d : neigh (%d %d %d), weight = %e, rho = %e\n", i,j,k, (int)myid, neighi, neighj, neighk, 1.0, v0[neighk][neighj][neighi*V0dim+0]);
-
-              sum_weight += 1.0;
-              addarray(&v0[neighk][neighj][neighi*V0dim], &v[k][j][i*Vdim], Vdim);
-            //  for(int p=0; p<Vdim; p++)
-             //   v[k][j][i*Vdim+p] += v0[neighk][neighj][neighi*V0dim+p];
-            }
-
-        for(int p=0; p<Vdim; p++)
-          v[k][j][i*Vdim+p] /= sum_weight;
 
+  const double *idl, *idc, *idr;
+  size_t n; //index of the first cell of a pencil in the output of the pass (see gauss_l, gauss_r)
+
+  // ---------------------------------------------------------------
+  // x-pass (v --> Wx): interior in x, all the rows inside the physical domain in y and z
+  // ---------------------------------------------------------------
+  for(int k=kA0; k<kA1; k++)
+    for(int j=jA0; j<jA1; j++) {
+
+      // pencil buffers. Cells outside the physical domain are replaced by their neighbors (weight: 0)
+      double *row = v[k][j];
+      int il = inside[0][i0-1-ii0]   ? i0-1 : i0;
+      int ir = inside[0][imax-ii0]   ? imax : imax-1;
+      copyarray(&row[il*dof], &pencil_v[0], dof);
+      copyarray(&row[i0*dof], &pencil_v[dof], nx*dof);
+      copyarray(&row[ir*dof], &pencil_v[(nx+1)*dof], dof);
+      if(id) {
+        pencil_id[0] = id[k][j][il];
+        copyarray(&id[k][j][i0], &pencil_id[1], nx);
+        pencil_id[nx+1] = id[k][j][ir];
       }
+      const double *pid = id ? pencil_id.data() : zero_id.data();
+
+      n = ((size_t)(k-kk0)*nyg + (j-jj0))*nx;
+      if(gaussian)
+        ComputePencilWeights(nx, &gauss_l[0][n], &gauss_r[0][n], 1, pid, pid+1, pid+2);
+      else
+        ComputePencilWeights(nx, &inside[0][i0-1-ii0], &inside[0][i0+1-ii0], 1, pid, pid+1, pid+2);
+
+      FilterPencil(nx, dof, &pencil_v[0], &pencil_v[dof], &pencil_v[2*dof], &Wx[n*dof]);
+    }
+
+  // ---------------------------------------------------------------
+  // y-pass (Wx --> Wy): interior in x and y, all the rows inside the physical domain in z
+  // ---------------------------------------------------------------
+  for(int k=kA0; k<kA1; k++)
+    for(int j=j0; j<jmax; j++) {
+
+      int jl = inside[1][j-1-jj0] ? j-1 : j;
+      int jr = inside[1][j+1-jj0] ? j+1 : j;
+      idl = id ? &id[k][jl][i0] : zero_id.data();
+      idc = id ? &id[k][j][i0]  : zero_id.data();
+      idr = id ? &id[k][jr][i0] : zero_id.data();
+
+      n = ((size_t)(k-kk0)*ny + (j-j0))*nx;
+      if(gaussian)
+        ComputePencilWeights(nx, &gauss_l[1][n], &gauss_r[1][n], 1, idl, idc, idr);
+      else
+        ComputePencilWeights(nx, &inside[1][j-1-jj0], &inside[1][j+1-jj0], 0, idl, idc, idr);
+
+      FilterPencil(nx, dof, &Wx[(((size_t)(k-kk0)*nyg + (jl-jj0))*nx)*dof],
+                   &Wx[(((size_t)(k-kk0)*nyg + (j-jj0))*nx)*dof],
+                   &Wx[(((size_t)(k-kk0)*nyg + (jr-jj0))*nx)*dof], &Wy[n*dof]);
+    }
+
+  // ---------------------------------------------------------------
+  // z-pass (Wy --> v): interior
+  // ---------------------------------------------------------------
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++) {
+
+      int kl = inside[2][k-1-kk0] ? k-1 : k;
+      int kr = inside[2][k+1-kk0] ? k+1 : k;
+      idl = id ? &id[kl][j][i0] : zero_id.data();
+      idc = id ? &id[k][j][i0]  : zero_id.data();
+      idr = id ? &id[kr][j][i0] : zero_id.data();
+
+      n = ((size_t)(k-k0)*ny + (j-j0))*nx;
+      if(gaussian)
+        ComputePencilWeights(nx, &gauss_l[2][n], &gauss_r[2][n], 1, idl, idc, idr);
+      else
+        ComputePencilWeights(nx, &inside[2][k-1-kk0], &inside[2][k+1-kk0], 0, idl, idc, idr);
+
+      FilterPencil(nx, dof, &Wy[(((size_t)(kl-kk0)*ny + (j-j0))*nx)*dof],
+                   &Wy[(((size_t)(k-kk0)*ny + (j-j0))*nx)*dof],
+                   &Wy[(((size_t)(kr-kk0)*ny + (j-j0))*nx)*dof],
+                   &v[k][j][i0*dof]);
+    }
 
-  V0.RestoreDataPointerToLocalVector();
   if(ID) ID->RestoreDataPointerToLocalVector();
 
-  V.RestoreDataPointerAndInsert();
+  // only the interior has been updated. The exchange is deferred until the ghosts are needed.
+  V.RestoreDataPointerAndMarkGhostsStale();
 
-  if(iod_smooth.conservation == SmoothingData::ON)
+  if(conservation)
     EnforceLocalConservation(V0, V, ID);
 
 }
 
 //--------------------------------------------------------------------------
 
-void SmoothingOperator::ApplyGausianFilter(SpaceVariable3D &V, SpaceVariable3D *ID)
+void SmoothingOperator::ComputePencilWeights(int n, const double *gl, const double *gr, int stride,
+                                             const double *idl, const double *idc, const double *idr)
 {
+  // branch-free: the material mask is multiplied to the weights
+  for(int q=0; q<n; q++) {
+    wl[q] = gl[q*stride]*(double)(idl[q]==idc[q]);
+    wr[q] = gr[q*stride]*(double)(idr[q]==idc[q]);
+  }
+}
 
-  int Vdim = V.NumDOF(), V0dim = V0.NumDOF();
-  if(Vdim>V0dim) {
-    print_error("*** Error: Size of the internal variable in SmoothingOperator needs"
-                " to be increased (%d vs. %d).\n", V0dim, Vdim);
-    exit_mpi();
-  } 
-
-  //get mesh info
-  int i0, j0, k0, imax, jmax, kmax;
-  coordinates.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
-  Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
-  Vec3D*** dxyz = (Vec3D***)delta_xyz.GetDataPointer();
- 
-  int myid;
-  double weight = 0, sum_weight = 0;
-  double variance = 0.0; 
-
-  //copy data from V to V0
-  vector<int> ind;
-  for(int i=0; i<Vdim; i++) 
-    ind.push_back(i);
-  V0.AXPlusBY(0.0, 1.0, V, ind, ind, true);
-
-  double*** v  = (double***)V.GetDataPointer();
-  double*** v0 = (double***)V0.GetDataPointer();
-  double*** id = ID ? (double***)ID->GetDataPointer() : NULL;
-
-  //apply smoothing in the interior of the subdomain
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
-            
-        myid = ID ? id[k][j][i] : 0;
-        Vec3D &x(coords[k][j][i]);
-
-        // clear data
-        sum_weight = 0.0;
-        setValue(&v[k][j][i*Vdim], 0.0, Vdim);
-
-        // set sigma^2 (the variance of Gaussian distribution)
-        variance = iod_smooth.sigma_factor*std::min(std::min(dxyz[k][j][i][0],dxyz[k][j][i][1]),dxyz[k][j][i][2]);
-        variance = variance*variance;
-
-        for(int neighk=k-1; neighk<=k+1; neighk++)
-          for(int neighj=j-1; neighj<=j+1; neighj++)
-            for(int neighi=i-1; neighi<=i+1; neighi++) {
-
-              if(ID && myid != id[neighk][neighj][neighi])
-                continue;
-
-              //if(coordinates.OutsidePhysicalDomainAndUnpopulated(neighi,neighj,neighk))
-              if(coordinates.OutsidePhysicalDomain(neighi,neighj,neighk))
-                continue; //no valid data here.
-
-              Vec3D &x1(coords[neighk][neighj][neighi]);
-
-              weight = exp(-pow((x1-x).norm(),2)/(2.0*variance));
-
-//              fprintf(stdout,"(%d %d %d) %d : neigh (%d %d %d), weight = %e, rho = %e\n", i,j,k, (int)myid, neighi, neighj, neighk, weight, v0[neighk][neighj][neighi*V0dim+0]);
-
-              sum_weight += weight;
-              for(int p=0; p<Vdim; p++)
-                v[k][j][i*Vdim+p] += weight*v0[neighk][neighj][neighi*V0dim+p];
-            }
-
-        for(int p=0; p<Vdim; p++)
-          v[k][j][i*Vdim+p] /= sum_weight;
-
-      }
-
-  coordinates.RestoreDataPointerToLocalVector();
-  delta_xyz.RestoreDataPointerToLocalVector();
-  V0.RestoreDataPointerToLocalVector();
-  if(ID) ID->RestoreDataPointerToLocalVector();
-
-  V.RestoreDataPointerAndInsert();
+//--------------------------------------------------------------------------
 
-  if(iod_smooth.conservation == SmoothingData::ON)
-    EnforceLocalConservation(V0, V, ID);
+void SmoothingOperator::FilterPencil(int n, int dof, const double *l, const double *c, const double *r,
+                                     double *out)
+{
+  double s, a, b;
+  for(int q=0; q<n; q++) {
+    s = 1.0/(wl[q] + 1.0 + wr[q]);
+    a = wl[q]*s;
+    b = wr[q]*s;
+    for(int p=0; p<dof; p++)
+      out[q*dof+p] = a*l[q*dof+p] + s*c[q*dof+p] + b*r[q*dof+p];
+  }
 }
 
 //--------------------------------------------------------------------------
@@ -7,11 +7,20 @@
 #define _SMOOTHING_Operator_H_
 #include <IoData.h>
 #include <SpaceVariable.h>
+#include <vector>
 
 /********************************************************************************
  * Class SmoothingOperator applies smoothing filters (of different types) to a spatial
  * variable of any dimension. By default it does not go across material interfaces.
  * i.e. the stencil for each node will contain only nodes within the same material
+ * The (box or Gaussian) filter is applied as three 1D passes (x, then y, then z),
+ * each with a 3-point stencil. In the interior of a single-material region on a
+ * uniform mesh, this is the same as the 27-point 3D filter. The passes are done
+ * pencil by pencil, with masks (material, physical domain) folded into the weights.
+ * The geometric weights of the Gaussian filter depend only on the (static) mesh,
+ * so they are computed once, in the constructor.
+ * Note: EnforceLocalConservation still uses the 27-point stencil. Its material mask
+ * is keyed on the center cell, which is not a tensor product.
  *******************************************************************************/
 class SmoothingOperator
 {
@@ -24,9 +33,28 @@ class SmoothingOperator
   SpaceVariable3D &delta_xyz;
   SpaceVariable3D &volume;
 
-  //! Interval variable to store data temporarily
+  //! Interval variable to store data temporarily (for EnforceLocalConservation)
   SpaceVariable3D V0;
 
+  //! Subdomain
+  int i0, j0, k0, imax, jmax, kmax;
+  int ii0, jj0, kk0, iimax, jjmax, kkmax;
+  int NX, NY, NZ;
+
+  //! 1D mesh info in each direction (d = 0, 1, 2), indexed by (index - lower corner of ghosted subdomain):
+  //! 1 inside the physical domain (0 otherwise)
+  std::vector<double> inside[3];
+
+  //! Gaussian filter: weights of the two neighbors in the pass in direction d (including the physical
+  //! domain mask), stored in the same layout as the output of the pass (Wx, Wy, interior of V)
+  std::vector<double> gauss_l[3], gauss_r[3];
+
+  //! Results of the x- and y-passes (dof values per cell)
+  std::vector<double> Wx, Wy;
+
+  //! Pencil buffers
+  std::vector<double> pencil_v, pencil_id, zero_id, wl, wr;
+
 public:
 
   SmoothingOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, SmoothingData &iod_smooth_,
@@ -41,9 +69,20 @@ public:
 
 private:
 
-  void ApplyBoxFilter(SpaceVariable3D &V, SpaceVariable3D *ID);
+  //! box or Gaussian filter, in three 1D passes
+  void ApplySeparableFilter(SpaceVariable3D &V, SpaceVariable3D *ID, bool gaussian);
+
+  //! computes gauss_l and gauss_r (called by the constructor)
+  void SetupGaussianWeights(std::vector<double> *width, std::vector<double> *dist2_l,
+                            std::vector<double> *dist2_r);
+
+  //! sets wl and wr, the weights of the two neighbors of n cells (relative to the cell itself): the geometric
+  //! weights gl and gr (read with the given stride; 0: same for all the cells), masked by material ID
+  void ComputePencilWeights(int n, const double *gl, const double *gr, int stride,
+                            const double *idl, const double *idc, const double *idr);
 
-  void ApplyGausianFilter(SpaceVariable3D &V, SpaceVariable3D *ID); 
+  //! out = (wl*l + c + wr*r)/(wl + 1 + wr), for n cells with dof values each
+  void FilterPencil(int n, int dof, const double *l, const double *c, const double *r, double *out);
 
   void EnforceLocalConservation(SpaceVariable3D &U0, SpaceVariable3D &U, SpaceVariable3D *ID);
 };
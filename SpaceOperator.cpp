@@ -56,8 +56,10 @@ SpaceOperator::SpaceOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &i
     Utmp(comm_, &(dm_all_.ghosted1_5dof)),
     Tag(comm_, &(dm_all_.ghosted1_1dof)),
     symm(NULL), visco(NULL), heat_diffusion(NULL), heo(NULL), smooth(NULL),
-    frozen_nodes_ptr(NULL)
+    frozen_nodes_ptr(NULL), lts_level(NULL), lts_substep(0), lts_dt0(0.0), tiles(NULL), residual_calls(0)
 {
+  for(int p=0; p<RESIDUAL_PASSES; p++)
+    residual_pass_time[p] = 0.0;
   
   coordinates.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
   coordinates.GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
@@ -71,7 +73,7 @@ SpaceOperator::SpaceOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &i
   rec.Setup(&ghost_nodes_inner, &ghost_nodes_outer); //this function requires mesh info (dxyz)
   
   if(iod.mesh.type == MeshData::SPHERICAL || iod.mesh.type == MeshData::CYLINDRICAL)
-    symm = new SymmetryOperator(comm, dm_all, iod.mesh, varFcn, coordinates, delta_xyz, volume);
+    symm = new SymmetryOperator(comm, dm_all, iod.mesh, varFcn, coordinates);
 
   if(iod.schemes.ns.smooth.type != SmoothingData::NONE)
     smooth = new SmoothingOperator(comm, dm_all, iod.schemes.ns.smooth, coordinates, delta_xyz, volume);
@@ -95,6 +97,7 @@ SpaceOperator::~SpaceOperator()
   if(heat_diffusion) delete heat_diffusion;
   if(smooth) delete smooth;
   if(interfluxFcn) delete interfluxFcn;
+  if(tiles) delete tiles;
 }
 
 //-----------------------------------------------------
@@ -178,6 +181,9 @@ void SpaceOperator::SetupMesh(vector<double> &x, vector<double> &y, vector<doubl
   delta_xyz.RestoreDataPointerAndInsert();
   volume.RestoreDataPointerAndInsert();
 
+  //! Extract 1D mesh tables for stencil kernels
+  metrics.Setup(coordinates, delta_xyz);
+
 }
 
 //-----------------------------------------------------
@@ -417,6 +423,8 @@ void SpaceOperator::ResetGhostLayer(double* xminus, double* xplus, double* yminu
   delta_xyz.RestoreDataPointerAndInsert();
   volume.RestoreDataPointerAndInsert();
 
+  metrics.Setup(coordinates, delta_xyz); //ghost layer has changed
+
 
   CreateGhostNodeLists(false); //create ghost_nodes_inner and ghost_nodes_outer
 
@@ -553,8 +561,9 @@ void SpaceOperator::CreateGhostNodeLists(bool screenout)
 void SpaceOperator::ConservativeToPrimitive(SpaceVariable3D &U, SpaceVariable3D &ID, SpaceVariable3D &V,
                                             bool workOnGhost)
 {
-  Vec5D*** u = (Vec5D***) U.GetDataPointer();
-  Vec5D*** v = (Vec5D***) V.GetDataPointer();
+  // If !workOnGhost, only the interior of U is read, and the halo exchange of V is deferred.
+  Vec5D*** u = (Vec5D***) (workOnGhost ? U.GetDataPointer() : U.GetDataPointerInteriorOnly());
+  Vec5D*** v = (Vec5D***) (workOnGhost ? V.GetDataPointer() : V.GetDataPointerInteriorOnly());
   double*** id = (double***) ID.GetDataPointer();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
@@ -569,7 +578,10 @@ void SpaceOperator::ConservativeToPrimitive(SpaceVariable3D &U, SpaceVariable3D
         varFcn[id[k][j][i]]->ConservativeToPrimitive((double*)u[k][j][i], (double*)v[k][j][i]); 
 
   U.RestoreDataPointerToLocalVector(); //no changes made
-  V.RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    V.RestoreDataPointerAndInsert();
+  else
+    V.RestoreDataPointerAndMarkGhostsStale();
   ID.RestoreDataPointerToLocalVector(); //no changes made
 }
 
@@ -578,8 +590,9 @@ void SpaceOperator::ConservativeToPrimitive(SpaceVariable3D &U, SpaceVariable3D
 void SpaceOperator::PrimitiveToConservative(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &U, 
                                             bool workOnGhost)
 {
-  Vec5D*** v = (Vec5D***) V.GetDataPointer();
-  Vec5D*** u = (Vec5D***) U.GetDataPointer();
+  // If !workOnGhost, only the interior of V is read, and the halo exchange of U is deferred.
+  Vec5D*** v = (Vec5D***) (workOnGhost ? V.GetDataPointer() : V.GetDataPointerInteriorOnly());
+  Vec5D*** u = (Vec5D***) (workOnGhost ? U.GetDataPointer() : U.GetDataPointerInteriorOnly());
   double*** id = (double***) ID.GetDataPointer();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
@@ -594,7 +607,10 @@ void SpaceOperator::PrimitiveToConservative(SpaceVariable3D &V, SpaceVariable3D
         varFcn[id[k][j][i]]->PrimitiveToConservative((double*)v[k][j][i], (double*)u[k][j][i]); 
 
   V.RestoreDataPointerToLocalVector(); //no changes made
-  U.RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    U.RestoreDataPointerAndInsert();
+  else
+    U.RestoreDataPointerAndMarkGhostsStale();
   ID.RestoreDataPointerToLocalVector(); //no changes made
 }
 
@@ -648,6 +664,112 @@ int SpaceOperator::ClipDensityAndPressure(SpaceVariable3D &V, SpaceVariable3D &I
   return nClipped;
 }  
 
+//-----------------------------------------------------
+
+int SpaceOperator::UpdateStageStateKernel(double a, SpaceVariable3D *Un, double b, SpaceVariable3D *U,
+                                          double c, SpaceVariable3D &R, SpaceVariable3D *LocalDt,
+                                          SpaceVariable3D &ID, SpaceVariable3D &V)
+{
+  // Only the domain interior is read or written (except for V, whose ghosts are updated at the end)
+  Vec5D***  un = a!=0.0 ? (Vec5D***) Un->GetDataPointerInteriorOnly() : NULL;
+  Vec5D***  u  = U ? (Vec5D***) U->GetDataPointerInteriorOnly() : NULL;
+  Vec5D***  r  = (Vec5D***) R.GetDataPointerInteriorOnly();
+  double*** dt = LocalDt ? LocalDt->GetDataPointerInteriorOnly() : NULL;
+  Vec5D***  v  = (Vec5D***) V.GetDataPointerInteriorOnly();
+  double*** id = ID.GetDataPointer();
+
+  // Tiles that keep their state at t(n) (see ActiveTiles)
+  SpaceVariable3D *Vn = NULL;
+  Vec5D*** vn = NULL;
+  if(tiles) {
+    tiles->PrepareUpdate();
+    Vn = tiles->GetStepStartState();
+    if(Vn && Vn != &V)
+      vn = (Vec5D***) Vn->GetDataPointerInteriorOnly();
+  }
+
+  int myid;
+  double coeff;
+  Vec5D us; //stage state, if U is not stored
+  int nClipped = 0;
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++) {
+
+        if(tiles && tiles->Kept(i,j,k)) { //U = Un, V = V(n)
+          if(un && u)
+            u[k][j][i] = un[k][j][i];
+          if(vn)
+            v[k][j][i] = vn[k][j][i];
+          continue;
+        }
+
+        coeff = dt ? c*dt[k][j][i] : c;
+        myid = id[k][j][i];
+
+        Vec5D &uc(u ? u[k][j][i] : us);
+
+        if(b==0.0) //do not read u (may be uninitialized)
+          uc = coeff*r[k][j][i];
+        else {
+          if(!u) //recover the stage state from V
+            varFcn[myid]->PrimitiveToConservative((double*)v[k][j][i], (double*)us);
+          uc = b*uc + coeff*r[k][j][i];
+        }
+
+        if(un)
+          uc += a*un[k][j][i];
+
+        varFcn[myid]->ConservativeToPrimitive((double*)uc, (double*)v[k][j][i]);
+
+        if(varFcn[myid]->ClipDensityAndPressure(v[k][j][i])) {
+          nClipped++;
+          if(u)
+            varFcn[myid]->PrimitiveToConservative((double*)v[k][j][i], (double*)u[k][j][i]); //roll back
+        }
+
+        if(varFcn[myid]->CheckState(v[k][j][i])) {
+          fprintf(stdout, "\033[0;31m*** Error: State variables at (%e,%e,%e) violate hyperbolicity." 
+                  " matid = %d.\n\033[0m", metrics.X(i), metrics.Y(j), metrics.Z(k), myid);
+          fprintf(stdout, "\033[0;31mv[%d(i),%d(j),%d(k)] = [%e, %e, %e, %e, %e]\n\033[0m", 
+                  i,j,k, v[k][j][i][0], v[k][j][i][1], v[k][j][i][2], v[k][j][i][3], v[k][j][i][4]);
+          exit(-1);
+        }
+      }
+
+  if(un) Un->RestoreDataPointerToLocalVector(); //no changes made
+  R.RestoreDataPointerToLocalVector(); //no changes made
+  if(dt) LocalDt->RestoreDataPointerToLocalVector(); //no changes made
+  if(vn) Vn->RestoreDataPointerToLocalVector(); //no changes made
+  ID.RestoreDataPointerToLocalVector(); //no changes made
+
+  if(u) U->RestoreDataPointerAndMarkGhostsStale();
+  V.RestoreDataPointerAndInsert(); //the only exchange
+
+  MPI_Allreduce(MPI_IN_PLACE, &nClipped, 1, MPI_INT, MPI_SUM, comm);
+  if(nClipped && verbose>0)
+    print_warning(comm, "Warning: Clipped pressure and/or density in %d cells.\n", nClipped);
+
+  return nClipped;
+}
+
+//-----------------------------------------------------
+
+void SpaceOperator::SetupActiveTiles()
+{
+  if(iod.schemes.ns.active_tile_size<=0)
+    return;
+
+  if(visco || heat_diffusion) {
+    print_error(comm, "*** Error: Skipping quiescent tiles is not supported with viscosity or heat diffusion.\n");
+    exit_mpi();
+  }
+
+  tiles = new ActiveTiles(comm, coordinates, ghost_nodes_outer, iod.schemes.ns.active_tile_size,
+                          iod.schemes.ns.active_tile_report_frequency);
+  rec.SetActiveTiles(tiles);
+}
+
 //-----------------------------------------------------
 //assign interpolator and gradien calculator (pointers) to the viscosity operator
 void SpaceOperator::SetupViscosityOperator(InterpolatorBase *interpolator_, GradientCalculatorBase *grad_,
@@ -1047,8 +1169,8 @@ SpaceOperator::SetInitialCondition(SpaceVariable3D &V, SpaceVariable3D &ID,
     // Verification (can be deleted): occluded nodes should have inactive_material_id
     int i,j,k;
     for(int surf=0; surf<(int)EBDS->size(); surf++) {
-      set<Int3> *occluded = (*EBDS)[surf]->occluded_ptr;
-      set<Int3> *imposed_occluded = (*EBDS)[surf]->imposed_occluded_ptr;
+      NodeSet *occluded = (*EBDS)[surf]->occluded_ptr;
+      NodeSet *imposed_occluded = (*EBDS)[surf]->imposed_occluded_ptr;
       for(auto it = occluded->begin(); it != occluded->end(); it++) {
         i = (*it)[0];
         j = (*it)[1];
@@ -1766,6 +1888,9 @@ SpaceOperator::ApplySmoothingFilter(double time, double dt, int time_step, Space
     ClipDensityAndPressure(V,ID);
     ApplyBoundaryConditions(V);
   } 
+
+  if(tiles)
+    tiles->InvalidateAll();
 }
 
 //-----------------------------------------------------
@@ -2359,8 +2484,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
 
   double*** id = (double***) ID.GetDataPointer();
 
-  Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer(); 
-  Vec3D*** dxyz   = (Vec3D***)delta_xyz.GetDataPointer(); 
+  double*** lev = lts_level ? lts_level->GetDataPointer() : NULL; //local time-stepping (usually NULL)
  
   //------------------------------------
   // Extract level set gradient data
@@ -2394,12 +2518,20 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   //------------------------------------
   Vec5D localflux1, localflux2;
 
-  // Initialize F to 0
+  // Initialize F to 0 -- only in the ghost layer. Cells (i,j,k) with j<jjmax-1 and k<kkmax-1 (including all the
+  // cells in the domain interior) are first touched by the flux across their own left face, which is the first
+  // flux computed in the loop below at (i,j,k). There, F is assigned ("write once") rather than incremented,
+  // which avoids streaming the entire ghosted array through memory one extra time.
   for(int k=kk0; k<kkmax; k++)
-    for(int j=jj0; j<jjmax; j++) 
-      for(int i=ii0; i<iimax; i++) {
-        f[k][j][i] = 0.0; //setting f[k][j][i][0] = ... = f[k][j][i][4] = 0.0;
+    for(int j=jj0; j<jjmax; j++) {
+      if(k<k0 || k==kkmax-1 || j<j0 || j==jjmax-1) { //entire row in the ghost layer
+        for(int i=ii0; i<iimax; i++)
+          f[k][j][i] = 0.0; //setting f[k][j][i][0] = ... = f[k][j][i][4] = 0.0;
+      } else {
+        for(int i=ii0; i<i0; i++)
+          f[k][j][i] = 0.0;
       }
+    }
 
 
   int myid;
@@ -2408,6 +2540,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   double Vmid[5];
   double Vsm[5], Vsp[5];
   double area = 0.0;
+  double wface = 1.0; //time step of the face (local time-stepping), otherwise 1
   Int3 ind;
 
   // Count the riemann solver errors. Note that when this occurs, (1) it may be that the Riemann problem does NOT
@@ -2429,7 +2562,9 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
         //*****************************************
         //calculate flux function F_{i-1/2,j,k}
         //*****************************************
-        if(k!=kkmax-1 && j!=jjmax-1) {
+        if(k!=kkmax-1 && j!=jjmax-1 && !FaceIsActive(lev, i-1, j, k, i, j, k, wface))
+          f[k][j][i] = 0.0; //face skipped (local time-stepping or quiescent tiles). First touch (see above)
+        else if(k!=kkmax-1 && j!=jjmax-1) {
  
           neighborid = id[k][j][i-1];
 
@@ -2498,7 +2633,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               } 
               else { 
                 // determine the axis/direction of the 1D Riemann problem
-                Vec3D dir = GetNormalForBimaterialRiemann(0/*i-1/2*/,i,j,k,coords,dxyz,myid,neighborid,ls_mat_id,&phi);
+                Vec3D dir = GetNormalForBimaterialRiemann(0/*i-1/2*/,i,j,k,myid,neighborid,ls_mat_id,&phi);
 
                 //Solve 1D Riemann problem
                 if(iod.multiphase.recon == MultiPhaseData::CONSTANT)//switch back to constant reconstruction (i.e. v)
@@ -2551,9 +2686,9 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
             }
           }
 
-          area = dxyz[k][j][i][1]*dxyz[k][j][i][2];
+          area = metrics.FaceAreaX(j,k)*wface;
           f[k][j][i-1] += localflux1*area;
-          f[k][j][i]   -= localflux2*area;
+          f[k][j][i]    = -localflux2*area; //first touch (see above)
 
         }
 
@@ -2561,7 +2696,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
         //*****************************************
         //calculate flux function G_{i,j-1/2,k}
         //*****************************************
-        if(k!=kkmax-1 && i!=iimax-1) {
+        if(k!=kkmax-1 && i!=iimax-1 && FaceIsActive(lev, i, j-1, k, i, j, k, wface)) {
 
           neighborid = id[k][j-1][i];
 
@@ -2626,7 +2761,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               }
               else {
                 // determine the axis/direction of the 1D Riemann problem
-                Vec3D dir = GetNormalForBimaterialRiemann(1/*j-1/2*/,i,j,k,coords,dxyz,myid,neighborid,ls_mat_id,&phi);
+                Vec3D dir = GetNormalForBimaterialRiemann(1/*j-1/2*/,i,j,k,myid,neighborid,ls_mat_id,&phi);
 
                 //Solve 1D Riemann problem
                 if(iod.multiphase.recon == MultiPhaseData::CONSTANT)//switch back to constant reconstruction (i.e. v)
@@ -2679,7 +2814,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
             }
           }
 
-          area = dxyz[k][j][i][0]*dxyz[k][j][i][2];
+          area = metrics.FaceAreaY(i,k)*wface;
           f[k][j-1][i] += localflux1*area;
           f[k][j][i]   -= localflux2*area;
         }
@@ -2688,7 +2823,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
         //*****************************************
         //calculate flux function H_{i,j,k-1/2}
         //*****************************************
-        if(j!=jjmax-1 && i!=iimax-1) {
+        if(j!=jjmax-1 && i!=iimax-1 && FaceIsActive(lev, i, j, k-1, i, j, k, wface)) {
 
           neighborid = id[k-1][j][i];
 
@@ -2753,7 +2888,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               }
               else {
                 // determine the axis/direction of the 1D Riemann problem
-                Vec3D dir = GetNormalForBimaterialRiemann(2/*k-1/2*/,i,j,k,coords,dxyz,myid,neighborid,ls_mat_id,&phi);
+                Vec3D dir = GetNormalForBimaterialRiemann(2/*k-1/2*/,i,j,k,myid,neighborid,ls_mat_id,&phi);
 
                 //Solve 1D Riemann problem
                 if(iod.multiphase.recon == MultiPhaseData::CONSTANT) //switch back to constant reconstruction (i.e. v)
@@ -2806,7 +2941,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
             }
           }
 
-          area = dxyz[k][j][i][0]*dxyz[k][j][i][1];
+          area = metrics.FaceAreaZ(i,j)*wface;
           f[k-1][j][i] += localflux1*area;
           f[k][j][i]   -= localflux2*area;
         }
@@ -2838,9 +2973,10 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   } 
 
 
-  delta_xyz.RestoreDataPointerToLocalVector(); //no changes
   ID.RestoreDataPointerToLocalVector(); //no changes
-  coordinates.RestoreDataPointerToLocalVector(); //no changes
+
+  if(lev)
+    lts_level->RestoreDataPointerToLocalVector();
 
   V.RestoreDataPointerToLocalVector(); 
   Vl.RestoreDataPointerToLocalVector(); 
@@ -2963,7 +3099,7 @@ SpaceOperator::TagNodesOutsideConRecDepth(vector<SpaceVariable3D*> *Phi,
 //-----------------------------------------------------
 // Note that there is also a function in LevelSetOperator (ComputeNormalDirection) that does similar things
 Vec3D
-SpaceOperator::GetNormalForBimaterialRiemann(int d/*0,1,2*/, int i, int j, int k, Vec3D*** coords, Vec3D*** dxyz,
+SpaceOperator::GetNormalForBimaterialRiemann(int d/*0,1,2*/, int i, int j, int k,
                                              int myid, int neighborid, vector<int> *ls_mat_id,
                                              vector<double***> *phi)
 {
@@ -2972,7 +3108,7 @@ SpaceOperator::GetNormalForBimaterialRiemann(int d/*0,1,2*/, int i, int j, int k
     dir[d] = 1.0;
   else { //LEVEL_SET or AVERAGE
     dir = CalculateGradPhiAtCellInterface(d/*i-1/2,j-1/2,or k-1/2*/,
-                                          i,j,k,coords,dxyz,myid,neighborid,ls_mat_id,phi);
+                                          i,j,k,myid,neighborid,ls_mat_id,phi);
     if(iod.multiphase.riemann_normal == MultiPhaseData::AVERAGE) {
       dir[d] += 1.0;
       dir /= dir.norm();
@@ -2984,7 +3120,7 @@ SpaceOperator::GetNormalForBimaterialRiemann(int d/*0,1,2*/, int i, int j, int k
 //-----------------------------------------------------
 
 Vec3D
-SpaceOperator::CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int k, Vec3D*** coords, Vec3D*** dxyz,
+SpaceOperator::CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int k,
                                                int myid, int neighborid, vector<int> *ls_mat_id,
                                                vector<double***> *phi)
 {
@@ -3014,7 +3150,7 @@ SpaceOperator::CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int
 
   if(my_ls == neigh_ls) {// one of the two has matid = 0. only 1 level set function involved
 
-    dir = CalculateGradientAtCellInterface(d,i,j,k,coords,dxyz,(*phi)[my_ls]);
+    dir = CalculateGradientAtCellInterface(d,i,j,k,(*phi)[my_ls]);
 
     if(neighborid==0)
       dir *= -1.0;
@@ -3024,8 +3160,8 @@ SpaceOperator::CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int
   } 
   else {// 2 level set functions are involved here
 
-    Vec3D nphi_1 = CalculateGradientAtCellInterface(d,i,j,k,coords,dxyz,(*phi)[my_ls]);
-    Vec3D nphi_2 = CalculateGradientAtCellInterface(d,i,j,k,coords,dxyz,(*phi)[neigh_ls]);
+    Vec3D nphi_1 = CalculateGradientAtCellInterface(d,i,j,k,(*phi)[my_ls]);
+    Vec3D nphi_2 = CalculateGradientAtCellInterface(d,i,j,k,(*phi)[neigh_ls]);
 
     dir = nphi_2 - nphi_1;
 
@@ -3050,8 +3186,7 @@ SpaceOperator::CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int
 //-----------------------------------------------------
 
 Vec3D
-SpaceOperator::CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, int k, Vec3D*** coords,
-                                                Vec3D*** dxyz, double*** phi)
+SpaceOperator::CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, int k, double*** phi)
 {
 
   Vec3D dir(0.0, 0.0, 0.0); 
@@ -3059,40 +3194,38 @@ SpaceOperator::CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, in
   if(d == 0) {
   // calculate the dPhi/dx
     
-    dir[0] = (phi[k][j][i] - phi[k][j][i-1])/(coords[k][j][i][0] - coords[k][j][i-1][0]);
+    dir[0] = (phi[k][j][i] - phi[k][j][i-1])/(metrics.X(i) - metrics.X(i-1));
 
     double dy1, dy2;
     if(j<0) {//[j-1] is not available
-      dy1 = (phi[k][j+1][i-1] - phi[k][j][i-1])/(coords[k][j+1][i-1][1] - coords[k][j][i-1][1]);
-      dy2 = (phi[k][j+1][i]   - phi[k][j][i])  /(coords[k][j+1][i][1]   - coords[k][j][i][1]);
+      dy1 = (phi[k][j+1][i-1] - phi[k][j][i-1])/(metrics.Y(j+1) - metrics.Y(j));
+      dy2 = (phi[k][j+1][i]   - phi[k][j][i])  /(metrics.Y(j+1) - metrics.Y(j));
     } else if(j>=NY) {//[j+1] is not available
-      dy1 = (phi[k][j][i-1] - phi[k][j-1][i-1])/(coords[k][j][i-1][1] - coords[k][j-1][i-1][1]);
-      dy2 = (phi[k][j][i]   - phi[k][j-1][i])  /(coords[k][j][i][1]   - coords[k][j-1][i][1]);
+      dy1 = (phi[k][j][i-1] - phi[k][j-1][i-1])/(metrics.Y(j) - metrics.Y(j-1));
+      dy2 = (phi[k][j][i]   - phi[k][j-1][i])  /(metrics.Y(j) - metrics.Y(j-1));
     } else {
-      dy1 = CentralDifferenceLocal(   phi[k][j-1][i-1],       phi[k][j][i-1],       phi[k][j+1][i-1],
-                                   coords[k][j-1][i-1][1], coords[k][j][i-1][1], coords[k][j+1][i-1][1]);
-      dy2 = CentralDifferenceLocal(   phi[k][j-1][i],         phi[k][j][i],         phi[k][j+1][i],
-                                   coords[k][j-1][i][1],   coords[k][j][i][1],   coords[k][j+1][i][1]);
+      const double *cy = metrics.CentralDifferenceCoefficients(1,j);
+      dy1 = CentralDifferenceLocal(phi[k][j-1][i-1], phi[k][j][i-1], phi[k][j+1][i-1], cy);
+      dy2 = CentralDifferenceLocal(phi[k][j-1][i],   phi[k][j][i],   phi[k][j+1][i],   cy);
     }
     
     double dz1, dz2;
     if(k<0) {//[k-1] is not available
-      dz1 = (phi[k+1][j][i-1] - phi[k][j][i-1])/(coords[k+1][j][i-1][2] - coords[k][j][i-1][2]);
-      dz2 = (phi[k+1][j][i]   - phi[k][j][i])  /(coords[k+1][j][i][2]   - coords[k][j][i][2]);
+      dz1 = (phi[k+1][j][i-1] - phi[k][j][i-1])/(metrics.Z(k+1) - metrics.Z(k));
+      dz2 = (phi[k+1][j][i]   - phi[k][j][i])  /(metrics.Z(k+1) - metrics.Z(k));
     } else if(k>=NZ) {//[k+1] is not available
-      dz1 = (phi[k][j][i-1] - phi[k-1][j][i-1])/(coords[k][j][i-1][2] - coords[k-1][j][i-1][2]);
-      dz2 = (phi[k][j][i]   - phi[k-1][j][i])  /(coords[k][j][i][2]   - coords[k-1][j][i][2]);
+      dz1 = (phi[k][j][i-1] - phi[k-1][j][i-1])/(metrics.Z(k) - metrics.Z(k-1));
+      dz2 = (phi[k][j][i]   - phi[k-1][j][i])  /(metrics.Z(k) - metrics.Z(k-1));
     } else {
-      dz1 = CentralDifferenceLocal(   phi[k-1][j][i-1],       phi[k][j][i-1],       phi[k+1][j][i-1],
-                                   coords[k-1][j][i-1][2], coords[k][j][i-1][2], coords[k+1][j][i-1][2]);
-      dz2 = CentralDifferenceLocal(   phi[k-1][j][i],         phi[k][j][i],         phi[k+1][j][i],
-                                   coords[k-1][j][i][2],   coords[k][j][i][2],   coords[k+1][j][i][2]);
+      const double *cz = metrics.CentralDifferenceCoefficients(2,k);
+      dz1 = CentralDifferenceLocal(phi[k-1][j][i-1], phi[k][j][i-1], phi[k+1][j][i-1], cz);
+      dz2 = CentralDifferenceLocal(phi[k-1][j][i],   phi[k][j][i],   phi[k+1][j][i],   cz);
     } 
 
-    double x_i_minus_half = coords[k][j][i][0] - 0.5*dxyz[k][j][i][0];
-    double dx = coords[k][j][i][0] - coords[k][j][i-1][0];
-    double c1 = (coords[k][j][i][0] - x_i_minus_half)/dx;
-    double c2 = (x_i_minus_half - coords[k][j][i-1][0])/dx;
+    double x_i_minus_half = metrics.X(i) - 0.5*metrics.Dx(i);
+    double dx = metrics.X(i) - metrics.X(i-1);
+    double c1 = (metrics.X(i) - x_i_minus_half)/dx;
+    double c2 = (x_i_minus_half - metrics.X(i-1))/dx;
 
     dir[1] = c1*dy1 + c2*dy2;
     dir[2] = c1*dz1 + c2*dz2;
@@ -3101,40 +3234,38 @@ SpaceOperator::CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, in
   else if(d == 1) {
   // calculate the dPhi/dy
     
-    dir[1] = (phi[k][j][i] - phi[k][j-1][i])/(coords[k][j][i][1] - coords[k][j-1][i][1]);
+    dir[1] = (phi[k][j][i] - phi[k][j-1][i])/(metrics.Y(j) - metrics.Y(j-1));
 
     double dx1, dx2;
     if(i<0) {//[i-1] is not available
-      dx1 = (phi[k][j-1][i+1] - phi[k][j-1][i])/(coords[k][j-1][i+1][0] - coords[k][j-1][i][0]);
-      dx2 = (phi[k][j][i+1]   - phi[k][j][i])  /(coords[k][j][i+1][0]   - coords[k][j][i][0]);
+      dx1 = (phi[k][j-1][i+1] - phi[k][j-1][i])/(metrics.X(i+1) - metrics.X(i));
+      dx2 = (phi[k][j][i+1]   - phi[k][j][i])  /(metrics.X(i+1) - metrics.X(i));
     } else if(i>=NX) {//[i+1] is not available
-      dx1 = (phi[k][j-1][i] - phi[k][j-1][i-1])/(coords[k][j-1][i][0] - coords[k][j-1][i-1][0]);
-      dx2 = (phi[k][j][i]   - phi[k][j][i-1])  /(coords[k][j][i][0]   - coords[k][j][i-1][0]);
+      dx1 = (phi[k][j-1][i] - phi[k][j-1][i-1])/(metrics.X(i) - metrics.X(i-1));
+      dx2 = (phi[k][j][i]   - phi[k][j][i-1])  /(metrics.X(i) - metrics.X(i-1));
     } else {
-      dx1 = CentralDifferenceLocal(   phi[k][j-1][i-1],       phi[k][j-1][i],       phi[k][j-1][i+1],
-                                   coords[k][j-1][i-1][0], coords[k][j-1][i][0], coords[k][j-1][i+1][0]);
-      dx2 = CentralDifferenceLocal(   phi[k][j][i-1],         phi[k][j][i],         phi[k][j][i+1],
-                                   coords[k][j][i-1][0],   coords[k][j][i][0],   coords[k][j][i+1][0]);
+      const double *cx = metrics.CentralDifferenceCoefficients(0,i);
+      dx1 = CentralDifferenceLocal(phi[k][j-1][i-1], phi[k][j-1][i], phi[k][j-1][i+1], cx);
+      dx2 = CentralDifferenceLocal(phi[k][j][i-1],   phi[k][j][i],   phi[k][j][i+1],   cx);
     }
     
     double dz1, dz2;
     if(k<0) {//[k-1] is not available
-      dz1 = (phi[k+1][j-1][i] - phi[k][j-1][i])/(coords[k+1][j-1][i][2] - coords[k][j-1][i][2]);
-      dz2 = (phi[k+1][j][i]   - phi[k][j][i])  /(coords[k+1][j][i][2]   - coords[k][j][i][2]);
+      dz1 = (phi[k+1][j-1][i] - phi[k][j-1][i])/(metrics.Z(k+1) - metrics.Z(k));
+      dz2 = (phi[k+1][j][i]   - phi[k][j][i])  /(metrics.Z(k+1) - metrics.Z(k));
     } else if(k>=NZ) {//[k+1] is not available
-      dz1 = (phi[k][j-1][i] - phi[k-1][j-1][i])/(coords[k][j-1][i][2] - coords[k-1][j-1][i][2]);
-      dz2 = (phi[k][j][i]   - phi[k-1][j][i])  /(coords[k][j][i][2]   - coords[k-1][j][i][2]);
+      dz1 = (phi[k][j-1][i] - phi[k-1][j-1][i])/(metrics.Z(k) - metrics.Z(k-1));
+      dz2 = (phi[k][j][i]   - phi[k-1][j][i])  /(metrics.Z(k) - metrics.Z(k-1));
     } else {
-      dz1 = CentralDifferenceLocal(   phi[k-1][j-1][i],       phi[k][j-1][i],       phi[k+1][j-1][i],
-                                   coords[k-1][j-1][i][2], coords[k][j-1][i][2], coords[k+1][j-1][i][2]);
-      dz2 = CentralDifferenceLocal(   phi[k-1][j][i],         phi[k][j][i],         phi[k+1][j][i],
-                                   coords[k-1][j][i][2],   coords[k][j][i][2],   coords[k+1][j][i][2]);
+      const double *cz = metrics.CentralDifferenceCoefficients(2,k);
+      dz1 = CentralDifferenceLocal(phi[k-1][j-1][i], phi[k][j-1][i], phi[k+1][j-1][i], cz);
+      dz2 = CentralDifferenceLocal(phi[k-1][j][i],   phi[k][j][i],   phi[k+1][j][i],   cz);
     } 
 
-    double y_j_minus_half = coords[k][j][i][1] - 0.5*dxyz[k][j][i][1];
-    double dy = coords[k][j][i][1] - coords[k][j-1][i][1];
-    double c1 = (coords[k][j][i][1] - y_j_minus_half)/dy;
-    double c2 = (y_j_minus_half - coords[k][j-1][i][1])/dy;
+    double y_j_minus_half = metrics.Y(j) - 0.5*metrics.Dy(j);
+    double dy = metrics.Y(j) - metrics.Y(j-1);
+    double c1 = (metrics.Y(j) - y_j_minus_half)/dy;
+    double c2 = (y_j_minus_half - metrics.Y(j-1))/dy;
 
     dir[0] = c1*dx1 + c2*dx2;
     dir[2] = c1*dz1 + c2*dz2;
@@ -3143,40 +3274,38 @@ SpaceOperator::CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, in
   else if(d==2) {
   // calculate the dPhi/dz
 
-    dir[2] = (phi[k][j][i] - phi[k-1][j][i])/(coords[k][j][i][2] - coords[k-1][j][i][2]);
+    dir[2] = (phi[k][j][i] - phi[k-1][j][i])/(metrics.Z(k) - metrics.Z(k-1));
 
     double dx1, dx2;
     if(i<0) {//[i-1] is not available
-      dx1 = (phi[k-1][j][i+1] - phi[k-1][j][i])/(coords[k-1][j][i+1][0] - coords[k-1][j][i][0]);
-      dx2 = (phi[k][j][i+1]   - phi[k][j][i])  /(coords[k][j][i+1][0]   - coords[k][j][i][0]);
+      dx1 = (phi[k-1][j][i+1] - phi[k-1][j][i])/(metrics.X(i+1) - metrics.X(i));
+      dx2 = (phi[k][j][i+1]   - phi[k][j][i])  /(metrics.X(i+1) - metrics.X(i));
     } else if(i>=NX) {//[i+1] is not available
-      dx1 = (phi[k-1][j][i] - phi[k-1][j][i-1])/(coords[k-1][j][i][0] - coords[k-1][j][i-1][0]);
-      dx2 = (phi[k][j][i]   - phi[k][j][i-1])  /(coords[k][j][i][0]   - coords[k][j][i-1][0]);
+      dx1 = (phi[k-1][j][i] - phi[k-1][j][i-1])/(metrics.X(i) - metrics.X(i-1));
+      dx2 = (phi[k][j][i]   - phi[k][j][i-1])  /(metrics.X(i) - metrics.X(i-1));
     } else {
-      dx1 = CentralDifferenceLocal(   phi[k-1][j][i-1],       phi[k-1][j][i],       phi[k-1][j][i+1],
-                                   coords[k-1][j][i-1][0], coords[k-1][j][i][0], coords[k-1][j][i+1][0]);
-      dx2 = CentralDifferenceLocal(   phi[k][j][i-1],         phi[k][j][i],         phi[k][j][i+1],
-                                   coords[k][j][i-1][0],   coords[k][j][i][0],   coords[k][j][i+1][0]);
+      const double *cx = metrics.CentralDifferenceCoefficients(0,i);
+      dx1 = CentralDifferenceLocal(phi[k-1][j][i-1], phi[k-1][j][i], phi[k-1][j][i+1], cx);
+      dx2 = CentralDifferenceLocal(phi[k][j][i-1],   phi[k][j][i],   phi[k][j][i+1],   cx);
     }
     
     double dy1, dy2;
     if(j<0) {//[j-1] is not available
-      dy1 = (phi[k-1][j+1][i] - phi[k-1][j][i])/(coords[k-1][j+1][i][1] - coords[k-1][j][i][1]);
-      dy2 = (phi[k][j+1][i]   - phi[k][j][i])  /(coords[k][j+1][i][1]   - coords[k][j][i][1]);
+      dy1 = (phi[k-1][j+1][i] - phi[k-1][j][i])/(metrics.Y(j+1) - metrics.Y(j));
+      dy2 = (phi[k][j+1][i]   - phi[k][j][i])  /(metrics.Y(j+1) - metrics.Y(j));
     } else if(j>=NY) {//[j+1] is not available
-      dy1 = (phi[k-1][j][i] - phi[k-1][j-1][i])/(coords[k-1][j][i][1] - coords[k-1][j-1][i][1]);
-      dy2 = (phi[k][j][i]   - phi[k][j-1][i])  /(coords[k][j][i][1]   - coords[k][j-1][i][1]);
+      dy1 = (phi[k-1][j][i] - phi[k-1][j-1][i])/(metrics.Y(j) - metrics.Y(j-1));
+      dy2 = (phi[k][j][i]   - phi[k][j-1][i])  /(metrics.Y(j) - metrics.Y(j-1));
     } else {
-      dy1 = CentralDifferenceLocal(   phi[k-1][j-1][i],       phi[k-1][j][i],       phi[k-1][j+1][i],
-                                   coords[k-1][j-1][i][1], coords[k-1][j][i][1], coords[k-1][j+1][i][1]);
-      dy2 = CentralDifferenceLocal(   phi[k][j-1][i],         phi[k][j][i],         phi[k][j+1][i],
-                                   coords[k][j-1][i][1],   coords[k][j][i][1],   coords[k][j+1][i][1]);
+      const double *cy = metrics.CentralDifferenceCoefficients(1,j);
+      dy1 = CentralDifferenceLocal(phi[k-1][j-1][i], phi[k-1][j][i], phi[k-1][j+1][i], cy);
+      dy2 = CentralDifferenceLocal(phi[k][j-1][i],   phi[k][j][i],   phi[k][j+1][i],   cy);
     } 
 
-    double z_k_minus_half = coords[k][j][i][2] - 0.5*dxyz[k][j][i][2];
-    double dz = coords[k][j][i][2] - coords[k-1][j][i][2];
-    double c1 = (coords[k][j][i][2] - z_k_minus_half)/dz;
-    double c2 = (z_k_minus_half - coords[k-1][j][i][2])/dz;
+    double z_k_minus_half = metrics.Z(k) - 0.5*metrics.Dz(k);
+    double dz = metrics.Z(k) - metrics.Z(k-1);
+    double c1 = (metrics.Z(k) - z_k_minus_half)/dz;
+    double c2 = (z_k_minus_half - metrics.Z(k-1))/dz;
 
     dir[0] = c1*dx1 + c2*dx2;
     dir[1] = c1*dy1 + c2*dy2;
@@ -3231,6 +3360,9 @@ SpaceOperator::CheckReconstructedStates(SpaceVariable3D &V,
         if(boundary>=2) //not needed
           continue;
 
+        if(tiles && boundary==0 && !tiles->NeedsReconstruction(i,j,k))
+          continue; //not reconstructed (quiescent)
+
         myid = id[k][j][i];
 
         if(myid == INACTIVE_MATERIAL_ID)
@@ -3359,53 +3491,112 @@ void SpaceOperator::ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &ID, Spa
   return; //testing the level set solver without solving the N-S / Euler equations
 #endif
 
+  if(tiles)
+    tiles->BeginStage(V); //decides which tiles are skipped
+
+  residual_calls++;
+  double t0 = MPI_Wtime(), t1;
+
   // -------------------------------------------------
   // calculate fluxes on the left hand side of the equation   
   // -------------------------------------------------
   ComputeAdvectionFluxes(V, ID, R, riemann_solutions, ls_mat_id, Phi, EBDS);
+  t1 = MPI_Wtime();  residual_pass_time[ADVECTION] += t1 - t0;  t0 = t1;
 
-  if(visco)
+  if(visco) {
     visco->AddDiffusionFluxes(V, ID, EBDS, R); //including extra terms from cylindrical symmetry
+    t1 = MPI_Wtime();  residual_pass_time[VISCOSITY] += t1 - t0;  t0 = t1;
+  }
 
-  if(heat_diffusion)
+  if(heat_diffusion) {
     heat_diffusion->AddDiffusionFluxes(V, ID, EBDS, R);
+    t1 = MPI_Wtime();  residual_pass_time[HEAT_DIFFUSION] += t1 - t0;  t0 = t1;
+  }
 
   if(heo) {
     assert(Xi);
     heo->AddHyperelasticityFluxes(V, ID, *Xi, EBDS, R);
-  }
-
-  if(symm) {//cylindrical or spherical symmetry (symm only handles the sink terms from advective fluxes)
-    symm->AddSymmetryTerms(V, ID, R); //These terms are placed on the left-hand-side
+    t1 = MPI_Wtime();  residual_pass_time[HYPERELASTICITY] += t1 - t0;  t0 = t1;
   }
 
 
+  // -------------------------------------------------
+  // Final (single) pass over the domain interior: multiply flux by -1, divide by cell volume, add the
+  // sink terms of cylindrical or spherical symmetry (pointwise, on the left-hand-side), and reset the
+  // residual to 0 in inactive cells. Cell volumes and coordinates are taken from the 1D mesh tables,
+  // so only R and ID (and V, with symmetry) are streamed through memory.
+  // -------------------------------------------------
   Vec5D***    r = (Vec5D***) R.GetDataPointer();
-  double*** vol = (double***)volume.GetDataPointer();
+  double*** id  = ID.GetDataPointer();
+  Vec5D***    v = symm ? (Vec5D***) V.GetDataPointer() : NULL;
 
-  if(frozen_nodes_ptr) {
+  double dyz;
+  Vec5D s;
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++) {
+      dyz = metrics.Dy(j)*metrics.Dz(k);
+      for(int i=i0; i<imax; i++) {
+        if(id[k][j][i] == INACTIVE_MATERIAL_ID || (tiles && tiles->Skipped(i,j,k)))
+          r[k][j][i] = 0.0;
+        else {
+          r[k][j][i] *= -1.0/(metrics.Dx(i)*dyz);
+          if(v) {
+            symm->ComputeSymmetryTerms(v[k][j][i], id[k][j][i], metrics.X(i), metrics.Y(j), s);
+            r[k][j][i] -= s;
+          }
+        }
+      }
+    }
+
+  if(v)
+    V.RestoreDataPointerToLocalVector();
+
+  if(frozen_nodes_ptr) { //sparse
     for(auto&& fn : *frozen_nodes_ptr)
       r[fn[2]][fn[1]][fn[0]] = 0.0; //re-set residual to 0 for frozen nodes/cells
   }
 
-  // -------------------------------------------------
-  // multiply flux by -1, and divide by cell volume (for cells within the actual domain)
-  // -------------------------------------------------
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++) 
-      for(int i=i0; i<imax; i++) {
-        r[k][j][i] /= -vol[k][j][i];
-      }
+  if(tiles)
+    tiles->RecordResidual(r);
 
   // restore spatial variables
   R.RestoreDataPointerToLocalVector(); //NOTE: although R has been updated, there is no need of 
                                        //      cross-subdomain communications. So, no need to 
                                        //      update the global vec.
+  ID.RestoreDataPointerToLocalVector();
+
+  residual_pass_time[FINAL_PASS] += MPI_Wtime() - t0;
+}
 
+//-----------------------------------------------------
 
-  
+void SpaceOperator::PrintResidualProfile()
+{
+  if(residual_calls==0)
+    return;
 
-  volume.RestoreDataPointerToLocalVector();
+  double times[RESIDUAL_PASSES];
+  for(int p=0; p<RESIDUAL_PASSES; p++)
+    times[p] = residual_pass_time[p];
+  MPI_Allreduce(MPI_IN_PLACE, times, RESIDUAL_PASSES, MPI_DOUBLE, MPI_SUM, comm);
+
+  // number of cell updates (summed over all the cores)
+  double ncells = (double)NX*NY*NZ*residual_calls;
+
+  // bytes streamed per cell by the final pass: R (read & write), ID, and V (with symmetry)
+  double bytes = 2.0*sizeof(Vec5D) + sizeof(double) + (symm ? sizeof(Vec5D) : 0);
+
+  const char *names[RESIDUAL_PASSES] = {"advection", "viscosity", "heat diffusion", "hyperelasticity",
+                                        "final pass"};
+  print("Residual Evaluation (%ld calls, core-time summed over all the cores):\n", residual_calls);
+  for(int p=0; p<RESIDUAL_PASSES; p++) {
+    if(p!=ADVECTION && p!=FINAL_PASS && times[p]==0.0)
+      continue; //not active
+    print("  o %-15s: %e sec (%.2f ns/cell)", names[p], times[p], 1.0e9*times[p]/ncells);
+    if(p==FINAL_PASS)
+      print(", %.0f bytes/cell streamed, %.2f GB/s per core", bytes, 1.0e-9*bytes*ncells/times[p]);
+    print(".\n");
+  }
 }
 
 //-----------------------------------------------------
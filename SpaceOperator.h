@@ -14,7 +14,9 @@
 #include <SmoothingOperator.h>
 #include <FluxFcnBase.h>
 #include <Reconstructor.h>
+#include <ActiveTiles.h>
 #include <RiemannSolutions.h>
+#include <MeshMetrics.h>
 
 class EmbeddedBoundaryDataSet;
 class TriangulatedSurface;
@@ -42,6 +44,7 @@ class SpaceOperator
   SpaceVariable3D coordinates;
   SpaceVariable3D delta_xyz;
   SpaceVariable3D volume; //!< volume of node-centered control volumes
+  MeshMetrics metrics; //!< 1D tables of the mesh (tensor-product), for stencil kernels
   
   vector<GhostPoint> ghost_nodes_inner; //!< ghost nodes inside the physical domain (shared with other subd)
   vector<GhostPoint> ghost_nodes_outer; //!< ghost nodes outside the physical domain
@@ -86,6 +89,22 @@ class SpaceOperator
   bool domain_has_overset; //!< whether the entire domain has overset boundaries
   vector<std::pair<Int3, Vec5D> > ghost_overset; //!< overset ghost nodes outside the physical domain
 
+  //! Time-accurate local time-stepping (see TimeIntegratorLTS). If lts_level is set, the advective flux
+  //! across a face is computed only if the face is active in the current sub-step, and it is multiplied by
+  //! the time step of the face, dt0*2^m, m being the lower cluster level of the two cells.
+  SpaceVariable3D *lts_level;
+  int lts_substep;
+  double lts_dt0;
+
+  //! Skipping quiescent tiles in the residual computation and the stage update (NULL if not requested)
+  ActiveTiles *tiles;
+
+  //! Wall-clock time spent in each pass of ComputeResidual (see PrintResidualProfile)
+  enum ResidualPass {ADVECTION = 0, VISCOSITY = 1, HEAT_DIFFUSION = 2, HYPERELASTICITY = 3, FINAL_PASS = 4,
+                     RESIDUAL_PASSES = 5};
+  double residual_pass_time[RESIDUAL_PASSES];
+  long residual_calls;
+
 
 public:
   SpaceOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_,
@@ -107,6 +126,36 @@ public:
   int  ClipDensityAndPressure(SpaceVariable3D &V, SpaceVariable3D &ID, 
                               bool workOnGhost = false, bool checkState = true);
 
+  //! Prints the time spent in each pass of ComputeResidual, per cell and per call (summed over all the
+  //! processor cores), and the memory traffic of the final pass (streamed bytes per cell / time)
+  void PrintResidualProfile();
+
+  //! Fused Runge-Kutta stage update (domain interior): U = a*Un + b*U + c*dt_loc*R, V = V(U), then clip
+  //! V (and roll back U if clipped) and check V. dt_loc = 1 unless LocalDt is provided. Un (U) is not
+  //! accessed if a (b) is 0. V is exchanged once at the end; the exchange of U is deferred. Returns the
+  //! (global) number of clipped cells.
+  int  UpdateStageState(double a, SpaceVariable3D &Un, double b, SpaceVariable3D &U, double c,
+                        SpaceVariable3D &R, SpaceVariable3D *LocalDt, SpaceVariable3D &ID,
+                        SpaceVariable3D &V) {
+    return UpdateStageStateKernel(a, &Un, b, &U, c, R, LocalDt, ID, V);}
+
+  //! Same as above, except that the stage state is not stored in conservative form. It is recovered from
+  //! V in each cell: U = a*Un + b*U(V) + c*dt_loc*R, then V = V(U). (For low-storage Runge-Kutta)
+  int  UpdateStageState(double a, SpaceVariable3D &Un, double b, double c, SpaceVariable3D &R,
+                        SpaceVariable3D *LocalDt, SpaceVariable3D &ID, SpaceVariable3D &V) {
+    return UpdateStageStateKernel(a, &Un, b, NULL, c, R, LocalDt, ID, V);}
+
+  //! Time-accurate local time-stepping: "ComputeResidual" returns the increment (R*dt) due to the faces
+  //! active in the given sub-step. (Level = NULL: back to normal.)
+  void SetLocalTimeSteppingSubstep(SpaceVariable3D *Level, int substep, double dt0) {
+    lts_level = Level;  lts_substep = substep;  lts_dt0 = dt0;}
+
+  //! Must be called after the viscosity and heat diffusion operators are set up
+  void SetupActiveTiles();
+
+  //! To be called at the beginning of each time step by explicit time integrators (no-op if not active)
+  void BeginActiveTileStep(SpaceVariable3D &V, int time_step) {if(tiles) tiles->BeginTimeStep(V, time_step);}
+
   void SetupViscosityOperator(InterpolatorBase *interpolator_, GradientCalculatorBase *grad_,
                               bool with_embedded_boundary = false);
 
@@ -132,7 +181,8 @@ public:
   void ComputeLocalTimeStepSizes(SpaceVariable3D &V, SpaceVariable3D &ID, double &dt, double &cfl,
                                  SpaceVariable3D &LocalDt);
 
-  //! Compute the RHS of the ODE system (Only for cells inside the physical domain)
+  //! Compute the RHS of the ODE system (Only for cells inside the physical domain). R is overwritten
+  //! ("write once"); it does not need to be initialized. R is set to 0 in inactive and frozen cells.
   void ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &R, 
                        RiemannSolutions *riemann_solutions = NULL,
                        vector<int> *ls_mat_id = NULL, vector<SpaceVariable3D*> *Phi = NULL,
@@ -142,12 +192,17 @@ public:
   SpaceVariable3D& GetMeshCoordinates() {return coordinates;}
   SpaceVariable3D& GetMeshDeltaXYZ()    {return delta_xyz;}
   SpaceVariable3D& GetMeshCellVolumes() {return volume;}
+  MeshMetrics&     GetMeshMetrics()     {return metrics;}
 
   vector<GhostPoint>* GetPointerToInnerGhostNodes() {return &ghost_nodes_inner;}
   vector<GhostPoint>* GetPointerToOuterGhostNodes() {return &ghost_nodes_outer;}
 
   GlobalMeshInfo& GetGlobalMeshInfo() {return global_mesh;}
 
+  vector<VarFcnBase*>&    GetVarFcn()            {return varFcn;}
+  FluxFcnBase&            GetFluxFcn()           {return fluxFcn;}
+  ExactRiemannSolverBase& GetExactRiemannSolver() {return riemann;}
+
   void SetPointerToFrozenNodes(std::set<Int3>* fnodes_) {frozen_nodes_ptr = fnodes_;}
 
   void UpdateOversetGhostNodes(SpaceVariable3D &V);
@@ -177,6 +232,11 @@ private:
                                        
   void ApplyBoundaryConditionsGeometricEntities(Vec5D*** v);
 
+  //! U = NULL: the stage state is recovered from V (see UpdateStageState)
+  int  UpdateStageStateKernel(double a, SpaceVariable3D *Un, double b, SpaceVariable3D *U, double c,
+                              SpaceVariable3D &R, SpaceVariable3D *LocalDt, SpaceVariable3D &ID,
+                              SpaceVariable3D &V);
+
   void CheckReconstructedStates(SpaceVariable3D &V,
                                 SpaceVariable3D &Vl, SpaceVariable3D &Vr, SpaceVariable3D &Vb,
                                 SpaceVariable3D &Vt, SpaceVariable3D &Vk, SpaceVariable3D &Vf,
@@ -187,21 +247,40 @@ private:
                               vector<int> *ls_mat_id = NULL, vector<SpaceVariable3D*> *Phi = NULL,
                               vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS = nullptr);
 
+  //! Local time-stepping: whether the face between cells 1 and 2 is active in the current sub-step, and
+  //! its time step (w). Always active (w = 1) if lev is NULL.
+  inline bool LTSFaceIsActive(double*** lev, int i1, int j1, int k1, int i2, int j2, int k2, double &w) {
+    if(!lev) {
+      w = 1.0;
+      return true;
+    }
+    int m = (int)std::min(lev[k1][j1][i1], lev[k2][j2][i2]);
+    w = (lts_substep % (1<<m) == 0) ? lts_dt0*(1<<m) : 0.0;
+    return w != 0.0;
+  }
+
+  //! Whether the advective flux across the face between cells 1 and 2 needs to be computed (see above
+  //! for w). Not needed if both cells are in skipped tiles.
+  inline bool FaceIsActive(double*** lev, int i1, int j1, int k1, int i2, int j2, int k2, double &w) {
+    if(tiles && tiles->FaceIsQuiet(i1, j1, k1, i2, j2, k2))
+      return false;
+    return LTSFaceIsActive(lev, i1, j1, k1, i2, j2, k2, w);
+  }
+
   Vec3D GetNormalForOneSidedRiemann(int d,/*0,1,2*/
                                     int forward_or_backward,/*1~wall is in the +x/y/z dir of material, -1~-x/y/z*/
                                     Vec3D& nwall);
 
-  Vec3D GetNormalForBimaterialRiemann(int d/*0,1,2*/, int i, int j, int k, Vec3D*** coords, Vec3D*** dxyz,
+  Vec3D GetNormalForBimaterialRiemann(int d/*0,1,2*/, int i, int j, int k,
                                       int myid, int neighborid, vector<int> *ls_mat_id,
                                       vector<double***> *phi);
 
-  Vec3D CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int k, Vec3D*** coords, Vec3D*** dxyz,
+  Vec3D CalculateGradPhiAtCellInterface(int d/*0,1,2*/, int i, int j, int k,
                                         int myid, int neighborid, vector<int> *ls_mat_id,
                                         vector<double***> *phi);
 
   //! Calculate the gradient of any variable phi at cell interface. 
-  Vec3D CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, int k, Vec3D*** coords,
-                                         Vec3D*** dxyz, double*** phi);
+  Vec3D CalculateGradientAtCellInterface(int d/*0,1,2*/, int i, int j, int k, double*** phi);
 
   bool TagNodesOutsideConRecDepth(vector<SpaceVariable3D*> *Phi, 
                                   vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS,
@@ -215,11 +294,8 @@ private:
                                     Vec3D& vwallf, Vec3D& vwallb, Vec3D& nwallf, Vec3D& nwallb);
 
   //! Utility
-  inline double CentralDifferenceLocal(double phi0, double phi1, double phi2, double x0, double x1, double x2) {
-    double c0 = -(x2-x1)/((x1-x0)*(x2-x0));
-    double c1 = 1.0/(x1-x0) - 1.0/(x2-x1);
-    double c2 = (x1-x0)/((x2-x0)*(x2-x1));
-    return c0*phi0 + c1*phi1 + c2*phi2;
+  inline double CentralDifferenceLocal(double phi0, double phi1, double phi2, const double *c) {
+    return c[0]*phi0 + c[1]*phi1 + c[2]*phi2; //c: from MeshMetrics::CentralDifferenceCoefficients
   }
 };
 
@@ -7,6 +7,11 @@
 #include <Utils.h>
 #include <bits/stdc++.h> //min_element, max_element
 
+// halo exchange statistics
+long SpaceVariable3D::n_exchanges = 0;
+long SpaceVariable3D::n_deferred  = 0;
+long SpaceVariable3D::n_lazy      = 0;
+
 //---------------------------------------------------------
 // DataManagers3D
 //---------------------------------------------------------
@@ -47,15 +52,23 @@ DataManagers3D::~DataManagers3D()
 //---------------------------------------------------------
 
 int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
+{
+  return CreateAllDataManagers(comm, NX, NY, NZ, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, NULL, NULL, NULL);
+}
+
+//---------------------------------------------------------
+
+int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ, int m, int n, int p,
+                                          const PetscInt *lx, const PetscInt *ly, const PetscInt *lz)
 {
   int nProcX, nProcY, nProcZ; //All DM's should use the same domain partition
 
   auto ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                            DMDA_STENCIL_BOX,
                            NX, NY, NZ,
-                           PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                           m, n, p,
                            1/*dof*/, 1/*stencil width*/, 
-                           NULL, NULL, NULL,
+                           lx, ly, lz,
                            &ghosted1_1dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_1dof);
@@ -67,9 +80,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       2/*dof*/, 1/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted1_2dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_2dof);
@@ -78,9 +91,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       3/*dof*/, 1/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted1_3dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_3dof);
@@ -89,9 +102,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       4/*dof*/, 1/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted1_4dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_4dof);
@@ -100,9 +113,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       5/*dof*/, 1/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted1_5dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_5dof);
@@ -111,9 +124,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       6/*dof*/, 1/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted1_6dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_6dof);
@@ -122,9 +135,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       9/*dof*/, 1/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted1_9dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted1_9dof);
@@ -133,9 +146,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       1/*dof*/, 2/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted2_1dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted2_1dof);
@@ -144,9 +157,9 @@ int DataManagers3D::CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ)
   ierr = DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
                       DMDA_STENCIL_BOX,
                       NX, NY, NZ,
-                      PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE,
+                      m, n, p,
                       3/*dof*/, 2/*stencil width*/, 
-                      NULL, NULL, NULL,
+                      lx, ly, lz,
                       &ghosted2_3dof);
   CHKERRQ(ierr);
   DMSetFromOptions(ghosted2_3dof);
@@ -178,6 +191,7 @@ void DataManagers3D::DestroyAllDataManagers()
 SpaceVariable3D::SpaceVariable3D() : comm(NULL), dm(NULL), globalVec(), localVec()
 {
   array = NULL;
+  ghosts_stale = false;
 }
 
 //---------------------------------------------------------
@@ -201,6 +215,7 @@ void SpaceVariable3D::Setup(MPI_Comm &comm_, DM *dm_)
   VecSet(localVec, 0.0);
 
   array = NULL;
+  ghosts_stale = false;
 
   DMBoundaryType bx, by, bz;
 
@@ -255,6 +270,19 @@ double*** SpaceVariable3D::GetDataPointer()
 {
   if(!dm) return NULL;
 
+  if(ghosts_stale)
+    EnsureGhostsValid();
+
+  DMDAVecGetArray(*dm, localVec, &array);
+  return array;
+}
+
+//---------------------------------------------------------
+
+double*** SpaceVariable3D::GetDataPointerInteriorOnly()
+{
+  if(!dm) return NULL;
+
   DMDAVecGetArray(*dm, localVec, &array);
   return array;
 }
@@ -272,6 +300,9 @@ void SpaceVariable3D::RestoreDataPointerAndInsert()
   // sync local to global
   DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
   DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+
+  ghosts_stale = false;
+  n_exchanges++;
 }
 
 //---------------------------------------------------------
@@ -281,12 +312,57 @@ void SpaceVariable3D::RestoreDataPointerAndAdd()
   if(!dm)
     return;
 
+  assert(!ghosts_stale); //globalVec must be up-to-date (i.e. data should be accessed by GetDataPointer)
+
   RestoreDataPointerToLocalVector();
   DMLocalToGlobal(*dm, localVec, ADD_VALUES, globalVec);
 
   // sync local to global
   DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
   DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+
+  n_exchanges++;
+}
+
+//---------------------------------------------------------
+
+void SpaceVariable3D::RestoreDataPointerAndMarkGhostsStale()
+{
+  if(!dm)
+    return;
+
+#ifdef CHECK_GHOST_VALIDITY
+  // poison the internal ghosts. They will be overwritten by the exchange.
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  for(int k=internal_ghost_k0; k<internal_ghost_kmax; k++)
+    for(int j=internal_ghost_j0; j<internal_ghost_jmax; j++)
+      for(int i=internal_ghost_i0; i<internal_ghost_imax; i++) {
+        if(i>=i0 && i<imax && j>=j0 && j<jmax && k>=k0 && k<kmax)
+          continue;
+        for(int p=0; p<dof; p++)
+          array[k][j][i*dof+p] = nan;
+      }
+#endif
+
+  RestoreDataPointerToLocalVector();
+
+  ghosts_stale = true;
+  n_deferred++;
+}
+
+//---------------------------------------------------------
+
+void SpaceVariable3D::EnsureGhostsValid()
+{
+  if(!dm || !ghosts_stale)
+    return;
+
+  DMLocalToGlobal(*dm, localVec, INSERT_VALUES, globalVec);
+  DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
+  DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+
+  ghosts_stale = false;
+  n_lazy++;
 }
 
 //---------------------------------------------------------
@@ -317,6 +393,8 @@ void SpaceVariable3D::StoreMeshCoordinates(SpaceVariable3D &coordinates)
   if(!dm)
     return;
 
+  coordinates.EnsureGhostsValid();
+
   DMSetCoordinateDim(*dm, 3/*3D*/);
   DMSetCoordinates(*dm, coordinates.globalVec);
 }
@@ -331,6 +409,8 @@ void SpaceVariable3D::WriteToVTRFile(const char *filename, const char *varname)
   if(varname)
     SetOutputVariableName(varname);
 
+  EnsureGhostsValid();
+
   PetscViewer viewer;
   PetscViewerVTKOpen(PetscObjectComm((PetscObject)*dm), filename, FILE_MODE_WRITE, &viewer);
   VecView(globalVec, viewer);
@@ -355,7 +435,7 @@ void SpaceVariable3D::AXPlusB(double a, double b, bool workOnGhost)
   if(!dm)
     return;
 
-  double*** v = GetDataPointer();
+  double*** v = workOnGhost ? GetDataPointer() : GetDataPointerInteriorOnly();
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
   if(workOnGhost)
@@ -369,7 +449,10 @@ void SpaceVariable3D::AXPlusB(double a, double b, bool workOnGhost)
         for(int p=0; p<dof; p++)
           v[k][j][i*dof+p] = a*v[k][j][i*dof+p] + b;
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //exchange is deferred until ghosts are needed
 }
 
 //---------------------------------------------------------
@@ -381,8 +464,8 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, bool work
     exit_mpi();
   }
 
-  double*** v  = GetDataPointer();
-  double*** v2 = y.GetDataPointer();
+  double*** v  = workOnGhost ? GetDataPointer() : GetDataPointerInteriorOnly();
+  double*** v2 = workOnGhost ? y.GetDataPointer() : y.GetDataPointerInteriorOnly();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -397,7 +480,10 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, bool work
         for(int p=0; p<dof; p++)
           v[k][j][i*dof+p] = a*v[k][j][i*dof+p] + b*v2[k][j][i*dof+p];
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //exchange is deferred until ghosts are needed
   y.RestoreDataPointerToLocalVector(); //no changes
 }
 
@@ -427,8 +513,8 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, std::vect
     exit_mpi();
   }
 
-  double*** v  = GetDataPointer();
-  double*** v2 = y.GetDataPointer();
+  double*** v  = workOnGhost ? GetDataPointer() : GetDataPointerInteriorOnly();
+  double*** v2 = workOnGhost ? y.GetDataPointer() : y.GetDataPointerInteriorOnly();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -447,7 +533,10 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, std::vect
           v[k][j][i*dof+px] = a*v[k][j][i*dof+px] + b*v2[k][j][i*dof+py];
         }
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //exchange is deferred until ghosts are needed
   y.RestoreDataPointerToLocalVector(); //no changes
 }
 
@@ -455,7 +544,7 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, std::vect
 
 void SpaceVariable3D::SetConstantValue(double a, bool workOnGhost)
 {
-  double*** v  = GetDataPointer();
+  double*** v  = GetDataPointerInteriorOnly(); //nothing is read
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -471,7 +560,7 @@ void SpaceVariable3D::SetConstantValue(double a, bool workOnGhost)
           v[k][j][i*dof+p] = a;
 
   if(!workOnGhost)
-    RestoreDataPointerAndInsert();
+    RestoreDataPointerAndMarkGhostsStale(); //exchange is deferred until ghosts are needed
   else
     RestoreDataPointerToLocalVector(); //no need to communicate because the ghost region has been set to a const
 }
@@ -485,7 +574,7 @@ SpaceVariable3D::CalculateGlobalMin(int mydof, bool workOnGhost)
 
   double global_min = DBL_MAX;
 
-  double*** v  = GetDataPointer();
+  double*** v  = workOnGhost ? GetDataPointer() : GetDataPointerInteriorOnly();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -515,7 +604,7 @@ SpaceVariable3D::CalculateGlobalMax(int mydof, bool workOnGhost)
 
   double global_max = -DBL_MAX;
 
-  double*** v  = GetDataPointer();
+  double*** v  = workOnGhost ? GetDataPointer() : GetDataPointerInteriorOnly();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -35,6 +35,9 @@ public:
   ~DataManagers3D();
 
   int CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ);
+  //! prescribed partition: m x n x p cores, with lx, ly, lz cells per core in each direction (see DMDACreate3d)
+  int CreateAllDataManagers(MPI_Comm comm, int NX, int NY, int NZ, int m, int n, int p,
+                            const PetscInt *lx, const PetscInt *ly, const PetscInt *lz);
   void DestroyAllDataManagers(); //!< need to call this before "PetscFinalize()".
 
 };
@@ -43,6 +46,19 @@ public:
  * Defines a space variable
  * Note: Upon initialization, SpaceVariable3D
  *       is filled with 0.
+ * Note: Ghost-validity tracking. Operations that
+ *       only write the subdomain interior may
+ *       defer the halo exchange by calling
+ *       RestoreDataPointerAndMarkGhostsStale().
+ *       The exchange is then done lazily, by the
+ *       next GetDataPointer() (or explicitly by
+ *       EnsureGhostsValid()). Accessing the data
+ *       with GetDataPointerInteriorOnly() does not
+ *       trigger the exchange; in this case, the
+ *       internal ghosts must not be read.
+ *       If CHECK_GHOST_VALIDITY is defined, stale
+ *       internal ghosts are filled with NaN, so
+ *       that illegal reads can be caught.
  *******************************************
  */
 class SpaceVariable3D {
@@ -74,6 +90,13 @@ class SpaceVariable3D {
   int        numNodes1; //number of interior nodes + internal ghost nodes
   int        numNodes2; //number of interior nodes + internal & external ghost nodes
 
+  bool       ghosts_stale; //!< whether globalVec and the internal ghosts of localVec are out-of-date
+
+  //! halo exchange statistics (all the variables on this processor core)
+  static long n_exchanges; //!< number of exchanges performed immediately
+  static long n_deferred; //!< number of exchanges deferred (marked stale)
+  static long n_lazy; //!< number of deferred exchanges that had to be performed eventually
+
 public:
   SpaceVariable3D(MPI_Comm &comm_, DM *dm_);
   SpaceVariable3D(); //must be followed by a call to function Setup(...)
@@ -81,7 +104,10 @@ public:
 
   void Setup(MPI_Comm &comm_, DM *dm_);
 
-  double*** GetDataPointer(); 
+  double*** GetDataPointer(); //!< updates the ghosts first if they are stale
+
+  //! Does not update stale ghosts. The caller must not read the internal ghosts.
+  double*** GetDataPointerInteriorOnly();
 
   /** The following two functions involve MPI communications
    *  Note that only the data in the real domain gets "communicated" (i.e. inserted or added)
@@ -92,6 +118,17 @@ public:
   void RestoreDataPointerAndAdd();
 
   void RestoreDataPointerToLocalVector(); //!< caution: does not update globalVec
+
+  //! For operations that write only the subdomain interior: defers the exchange (see above)
+  void RestoreDataPointerAndMarkGhostsStale();
+
+  //! Performs the deferred exchange, if any (collective)
+  void EnsureGhostsValid();
+
+  inline bool GhostsStale() {return ghosts_stale;}
+
+  static void GetHaloExchangeCounts(long *performed, long *deferred, long *lazy) {
+    *performed = n_exchanges; *deferred = n_deferred; *lazy = n_lazy;}
   void Destroy(); //!< should be called before PetscFinalize!
 
   void StoreMeshCoordinates(SpaceVariable3D &coordinates);
@@ -135,7 +172,7 @@ public:
   inline void NumProcs(int *nProcX_, int *nProcY_, int *nProcZ_) {*nProcX_ = nProcX; *nProcY_ = nProcY; *nProcZ_ = nProcZ;}
   inline void GetGlobalSize(int *NX_, int *NY_, int *NZ_) {*NX_ = NX; *NY_ = NY; *NZ_ = NZ;}
  
-  inline Vec& GetRefToGlobalVec() {return globalVec;}
+  inline Vec& GetRefToGlobalVec() {EnsureGhostsValid(); return globalVec;}
 
   inline bool OutsidePhysicalDomain(int i, int j, int k) {return (i<0 || i>=NX || j<0 || j>=NY || k<0 || k>=NZ);}
 
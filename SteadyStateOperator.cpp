@@ -14,7 +14,7 @@ extern int INACTIVE_MATERIAL_ID;
 //--------------------------------------------------------------------------
 
 SteadyStateOperator::SteadyStateOperator(MPI_Comm &comm_, TsData &iod_ts_) :
-                     comm(comm_), ref_calculated(false), converged(false)
+                     comm(comm_), ref_calculated(false), converged(false), iteration(0), history(NULL)
 {
   Rtol = iod_ts_.convergence_tolerance;
 
@@ -23,6 +23,21 @@ SteadyStateOperator::SteadyStateOperator(MPI_Comm &comm_, TsData &iod_ts_) :
 
   for(int i=0; i<5; i++)
     Rref[i] = 0.0;
+
+  wall0 = MPI_Wtime();
+
+  int mpi_rank;
+  MPI_Comm_rank(comm, &mpi_rank);
+  if(iod_ts_.residual_history_file[0] != 0 && mpi_rank == 0) {
+    history = fopen(iod_ts_.residual_history_file, "w");
+    if(!history) {
+      print_error(comm, "*** Error: Unable to open file %s.\n", iod_ts_.residual_history_file);
+      exit_mpi();
+    }
+    fprintf(history, "## Iteration | Residual: 1-norm, 2-norm, inf-norm (normalized) | 2-norm/initial | "
+                     "inf-norm/initial | Wall-clock time (s)\n");
+    fflush(history);
+  }
 }
 
 //--------------------------------------------------------------------------
@@ -34,7 +49,12 @@ SteadyStateOperator::~SteadyStateOperator()
 
 void
 SteadyStateOperator::Destroy()
-{ }
+{
+  if(history) {
+    fclose(history);
+    history = NULL;
+  }
+}
 
 //--------------------------------------------------------------------------
 
@@ -92,7 +112,7 @@ SteadyStateOperator::MonitorConvergence(SpaceVariable3D &R, SpaceVariable3D &ID)
   if(R1_init<0 || R2_init<0 || Rinf_init<0) { // first time-step
     R1_init = R1; 
     R2_init = R2;
-    Rinf_init = Rinf_init;
+    Rinf_init = Rinf;
     bool found_zero = false;
     if(R1_init == 0.0) {
       found_zero = true;
@@ -113,6 +133,13 @@ SteadyStateOperator::MonitorConvergence(SpaceVariable3D &R, SpaceVariable3D &ID)
   }
 
   
+  iteration++;
+  if(history) {
+    fprintf(history, "%8d  %16.8e  %16.8e  %16.8e  %16.8e  %16.8e  %12.4e\n", iteration, R1, R2, Rinf,
+            R2/R2_init, Rinf/Rinf_init, MPI_Wtime() - wall0);
+    fflush(history);
+  }
+
   // check for convergence (only consider 2-norm and inf-norm at this point)
   if(R2/R2_init<Rtol || Rinf/Rinf_init<Rtol)
     converged = true;
@@ -29,7 +29,11 @@ class SteadyStateOperator
   double R1_init, R2_init, Rinf_init; //! initial residual in 1-, 2-, and inf-norm.
   double R1, R2, Rinf;
   bool converged;
-  
+
+  //! residual history (for comparing convergence rates, e.g., with and without multigrid)
+  int iteration;
+  double wall0;
+  FILE *history; //!< NULL if not requested (and on all the cores except 0)
 
 public:
 
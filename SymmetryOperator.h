@@ -8,6 +8,8 @@
 #include <IoData.h>
 #include <SpaceVariable.h>
 #include <VarFcnBase.h>
+#include <Vector5D.h>
+#include <cassert>
 
 /*****************************************************************************
  * Class SymmetryOperator handles the sink terms produced by the advective
@@ -15,6 +17,8 @@
  * cylindrical symmetry.
  * Note: Other terms caused by viscosity, heat diffusion etc. are implemented
  *       elsewhere!
+ * Note: The terms are pointwise. They are added to the residual in the final
+ *       pass of SpaceOperator::ComputeResidual (no separate sweep).
  ****************************************************************************/
 
 class SymmetryOperator
@@ -25,32 +29,41 @@ class SymmetryOperator
 
   vector<VarFcnBase*>& varFcn;
 
-  //! Mesh info.
-  SpaceVariable3D &coordinates;
-  SpaceVariable3D &delta_xyz;
-  SpaceVariable3D &volume;
-
   int i0, j0, k0, imax, jmax, kmax; //!< corners of the real subdomain
   int ii0, jj0, kk0, iimax, jjmax, kkmax; //!< corners of the ghosted subdomain
 
 public:
 
   SymmetryOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, MeshData &iod_mesh_, 
-                   vector<VarFcnBase*> &varFcn_, SpaceVariable3D &coordinates_, 
-                   SpaceVariable3D &delta_xyz_, SpaceVariable3D &volume_);
+                   vector<VarFcnBase*> &varFcn_, SpaceVariable3D &coordinates_);
 
   ~SymmetryOperator();
 
-  void AddSymmetryTerms(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &R);
+  //! Symmetry terms in one cell, per unit volume (on the left-hand-side). x, y: coordinates of the cell center
+  inline void ComputeSymmetryTerms(Vec5D &v, int myid, double x, double y, Vec5D &s) {
+    if(iod_mesh.type == MeshData::SPHERICAL) { //x is the radial coord.
+      assert(x>0);
+      double coeff = 2.0*v[0]*v[1]/x; // 2*rho*u_r/r
+      s[0] = coeff;
+      s[1] = coeff*v[1]; // 2*rho*u_r*u_r/r
+      s[2] = s[3] = 0.0;
+      s[4] = coeff*varFcn[myid]->ComputeTotalEnthalpyPerUnitMass(v); // 2*rho*H*u_r/r
+    }
+    else if(iod_mesh.type == MeshData::CYLINDRICAL) { //x is the axial coord., y is the radial coord.
+      assert(y>0);
+      double coeff = v[0]*v[2]/y; // rho*u_r/r
+      s[0] = coeff;
+      s[1] = coeff*v[1]; //axial velocity
+      s[2] = coeff*v[2]; //radial velocity
+      s[3] = 0.0;
+      s[4] = coeff*varFcn[myid]->ComputeTotalEnthalpyPerUnitMass(v);
+    }
+    else
+      s = 0.0;
+  }
 
   void Destroy();
 
-private:
-
-  void AddSphericalSymmetryTerms(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &R);
-
-  void AddCylindricalSymmetryTerms(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &R);
-
 };
 
 #endif
@@ -532,6 +532,24 @@ TerminalVisualization::SetupTurboRGB()
 
 //------------------------------------------------------------------
 
+bool
+TerminalVisualization::IsTimeToPrint(double time, double dt, int time_step)
+{
+  if(iod_terminal.plane == TerminalVisualizationData::NONE) //not activated
+    return false;
+
+  if(use_clocktime) {
+    double current_time = (double)clock();
+    MPI_Allreduce(MPI_IN_PLACE, &current_time, 1, MPI_DOUBLE, MPI_MAX, comm); 
+    return (current_time-last_snapshot_clocktime)/CLOCKS_PER_SEC >= iod_terminal.frequency_clocktime;
+  }
+
+  return isTimeToWrite(time, dt, time_step, iod_terminal.frequency_dt, iod_terminal.frequency, 
+                       last_snapshot_time, false);
+}
+
+//------------------------------------------------------------------
+
 void
 TerminalVisualization::PrintSolutionSnapshot(double time, double dt, int time_step, SpaceVariable3D &V, 
                                              SpaceVariable3D &ID, vector<SpaceVariable3D*> &Phi, 
@@ -68,6 +68,9 @@ public:
   void PrintSolutionSnapshot(double time, double dt, int time_step, SpaceVariable3D &V, SpaceVariable3D &ID,
                              std::vector<SpaceVariable3D*> &Phi, SpaceVariable3D *L, bool force_write);
 
+  //! whether PrintSolutionSnapshot would print at this time (without force_write). Collective.
+  bool IsTimeToPrint(double time, double dt, int time_step);
+
 private:
 
   void SetupGrayColorMap();
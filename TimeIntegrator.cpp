@@ -19,8 +19,12 @@ TimeIntegratorBase::TimeIntegratorBase(MPI_Comm &comm_, IoData& iod_, DataManage
                         LaserAbsorptionSolver* laser_, EmbeddedBoundaryOperator* embed_,
                         HyperelasticityOperator* heo_)
                   : comm(comm_), iod(iod_), spo(spo_), lso(lso_), mpo(mpo_), laser(laser_), embed(embed_),
-                    heo(heo_), IDn(comm_, &(dms_.ghosted1_1dof)), sso(NULL),
-                    local_time_stepping(iod.ts.local_dt == TsData::YES)
+                    heo(heo_), IDn(comm_, &(dms_.ghosted1_1dof)), sso(NULL), mgo(NULL),
+                    local_time_stepping(iod.ts.local_dt == TsData::YES),
+                    packed_ls(iod.ts.expl.packed_level_sets == ExplicitData::ON),
+                    transport_interval(iod.ts.expl.transport_update_interval),
+                    transport_steps(0), transport_time(0.0), transport_travel(0.0), transport_rate(0.0),
+                    V_transport0(NULL), V_transport(NULL), Xi_transport1(NULL), R_transport_xi(NULL)
 {
   for(int i=0; i<(int)lso.size(); i++) {
     ls_mat_id.push_back(lso[i]->GetMaterialID());
@@ -28,11 +32,49 @@ TimeIntegratorBase::TimeIntegratorBase(MPI_Comm &comm_, IoData& iod_, DataManage
     Phi_tmp.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
   }
 
-  if(local_time_stepping)
+  if(local_time_stepping && iod.ts.convergence_tolerance>0.0) //unsteady: checked by TimeIntegratorLTS
     assert(lso.size()==0);
 
-  if(iod.ts.convergence_tolerance>0.0) //steady-state analysis
+  if(transport_interval<1) {
+    print_error("*** Error: TransportUpdateInterval must be positive (%d).\n", transport_interval);
+    exit_mpi();
+  }
+  multirate_transport = transport_interval>1 && (lso.size()>0 || heo);
+  if(multirate_transport) {
+    if(local_time_stepping) {
+      print_error("*** Error: Multi-rate transport (TransportUpdateInterval > 1) cannot be used with "
+                  "local time-stepping.\n");
+      exit_mpi();
+    }
+    if(iod.ts.expl.transport_cfl<=0.0 || iod.ts.expl.transport_max_displacement<=0.0) {
+      print_error("*** Error: TransportCFL and TransportMaxDisplacement must be positive.\n");
+      exit_mpi();
+    }
+    V_transport0 = new SpaceVariable3D(comm_, &(dms_.ghosted1_5dof));
+    V_transport  = new SpaceVariable3D(comm_, &(dms_.ghosted1_5dof));
+    for(int i=0; i<(int)lso.size(); i++) {
+      Phi_transport1.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
+      R_transport.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
+    }
+    if(heo) {
+      Xi_transport1  = new SpaceVariable3D(comm_, &(dms_.ghosted1_3dof));
+      R_transport_xi = new SpaceVariable3D(comm_, &(dms_.ghosted1_3dof));
+    }
+  }
+
+  if(iod.ts.convergence_tolerance>0.0) { //steady-state analysis
     sso = new SteadyStateOperator(comm_, iod.ts);
+    if(iod.ts.mg.num_levels>1) {
+      if(lso.size()>0 || laser || embed || heo) {
+        print_error("*** Error: Multigrid cannot be used with level sets, laser, embedded boundaries, or "
+                    "hyperelasticity.\n");
+        exit_mpi();
+      }
+      mgo = new MultigridOperator(comm_, iod, dms_, spo);
+    }
+  }
+  else if(iod.ts.mg.num_levels>1)
+    print_warning("Warning: Multigrid is only used in steady-state computations. Ignored.\n");
 }
 
 //----------------------------------------------------------------------------
@@ -41,6 +83,17 @@ TimeIntegratorBase::~TimeIntegratorBase()
 {
   if(sso)
     delete sso;
+  if(mgo)
+    delete mgo;
+
+  if(V_transport0) delete V_transport0;
+  if(V_transport)  delete V_transport;
+  for(int i=0; i<(int)Phi_transport1.size(); i++) {
+    delete Phi_transport1[i];
+    delete R_transport[i];
+  }
+  if(Xi_transport1)  delete Xi_transport1;
+  if(R_transport_xi) delete R_transport_xi;
 } 
 
 //----------------------------------------------------------------------------
@@ -57,6 +110,170 @@ TimeIntegratorBase::Destroy()
 
   if(sso)
     sso->Destroy();
+  if(mgo)
+    mgo->Destroy();
+
+  if(V_transport0) V_transport0->Destroy();
+  if(V_transport)  V_transport->Destroy();
+  for(int i=0; i<(int)Phi_transport1.size(); i++) {
+    Phi_transport1[i]->Destroy();
+    R_transport[i]->Destroy();
+  }
+  if(Xi_transport1)  Xi_transport1->Destroy();
+  if(R_transport_xi) R_transport_xi->Destroy();
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::UpdateLevelSetsPacked(SpaceVariable3D &V, vector<SpaceVariable3D*> &PhiR,
+                                          vector<SpaceVariable3D*> &R, double a, vector<SpaceVariable3D*> &X,
+                                          double b, vector<SpaceVariable3D*> &Y, double c, double time, double dt)
+{
+  LevelSetOperator::ComputeResiduals(lso, V, PhiR, R, time, dt); //velocity is reconstructed once, if possible
+
+  for(int i=0; i<(int)lso.size(); i++)
+    lso[i]->AdvanceStage(a, *X[i], b, *Y[i], c, *R[i]); //includes b.c.; one exchange
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::BeginTransportWindow(SpaceVariable3D &V)
+{
+  if(!multirate_transport || transport_steps>0)
+    return;
+
+  V_transport0->AXPlusBY(0.0, 1.0, V, true); //including external ghosts
+  transport_time   = 0.0;
+  transport_travel = 0.0;
+  transport_rate   = ComputeMaxTransportRate(V);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::AdvanceTransportMultiRate(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi,
+                                              SpaceVariable3D *Xi, double time, double dt)
+{
+  if(!multirate_transport)
+    return;
+
+  transport_steps++;
+  transport_time += dt;
+
+  double rate = ComputeMaxTransportRate(V);
+  transport_rate = std::max(transport_rate, rate);
+  transport_travel += rate*dt;
+
+  // Update now if the interface could travel too far by the end of the next step
+  bool must_update = transport_steps >= transport_interval ||
+                     transport_travel + rate*dt > iod.ts.expl.transport_max_displacement;
+  if(must_update)
+    AdvanceTransportWindow(V, Phi, Xi, time);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::FinishTransportWindow(SpaceVariable3D &V, SpaceVariable3D &ID, vector<SpaceVariable3D*> &Phi,
+                                          SpaceVariable3D *L, SpaceVariable3D *Xi, double time, int time_step)
+{
+  if(!multirate_transport || transport_steps==0) //no open window
+    return;
+
+  // Make a copy of Phi for update of material ID (see UpdateSolutionAfterTimeStepping)
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->AXPlusBY(0.0, *Phi_tmp[i], 1.0, *Phi[i], true);
+
+  AdvanceTransportWindow(V, Phi, Xi, time);
+
+  // Update ID and V. Tasks scheduled by the user (reinitialization, smoothing) were considered in the last step.
+  unique_ptr<vector<unique_ptr<EmbeddedBoundaryDataSet> > > EBDS 
+    = embed ? embed->GetPointerToEmbeddedBoundaryData() : nullptr;
+  UpdateSolutionAfterTimeStepping(V, ID, Phi, EBDS.get(), L, time, time_step, 1/*not the first subcycle*/, 0.0);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::AdvanceTransportWindow(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi,
+                                           SpaceVariable3D *Xi, double time)
+{
+  // SSP-RK2 sub-steps over [time - transport_time, time]. Velocity is interpolated linearly in time
+  // between V_transport0 and V.
+  int nsub = std::max(1, (int)std::ceil(transport_time*transport_rate/iod.ts.expl.transport_cfl));
+  double h = transport_time/nsub;
+  double t0 = time - transport_time;
+
+  for(int sub=0; sub<nsub; sub++) {
+
+    // Stage 1: Phi1 = Phi + h*R(Phi), Xi1 = Xi + h*R(Xi)
+    double theta = (double)sub/nsub;
+    V_transport->AXPlusBY(0.0, 1.0-theta, *V_transport0, true);
+    V_transport->AXPlusBY(1.0, theta, V, true);
+
+    if(!Phi.empty())
+      UpdateLevelSetsPacked(*V_transport, Phi, R_transport, 0.0, Phi_transport1, 1.0, Phi, h, t0 + sub*h, h);
+
+    if(Xi) {
+      heo->ComputeReferenceMapResidual(*V_transport, *Xi, *R_transport_xi);
+      Xi_transport1->AXPlusBY(0.0, 1.0, *Xi);
+      Xi_transport1->AXPlusBY(1.0, h, *R_transport_xi);
+      heo->ApplyBoundaryConditionsToReferenceMap(*Xi_transport1);
+    }
+
+    // Stage 2: Phi = 0.5*Phi + 0.5*Phi1 + 0.5*h*R(Phi1), same for Xi
+    theta = (double)(sub+1)/nsub;
+    V_transport->AXPlusBY(0.0, 1.0-theta, *V_transport0, true);
+    V_transport->AXPlusBY(1.0, theta, V, true);
+
+    if(!Phi.empty())
+      UpdateLevelSetsPacked(*V_transport, Phi_transport1, R_transport, 0.5, Phi, 0.5, Phi_transport1, 0.5*h,
+                            t0 + (sub+1)*h, h);
+
+    if(Xi) {
+      heo->ComputeReferenceMapResidual(*V_transport, *Xi_transport1, *R_transport_xi);
+      Xi->AXPlusBY(0.5, 0.5, *Xi_transport1);
+      Xi->AXPlusBY(1.0, 0.5*h, *R_transport_xi);
+      heo->ApplyBoundaryConditionsToReferenceMap(*Xi);
+    }
+  }
+
+  if(transport_steps>1 || nsub>1)
+    print("  o Advanced level set(s) / reference map over %d flow step(s) using %d sub-step(s) "
+          "(interface travel: %.2e cells).\n", transport_steps, nsub, transport_travel);
+
+  transport_steps = 0; //the next call to BeginTransportWindow starts a new window
+}
+
+//----------------------------------------------------------------------------
+
+double
+TimeIntegratorBase::ComputeMaxTransportRate(SpaceVariable3D &V)
+{
+  int i0, j0, k0, imax, jmax, kmax;
+  V.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+
+  MeshMetrics &metrics(spo.GetMeshMetrics());
+  Vec5D***  v    = (Vec5D***) V.GetDataPointerInteriorOnly(); //only interior cells are read
+
+  double rate = 0.0, inv_dy, inv_dz;
+  for(int k=k0; k<kmax; k++) {
+    inv_dz = 1.0/metrics.Dz(k);
+    for(int j=j0; j<jmax; j++) {
+      inv_dy = 1.0/metrics.Dy(j);
+      for(int i=i0; i<imax; i++)
+        rate = std::max(rate, std::fabs(v[k][j][i][1])/metrics.Dx(i) +
+                              std::fabs(v[k][j][i][2])*inv_dy +
+                              std::fabs(v[k][j][i][3])*inv_dz);
+    }
+  }
+
+  V.RestoreDataPointerToLocalVector();
+
+  MPI_Allreduce(MPI_IN_PLACE, &rate, 1, MPI_DOUBLE, MPI_MAX, comm);
+  return rate;
 }
 
 //----------------------------------------------------------------------------
@@ -159,6 +376,12 @@ TimeIntegratorFE::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   // Store a copy of V at OVERSET ghost nodes (for boundary condition update)
   spo.UpdateOversetGhostNodes(V);
 
+  // Multi-rate transport: store V at the beginning of a transport window
+  BeginTransportWindow(V);
+
+  // Quiescent tiles (if requested)
+  spo.BeginActiveTileStep(V, time_step);
+
   // Make a copy of Phi for update of material ID. 
   if(time_step == 1) { // Copy entire domain, even in the case of narrow-band LS
     for(int i=0; i<(int)Phi.size(); i++)
@@ -183,27 +406,28 @@ TimeIntegratorFE::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   if(laser) laser->AddHeatToNavierStokesResidual(Rn, *L, ID);
 
   spo.PrimitiveToConservative(V, ID, Un); // get Un
-  if(local_time_stepping)
-    AddFluxWithLocalTimeStep(Un, 1.0, Dt, Rn);
-  else
-    Un.AXPlusBY(1.0, dt, Rn);
-  spo.ConservativeToPrimitive(Un, ID, V); //updates V = V(n+1)
-  spo.ClipDensityAndPressure(V, ID);
+  // Un = Un + dt*Rn, V = V(Un), clip (fused)
+  spo.UpdateStageState(0.0, Un, 1.0, Un, local_time_stepping ? 1.0 : dt, Rn,
+                       local_time_stepping ? Dt : NULL, ID, V); //updates V = V(n+1)
   spo.ApplyBoundaryConditions(V);
 
   // -------------------------------------------------------------------------------
   // Forward Euler step for the level set equation(s): Phi(n+1) = Phi(n) + dt*R(Phi(n))
   // -------------------------------------------------------------------------------
-  for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V, *Phi[i], *Rn_ls[i], time, dt); //compute Rn_ls (level set)
-    lso[i]->AXPlusBY(1.0, *Phi[i], dt, *Rn_ls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi[i]);
+  if(packed_ls && !multirate_transport)
+    UpdateLevelSetsPacked(V, Phi, Rn_ls, 1.0, Phi, 0.0, Phi, dt, time, dt);
+  else if(!multirate_transport) {
+    for(int i=0; i<(int)Phi.size(); i++) {
+      lso[i]->ComputeResidual(V, *Phi[i], *Rn_ls[i], time, dt); //compute Rn_ls (level set)
+      lso[i]->AXPlusBY(1.0, *Phi[i], dt, *Rn_ls[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->ApplyBoundaryConditions(*Phi[i]);
+    }
   }
 
   // -------------------------------------------------------------------------------
   // Forward Euler step for the reference map equation: Xi(n+1) = Xi(n) + dt*R(Xi(n))
   // -------------------------------------------------------------------------------
-  if(Xi) {
+  if(Xi && !multirate_transport) {
     assert(heo);
     heo->ComputeReferenceMapResidual(V, *Xi, *Rn_xi);
     if(local_time_stepping)
@@ -214,10 +438,17 @@ TimeIntegratorFE::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   }
 
 
+  // Multi-rate transport (if activated): level sets and reference map
+  AdvanceTransportMultiRate(V, Phi, Xi, time, dt);
+
   // Check of convergence (for steady-state computations)
   if(sso)
     sso->MonitorConvergence(Rn,ID); //Strictly speaking, should recompute R using updated V. But this is OK.
 
+  // Coarse-grid correction (for steady-state computations with multigrid)
+  if(mgo)
+    mgo->Cycle(V, ID);
+
 
   // -------------------------------------------------------------------------------
   // End-of-step tasks
@@ -236,11 +467,15 @@ TimeIntegratorRK2::TimeIntegratorRK2(MPI_Comm &comm_, IoData& iod_, DataManagers
                                      HyperelasticityOperator* heo_)
                  : TimeIntegratorBase(comm_, iod_, dms_, spo_, lso_, mpo_, laser_, embed_, heo_),
                    Un(comm_, &(dms_.ghosted1_5dof)), 
-                   U1(comm_, &(dms_.ghosted1_5dof)),
-                   V1(comm_, &(dms_.ghosted1_5dof)), 
+                   low_storage(iod_.ts.expl.low_storage == ExplicitData::ON),
                    R(comm_, &(dms_.ghosted1_5dof)),
                    Xi1(NULL), Rxi(NULL)
 {
+  if(!low_storage) {
+    U1.Setup(comm_, &(dms_.ghosted1_5dof));
+    V1.Setup(comm_, &(dms_.ghosted1_5dof));
+  }
+
   for(int i=0; i<(int)lso.size(); i++) {
     Phi1.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
     Rls.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
@@ -270,8 +505,8 @@ TimeIntegratorRK2::~TimeIntegratorRK2()
 void TimeIntegratorRK2::Destroy() 
 {
   Un.Destroy(); 
-  U1.Destroy(); 
-  V1.Destroy(); 
+  U1.Destroy(); //does nothing if U1 is not allocated
+  V1.Destroy(); //does nothing if V1 is not allocated
   R.Destroy();
 
   for(int i=0; i<(int)Rls.size(); i++) {
@@ -302,6 +537,12 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   // Store a copy of V at OVERSET ghost nodes (for boundary condition update)
   spo.UpdateOversetGhostNodes(V);
 
+  // Multi-rate transport: store V at the beginning of a transport window
+  BeginTransportWindow(V);
+
+  // Quiescent tiles (if requested)
+  spo.BeginActiveTileStep(V, time_step);
+
   // Make a copy of Phi for update of material ID. 
   if(time_step == 1) { // Copy entire domain, even in the case of narrow-band LS
     for(int i=0; i<(int)Phi.size(); i++)
@@ -315,7 +556,19 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   unique_ptr<vector<unique_ptr<EmbeddedBoundaryDataSet> > > EBDS 
     = embed ? embed->GetPointerToEmbeddedBoundaryData() : nullptr;
 
-  //****************** STEP 1 FOR NS ******************
+  // Intermediate primitive state. In the low-storage mode, V is overwritten, and U1 is not stored (it is
+  // recovered from V1 in the stage update). So, in each stage, all the residuals (N-S, level set, reference
+  // map) are computed before the N-S state is updated. Storage: Un, R, V.
+  SpaceVariable3D &Vs(low_storage ? V : V1);
+
+  // Coefficient of R in the stage updates (with local time-stepping, dt is taken from Dt)
+  double cdt = local_time_stepping ? 1.0 : dt;
+  SpaceVariable3D *Dt_loc = local_time_stepping ? Dt : NULL;
+
+  // Reference map seen by the N-S residual in stages 2 and 3 (not updated within the step if multi-rate)
+  SpaceVariable3D *Xis = multirate_transport ? Xi : Xi1;
+
+  //****************** STEP 1 FOR NS (residual) ******************
   // Forward Euler step for the N-S equations: U1 = U(n) + dt*R(V(n))
   if(use_grad_phi)
     spo.ComputeResidual(V, ID, R, &riemann_solutions, &ls_mat_id, &Phi, EBDS.get(), Xi); // compute R(V(n))
@@ -325,37 +578,27 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   if(laser) laser->AddHeatToNavierStokesResidual(R, *L, ID);
 
   spo.PrimitiveToConservative(V, ID, Un); // get U(n)
-  U1.AXPlusBY(0.0, 1.0, Un); //U1 = U(n)
-  if(local_time_stepping)
-    AddFluxWithLocalTimeStep(U1, 1.0, Dt, R);
-  else
-    U1.AXPlusBY(1.0, dt, R); //U1 = U1 + dt*R(V(n))
-
-  // Check & clip the intermediate state (U1/V1)
-  spo.ConservativeToPrimitive(U1, ID, V1); //get V1
-  int clipped = spo.ClipDensityAndPressure(V1, ID);
-  if(clipped)
-    spo.PrimitiveToConservative(V1, ID, U1); //update U1 after clipping
-
-  // Apply B.C. to the intermediate state (fill ghost cells)
-  spo.ApplyBoundaryConditions(V1); 
   //***************************************************
 
 
   //****************** STEP 1 FOR LS ****************** 
   // Forward Euler step for the level set equation(s): Phi1 = Phi(n) + dt*R(Phi(n))
-  for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V, *Phi[i], *Rls[i], time, dt); //compute R(Phi(n))
-    lso[i]->AXPlusBY(0.0, *Phi1[i], 1.0, *Phi[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->AXPlusBY(1.0, *Phi1[i], dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+  if(packed_ls && !multirate_transport)
+    UpdateLevelSetsPacked(V, Phi, Rls, 0.0, Phi1, 1.0, Phi, dt, time, dt);
+  else if(!multirate_transport) {
+    for(int i=0; i<(int)Phi.size(); i++) {
+      lso[i]->ComputeResidual(V, *Phi[i], *Rls[i], time, dt); //compute R(Phi(n))
+      lso[i]->AXPlusBY(0.0, *Phi1[i], 1.0, *Phi[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->AXPlusBY(1.0, *Phi1[i], dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+    }
   }
   //***************************************************
 
 
   //****************** STEP 1 FOR Xi ****************** 
   // Forward Euler step for the reference map equation: Xi1 = Xi(n) + dt*R(Xi(n))
-  if(Xi) {
+  if(Xi && !multirate_transport) {
     assert(heo);
     heo->ComputeReferenceMapResidual(V, *Xi, *Rxi);
     Xi1->AXPlusBY(0.0, 1.0, *Xi); //Xi1 = Xi(n)
@@ -368,46 +611,53 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   //***************************************************
 
 
+  //****************** STEP 1 FOR NS (update) *********
+  // U1 = U(n) + dt*R(V(n)), V1 = V(U1), clip (fused)
+  if(low_storage)
+    spo.UpdateStageState(1.0, Un, 0.0, cdt, R, Dt_loc, ID, Vs);
+  else
+    spo.UpdateStageState(1.0, Un, 0.0, U1, cdt, R, Dt_loc, ID, Vs);
+
+  // Apply B.C. to the intermediate state (fill ghost cells)
+  spo.ApplyBoundaryConditions(Vs); 
+  //***************************************************
 
-  //****************** STEP 2 FOR NS ******************
+
+
+  //****************** STEP 2 FOR NS (residual) *******
   // Step 2: U(n+1) = 0.5*U(n) + 0.5*U1 + 0.5*dt*R(V1)
   if(use_grad_phi)
-    spo.ComputeResidual(V1, ID, R, NULL, &ls_mat_id, &Phi, EBDS.get(), Xi1);//compute R(V1) using prev.Phi, "loose coupling"
+    spo.ComputeResidual(Vs, ID, R, NULL, &ls_mat_id, &Phi, EBDS.get(), Xis);//compute R(V1) using prev.Phi, "loose coupling"
   else //using mesh normal at material interface
-    spo.ComputeResidual(V1, ID, R, NULL, NULL, NULL, EBDS.get(), Xi1); // compute R(V1)
+    spo.ComputeResidual(Vs, ID, R, NULL, NULL, NULL, EBDS.get(), Xis); // compute R(V1)
 
   if(laser) {
-    laser->ComputeLaserRadiance(V1,ID,*L,time);
+    laser->ComputeLaserRadianceInStage(Vs,ID,*L,time);
     laser->AddHeatToNavierStokesResidual(R, *L, ID);
   }
-  U1.AXPlusBY(0.5, 0.5, Un); //U(n+1) = 0.5*U(n) + 0.5*U1;
-  if(local_time_stepping)
-    AddFluxWithLocalTimeStep(U1, 0.5, Dt, R);
-  else
-    U1.AXPlusBY(1.0, 0.5*dt, R); //U(n+1) = U(n+1) + 0.5*dt*R(V1)
-  
-  spo.ConservativeToPrimitive(U1, ID, V); //updates V = V(n+1)
-  spo.ClipDensityAndPressure(V, ID);
-  spo.ApplyBoundaryConditions(V);
   //***************************************************
 
 
   //****************** STEP 2 FOR LS ******************
   // Step 2 for the level set equations: Phi(n+1) = 0.5*Phi(n) + 0.5*Phi1 + 0.5*dt*R(Phi1)
-  for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V1, *Phi1[i], *Rls[i], time, dt);
-    lso[i]->AXPlusBY(0.5, *Phi[i], 0.5, *Phi1[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->AXPlusBY(1.0, *Phi[i], 0.5*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi[i]);
+  if(packed_ls && !multirate_transport)
+    UpdateLevelSetsPacked(Vs, Phi1, Rls, 0.5, Phi, 0.5, Phi1, 0.5*dt, time, dt);
+  else if(!multirate_transport) {
+    for(int i=0; i<(int)Phi.size(); i++) {
+      lso[i]->ComputeResidual(Vs, *Phi1[i], *Rls[i], time, dt);
+      lso[i]->AXPlusBY(0.5, *Phi[i], 0.5, *Phi1[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->AXPlusBY(1.0, *Phi[i], 0.5*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->ApplyBoundaryConditions(*Phi[i]);
+    }
   }
   //***************************************************
 
 
   //****************** STEP 2 FOR Xi ****************** 
   // Step 2 for the reference map equation: Xi(n+1) = 0.5*Xi(n) + 0.5*Xi1 + 0.5*dt*R(Xi1)
-  if(Xi) {
+  if(Xi && !multirate_transport) {
     assert(heo);
-    heo->ComputeReferenceMapResidual(V1, *Xi1, *Rxi);
+    heo->ComputeReferenceMapResidual(Vs, *Xi1, *Rxi);
     Xi->AXPlusBY(0.5, 0.5, *Xi1); 
     if(local_time_stepping)
       AddFluxWithLocalTimeStep(*Xi, 0.5, Dt, *Rxi);
@@ -418,10 +668,27 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   //***************************************************
 
 
+  //****************** STEP 2 FOR NS (update) *********
+  // U(n+1) = 0.5*U(n) + 0.5*U1 + 0.5*dt*R(V1), V(n+1) = V(U(n+1)), clip (fused)
+  if(low_storage) //U1 = U(V1), V1 overwrites V
+    spo.UpdateStageState(0.5, Un, 0.5, 0.5*cdt, R, Dt_loc, ID, V);
+  else
+    spo.UpdateStageState(0.5, Un, 0.5, U1, 0.5*cdt, R, Dt_loc, ID, V);
+  spo.ApplyBoundaryConditions(V);
+  //***************************************************
+
+
+  // Multi-rate transport (if activated): level sets and reference map
+  AdvanceTransportMultiRate(V, Phi, Xi, time, dt);
+
   // Check of convergence (for steady-state computations)
   if(sso)
     sso->MonitorConvergence(R,ID); //Strictly speaking, should recompute R using updated V. But this is OK.
 
+  // Coarse-grid correction (for steady-state computations with multigrid)
+  if(mgo)
+    mgo->Cycle(V, ID);
+
 
   // End-of-step tasks
   UpdateSolutionAfterTimeStepping(V, ID, Phi, EBDS.get(), L, time, time_step, subcycle, dts);
@@ -438,13 +705,16 @@ TimeIntegratorRK3::TimeIntegratorRK3(MPI_Comm &comm_, IoData& iod_, DataManagers
                                      HyperelasticityOperator* heo_)
                  : TimeIntegratorBase(comm_, iod_, dms_, spo_, lso_, mpo_, laser_, embed_, heo_),
                    Un(comm_, &(dms_.ghosted1_5dof)), 
-                   U1(comm_, &(dms_.ghosted1_5dof)),
-                   V1(comm_, &(dms_.ghosted1_5dof)), 
-                   V2(comm_, &(dms_.ghosted1_5dof)), 
+                   low_storage(iod_.ts.expl.low_storage == ExplicitData::ON),
                    R(comm_, &(dms_.ghosted1_5dof)),
                    Xi1(NULL), Rxi(NULL)
                 
 {
+  if(!low_storage) {
+    U1.Setup(comm_, &(dms_.ghosted1_5dof));
+    V1.Setup(comm_, &(dms_.ghosted1_5dof));
+  }
+
   for(int i=0; i<(int)lso.size(); i++) {
     Phi1.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
     Rls.push_back(new SpaceVariable3D(comm_, &(dms_.ghosted1_1dof)));
@@ -474,9 +744,8 @@ TimeIntegratorRK3::~TimeIntegratorRK3()
 void TimeIntegratorRK3::Destroy()
 {
   Un.Destroy();
-  U1.Destroy();
-  V1.Destroy();
-  V2.Destroy();
+  U1.Destroy(); //does nothing if U1 is not allocated
+  V1.Destroy(); //does nothing if V1 is not allocated
   R.Destroy();
 
   for(int i=0; i<(int)Rls.size(); i++) {
@@ -507,6 +776,12 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   // Store a copy of V at OVERSET ghost nodes (for boundary condition update)
   spo.UpdateOversetGhostNodes(V);
 
+  // Multi-rate transport: store V at the beginning of a transport window
+  BeginTransportWindow(V);
+
+  // Quiescent tiles (if requested)
+  spo.BeginActiveTileStep(V, time_step);
+
   // Make a copy of Phi for update of material ID. 
   if(time_step == 1) { // Copy entire domain, even in the case of narrow-band LS
     for(int i=0; i<(int)Phi.size(); i++)
@@ -521,7 +796,20 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
     = embed ? embed->GetPointerToEmbeddedBoundaryData() : nullptr;
 
 
-  //****************** STEP 1 FOR NS ******************
+  // Intermediate primitive state (V1 and V2 share the same storage). In the low-storage mode, V is
+  // overwritten, and U1, U2 are not stored (they are recovered from V1, V2 in the stage updates). So, in
+  // each stage, all the residuals (N-S, level set, reference map) are computed before the N-S state is
+  // updated. Storage: Un, R, V.
+  SpaceVariable3D &Vs(low_storage ? V : V1);
+
+  // Coefficient of R in the stage updates (with local time-stepping, dt is taken from Dt)
+  double cdt = local_time_stepping ? 1.0 : dt;
+  SpaceVariable3D *Dt_loc = local_time_stepping ? Dt : NULL;
+
+  // Reference map seen by the N-S residual in stages 2 and 3 (not updated within the step if multi-rate)
+  SpaceVariable3D *Xis = multirate_transport ? Xi : Xi1;
+
+  //****************** STEP 1 FOR NS (residual) *******
   // Forward Euler step: U1 = U(n) + dt*R(V(n))
   if(use_grad_phi)
     spo.ComputeResidual(V, ID, R, &riemann_solutions, &ls_mat_id, &Phi, EBDS.get(), Xi); // compute R(V(n))
@@ -531,37 +819,27 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   if(laser) laser->AddHeatToNavierStokesResidual(R, *L, ID);
 
   spo.PrimitiveToConservative(V, ID, Un); // get U(n)
-  U1.AXPlusBY(0.0, 1.0, Un); //U1 = U(n)
-  if(local_time_stepping)
-    AddFluxWithLocalTimeStep(U1, 1.0, Dt, R);
-  else
-    U1.AXPlusBY(1.0, dt, R); //U1 = U1 + dt*R(V(n))
-
-  // Check & clip the intermediate state (U1/V1)
-  spo.ConservativeToPrimitive(U1, ID, V1); //get V1
-  int clipped = spo.ClipDensityAndPressure(V1, ID);
-  if(clipped)
-    spo.PrimitiveToConservative(V1, ID, U1); //update U1 after clipping
-
-  // Apply B.C. to the intermediate state (fill ghost cells)
-  spo.ApplyBoundaryConditions(V1); 
   //***************************************************
 
 
   //****************** STEP 1 FOR LS ******************
   // Forward Euler step for the level set equation(s): Phi1 = Phi(n) + dt*R(Phi(n))
-  for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V, *Phi[i], *Rls[i], time, dt); //compute R(Phi(n))
-    lso[i]->AXPlusBY(0.0, *Phi1[i], 1.0, *Phi[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->AXPlusBY(1.0, *Phi1[i], dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+  if(packed_ls && !multirate_transport)
+    UpdateLevelSetsPacked(V, Phi, Rls, 0.0, Phi1, 1.0, Phi, dt, time, dt);
+  else if(!multirate_transport) {
+    for(int i=0; i<(int)Phi.size(); i++) {
+      lso[i]->ComputeResidual(V, *Phi[i], *Rls[i], time, dt); //compute R(Phi(n))
+      lso[i]->AXPlusBY(0.0, *Phi1[i], 1.0, *Phi[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->AXPlusBY(1.0, *Phi1[i], dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+    }
   }
   //***************************************************
 
 
   //****************** STEP 1 FOR Xi ****************** 
   // Forward Euler step for the reference map equation: Xi1 = Xi(n) + dt*R(Xi(n))
-  if(Xi) {
+  if(Xi && !multirate_transport) {
     assert(heo);
     heo->ComputeReferenceMapResidual(V, *Xi, *Rxi);
     Xi1->AXPlusBY(0.0, 1.0, *Xi); //Xi1 = Xi(n)
@@ -574,52 +852,53 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   //***************************************************
 
 
+  //****************** STEP 1 FOR NS (update) *********
+  // U1 = U(n) + dt*R(V(n)), V1 = V(U1), clip (fused)
+  if(low_storage)
+    spo.UpdateStageState(1.0, Un, 0.0, cdt, R, Dt_loc, ID, Vs);
+  else
+    spo.UpdateStageState(1.0, Un, 0.0, U1, cdt, R, Dt_loc, ID, Vs);
 
-  //****************** STEP 2 FOR NS ******************
+  // Apply B.C. to the intermediate state (fill ghost cells)
+  spo.ApplyBoundaryConditions(Vs); 
+  //***************************************************
+
+
+
+  //****************** STEP 2 FOR NS (residual) *******
   // Step 2: U2 = 0.75*U(n) + 0.25*U1 + 0.25*dt*R(V1))
   if(use_grad_phi)
-    spo.ComputeResidual(V1, ID, R, NULL, &ls_mat_id, &Phi, EBDS.get(), Xi1); //compute R(V1) using prev.Phi, "loose coupling"
+    spo.ComputeResidual(Vs, ID, R, NULL, &ls_mat_id, &Phi, EBDS.get(), Xis); //compute R(V1) using prev.Phi, "loose coupling"
   else //using mesh normal at material interface
-    spo.ComputeResidual(V1, ID, R, NULL, NULL, NULL, EBDS.get(), Xi1); // compute R(V1)
+    spo.ComputeResidual(Vs, ID, R, NULL, NULL, NULL, EBDS.get(), Xis); // compute R(V1)
 
   if(laser) {
-    laser->ComputeLaserRadiance(V1,ID,*L,time);
+    laser->ComputeLaserRadianceInStage(Vs,ID,*L,time);
     laser->AddHeatToNavierStokesResidual(R, *L, ID);
   }
-
-  U1.AXPlusBY(0.25, 0.75, Un); //U2 = 0.75*U(n) + 0.25*U1;
-  if(local_time_stepping)
-    AddFluxWithLocalTimeStep(U1, 0.25, Dt, R);
-  else
-    U1.AXPlusBY(1.0, 0.25*dt, R); //U2 = U2 + 0.25*dt*R(V1)
-  
-  // Check & clip the intermediate state (U2/V2)
-  spo.ConservativeToPrimitive(U1, ID, V2); //get V2
-  clipped = spo.ClipDensityAndPressure(V2, ID);
-  if(clipped)
-    spo.PrimitiveToConservative(V2, ID, U1); //update U2 after clipping
-
-  // Apply B.C. to the intermediate state (fill ghost cells)
-  spo.ApplyBoundaryConditions(V2); //apply B.C. by populating the ghost layer
   //***************************************************
 
 
   //****************** STEP 2 FOR LS ******************
   // Step 2: Phi2 = 0.75*Phi(n) + 0.25*Phi1 + 0.25*dt*R(Phi1)
-  for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V1, *Phi1[i], *Rls[i], time, dt);
-    lso[i]->AXPlusBY(0.25, *Phi1[i], 0.75, *Phi[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->AXPlusBY(1.0, *Phi1[i], 0.25*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+  if(packed_ls && !multirate_transport)
+    UpdateLevelSetsPacked(Vs, Phi1, Rls, 0.25, Phi1, 0.75, Phi, 0.25*dt, time, dt);
+  else if(!multirate_transport) {
+    for(int i=0; i<(int)Phi.size(); i++) {
+      lso[i]->ComputeResidual(Vs, *Phi1[i], *Rls[i], time, dt);
+      lso[i]->AXPlusBY(0.25, *Phi1[i], 0.75, *Phi[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->AXPlusBY(1.0, *Phi1[i], 0.25*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+    }
   }
   //***************************************************
 
 
   //****************** STEP 2 FOR Xi ****************** 
   // Step 2: Xi2 = 0.75*Xi(n) + 0.25*Xi1 + 0.25*dt*R(Xi1)
-  if(Xi) {
+  if(Xi && !multirate_transport) {
     assert(heo);
-    heo->ComputeReferenceMapResidual(V1, *Xi1, *Rxi);
+    heo->ComputeReferenceMapResidual(Vs, *Xi1, *Rxi);
     Xi1->AXPlusBY(0.25, 0.75, *Xi);  //re-use Xi1 to store Xi2
     if(local_time_stepping)
       AddFluxWithLocalTimeStep(*Xi1, 0.25, Dt, *Rxi);
@@ -630,46 +909,53 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   //***************************************************
 
 
+  //****************** STEP 2 FOR NS (update) *********
+  // U2 = 0.75*U(n) + 0.25*U1 + 0.25*dt*R(V1), V2 = V(U2), clip (fused). U2 (V2) overwrites U1 (V1).
+  if(low_storage) //U1 = U(V1)
+    spo.UpdateStageState(0.75, Un, 0.25, 0.25*cdt, R, Dt_loc, ID, Vs);
+  else
+    spo.UpdateStageState(0.75, Un, 0.25, U1, 0.25*cdt, R, Dt_loc, ID, Vs);
+
+  // Apply B.C. to the intermediate state (fill ghost cells)
+  spo.ApplyBoundaryConditions(Vs); //apply B.C. by populating the ghost layer
+  //***************************************************
+
+
 
-  //****************** STEP 3 FOR NS ******************
+  //****************** STEP 3 FOR NS (residual) *******
   // Step 3: U(n+1) = 1/3*U(n) + 2/3*U2 + 2/3*dt*R(V2)
   if(use_grad_phi)
-    spo.ComputeResidual(V2, ID, R, NULL, &ls_mat_id, &Phi, EBDS.get(), Xi1); //compute R(V2) using prev.Phi,"loose coupling"
+    spo.ComputeResidual(Vs, ID, R, NULL, &ls_mat_id, &Phi, EBDS.get(), Xis); //compute R(V2) using prev.Phi,"loose coupling"
   else //using mesh normal at material interface
-    spo.ComputeResidual(V2, ID, R, NULL, NULL, NULL, EBDS.get(), Xi1); // compute R(V2)
+    spo.ComputeResidual(Vs, ID, R, NULL, NULL, NULL, EBDS.get(), Xis); // compute R(V2)
 
   if(laser) {
-    laser->ComputeLaserRadiance(V2,ID,*L,time);
+    laser->ComputeLaserRadianceInStage(Vs,ID,*L,time);
     laser->AddHeatToNavierStokesResidual(R, *L, ID);
   }
-  U1.AXPlusBY(2.0/3.0, 1.0/3.0, Un); //U2 = 1/3*U(n) + 2/3*U2;
-  if(local_time_stepping)
-    AddFluxWithLocalTimeStep(U1, 2.0/3.0, Dt, R);
-  else
-    U1.AXPlusBY(1.0, 2.0/3.0*dt, R); //U2 = U2 + 2/3*dt*R(V2)
-
-  spo.ConservativeToPrimitive(U1, ID, V); //updates V = V(n+1)
-  spo.ClipDensityAndPressure(V, ID);
-  spo.ApplyBoundaryConditions(V);
   //***************************************************
 
 
   //****************** STEP 3 FOR LS ******************
   // Step 3: Phi(n+1) = 1/3*Phi(n) + 2/3*Phi2 + 2/3*dt*R(Phi2)
-  for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V2, *Phi1[i], *Rls[i], time, dt);
-    lso[i]->AXPlusBY(1.0/3.0, *Phi[i], 2.0/3.0, *Phi1[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->AXPlusBY(1.0, *Phi[i], 2.0/3.0*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi[i]);
+  if(packed_ls && !multirate_transport)
+    UpdateLevelSetsPacked(Vs, Phi1, Rls, 1.0/3.0, Phi, 2.0/3.0, Phi1, 2.0/3.0*dt, time, dt);
+  else if(!multirate_transport) {
+    for(int i=0; i<(int)Phi.size(); i++) {
+      lso[i]->ComputeResidual(Vs, *Phi1[i], *Rls[i], time, dt);
+      lso[i]->AXPlusBY(1.0/3.0, *Phi[i], 2.0/3.0, *Phi1[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->AXPlusBY(1.0, *Phi[i], 2.0/3.0*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
+      lso[i]->ApplyBoundaryConditions(*Phi[i]);
+    }
   }
   //***************************************************
 
 
   //****************** STEP 3 FOR Xi ****************** 
   // Step 3: Xi(n+1) = 1/3*Xi(n) + 2/3*Xi2 + 2/3*dt*R(Xi2)
-  if(Xi) {
+  if(Xi && !multirate_transport) {
     assert(heo);
-    heo->ComputeReferenceMapResidual(V2, *Xi1, *Rxi);
+    heo->ComputeReferenceMapResidual(Vs, *Xi1, *Rxi);
     Xi->AXPlusBY(1.0/3.0, 2.0/3.0, *Xi1); 
     if(local_time_stepping)
       AddFluxWithLocalTimeStep(*Xi, 2.0/3.0, Dt, *Rxi);
@@ -680,10 +966,27 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   //***************************************************
 
 
+  //****************** STEP 3 FOR NS (update) *********
+  // U(n+1) = 1/3*U(n) + 2/3*U2 + 2/3*dt*R(V2), V(n+1) = V(U(n+1)), clip (fused)
+  if(low_storage) //U2 = U(V2), V2 overwrites V
+    spo.UpdateStageState(1.0/3.0, Un, 2.0/3.0, 2.0/3.0*cdt, R, Dt_loc, ID, V);
+  else
+    spo.UpdateStageState(1.0/3.0, Un, 2.0/3.0, U1, 2.0/3.0*cdt, R, Dt_loc, ID, V);
+  spo.ApplyBoundaryConditions(V);
+  //***************************************************
+
+
+  // Multi-rate transport (if activated): level sets and reference map
+  AdvanceTransportMultiRate(V, Phi, Xi, time, dt);
+
   // Check of convergence (for steady-state computations)
   if(sso)
     sso->MonitorConvergence(R,ID); //Strictly speaking, should recompute R using updated V. But this is OK.
 
+  // Coarse-grid correction (for steady-state computations with multigrid)
+  if(mgo)
+    mgo->Cycle(V, ID);
+
 
   // End-of-step tasks
   UpdateSolutionAfterTimeStepping(V, ID, Phi, EBDS.get(), L, time, time_step, subcycle, dts);
@@ -798,3 +1101,223 @@ TimeIntegratorBase::UpdateSolutionAfterTimeStepping(SpaceVariable3D &V, SpaceVar
 
 //----------------------------------------------------------------------------
 
+
+
+//----------------------------------------------------------------------------
+// TIME-ACCURATE LOCAL TIME-STEPPING
+//----------------------------------------------------------------------------
+
+TimeIntegratorLTS::TimeIntegratorLTS(MPI_Comm &comm_, IoData& iod_, DataManagers3D& dms_,
+                                     SpaceOperator& spo_, vector<LevelSetOperator*>& lso_,
+                                     MultiPhaseOperator& mpo_, LaserAbsorptionSolver* laser_,
+                                     EmbeddedBoundaryOperator* embed_,
+                                     HyperelasticityOperator* heo_)
+                 : TimeIntegratorBase(comm_, iod_, dms_, spo_, lso_, mpo_, laser_, embed_, heo_),
+                   type(iod_.ts.expl.type), max_level(iod_.ts.lts_max_level), top_level(0),
+                   Level(comm_, &(dms_.ghosted1_1dof)),
+                   Un(comm_, &(dms_.ghosted1_5dof)),
+                   U(comm_, &(dms_.ghosted1_5dof)),
+                   R(comm_, &(dms_.ghosted1_5dof)),
+                   Reg(comm_, &(dms_.ghosted1_5dof)),
+                   Mask(comm_, &(dms_.ghosted1_1dof))
+{
+  if(lso.size()>0 || laser || embed || heo) {
+    print_error("*** Error: Time-accurate local time-stepping cannot be used with level sets, lasers, "
+                "embedded boundaries, or hyperelasticity.\n");
+    exit_mpi();
+  }
+  for(auto it = iod.eqs.materials.dataMap.begin(); it != iod.eqs.materials.dataMap.end(); it++) {
+    if(it->second->viscosity.type != ViscosityModelData::NONE ||
+       it->second->heat_diffusion.type != HeatDiffusionModelData::NONE) {
+      print_error("*** Error: Time-accurate local time-stepping is limited to inviscid flows without "
+                  "heat diffusion.\n");
+      exit_mpi();
+    }
+  }
+  if(iod.mesh.type == MeshData::SPHERICAL || iod.mesh.type == MeshData::CYLINDRICAL) {
+    print_error("*** Error: Time-accurate local time-stepping cannot be used with cylindrical or "
+                "spherical symmetry.\n");
+    exit_mpi();
+  }
+  if(max_level<0 || max_level>20) {
+    print_error("*** Error: LocalTimeSteppingMaxLevel must be between 0 and 20 (%d).\n", max_level);
+    exit_mpi();
+  }
+
+  print("- Time-accurate local time-stepping: up to %d cluster level(s) (time step ratio: %d).\n",
+        max_level+1, 1<<max_level);
+}
+
+//----------------------------------------------------------------------------
+
+void TimeIntegratorLTS::Destroy()
+{
+  Level.Destroy();
+  Un.Destroy();
+  U.Destroy();
+  R.Destroy();
+  Reg.Destroy();
+  Mask.Destroy();
+
+  TimeIntegratorBase::Destroy();
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorLTS::ClusterLocalTimeSteps(SpaceVariable3D *LocalDt, double &dt)
+{
+  assert(LocalDt);
+
+  int i0, j0, k0, imax, jmax, kmax;
+  Level.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+
+  // Initial levels: the largest m such that dt*2^m does not exceed the local time step. Inactive cells
+  // (no local time step) and ghost cells outside the physical domain get the max level (no constraint).
+  Level.SetConstantValue((double)max_level, true); //including ghosts
+  double*** dtl = LocalDt->GetDataPointer();
+  double*** lev = Level.GetDataPointer();
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++) {
+        if(dtl[k][j][i]<=0.0)
+          continue;
+        int m = 0;
+        while(m<max_level && dt*(double)(1<<(m+1)) <= dtl[k][j][i])
+          m++;
+        lev[k][j][i] = m;
+      }
+  LocalDt->RestoreDataPointerToLocalVector();
+  Level.RestoreDataPointerAndInsert();
+
+  // Enforce a difference of at most 1 level between neighboring cells (only lowers levels)
+  int changed = 1;
+  while(changed) {
+    changed = 0;
+    lev = Level.GetDataPointer();
+    for(int k=k0; k<kmax; k++)
+      for(int j=j0; j<jmax; j++)
+        for(int i=i0; i<imax; i++) {
+          double lim = std::min(std::min(std::min(lev[k][j][i-1], lev[k][j][i+1]),
+                                         std::min(lev[k][j-1][i], lev[k][j+1][i])),
+                                std::min(lev[k-1][j][i], lev[k+1][j][i])) + 1.0;
+          if(lev[k][j][i] > lim) {
+            lev[k][j][i] = lim;
+            changed++;
+          }
+        }
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_SUM, comm);
+    if(changed)
+      Level.RestoreDataPointerAndInsert();
+    else
+      Level.RestoreDataPointerToLocalVector();
+  }
+
+  // The top level in use determines the time step of the main loop
+  double top = Level.CalculateGlobalMax(0, false);
+  int new_top_level = (int)top;
+  if(new_top_level != top_level)
+    print("  o Local time-stepping: %d cluster level(s).\n", new_top_level+1);
+  top_level = new_top_level;
+
+  dt *= (double)(1<<top_level);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorLTS::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
+                                      vector<SpaceVariable3D*>& Phi,
+                                      SpaceVariable3D* L, [[maybe_unused]] SpaceVariable3D *Xi,
+                                      [[maybe_unused]] SpaceVariable3D *LocalDt,
+                                      double time, double dt,
+                                      int time_step, int subcycle, double dts)
+{
+  // Store a copy of V at OVERSET ghost nodes (for boundary condition update)
+  spo.UpdateOversetGhostNodes(V);
+
+  double dt0 = dt/(double)(1<<top_level); //dt may have been reduced (e.g., to reach MaxTime)
+
+  spo.PrimitiveToConservative(V, ID, U);
+
+  if(type == ExplicitData::FORWARD_EULER)
+    Sweep(V, ID, dt0);
+  else if(type == ExplicitData::RUNGE_KUTTA_2) {
+    Un.AXPlusBY(0.0, 1.0, U);
+    Sweep(V, ID, dt0);
+    Sweep(V, ID, dt0);
+    // U(n+1) = 0.5*U(n) + 0.5*S(S(U(n))), V(n+1) = V(U(n+1))
+    spo.UpdateStageState(0.5, Un, 0.5, U, 0.0, R, NULL, ID, V);
+    spo.ApplyBoundaryConditions(V);
+  }
+  else { //RK3
+    Un.AXPlusBY(0.0, 1.0, U);
+    Sweep(V, ID, dt0);
+    Sweep(V, ID, dt0);
+    // U2 = 0.75*U(n) + 0.25*S(U1)
+    spo.UpdateStageState(0.75, Un, 0.25, U, 0.0, R, NULL, ID, V);
+    spo.ApplyBoundaryConditions(V);
+    Sweep(V, ID, dt0);
+    // U(n+1) = 1/3*U(n) + 2/3*S(U2)
+    spo.UpdateStageState(1.0/3.0, Un, 2.0/3.0, U, 0.0, R, NULL, ID, V);
+    spo.ApplyBoundaryConditions(V);
+  }
+
+  // End-of-step tasks
+  UpdateSolutionAfterTimeStepping(V, ID, Phi, NULL, L, time, time_step, subcycle, dts);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorLTS::Sweep(SpaceVariable3D &V, SpaceVariable3D &ID, double dt0)
+{
+  Reg.SetConstantValue(0.0);
+  Mask.SetConstantValue(0.0);
+
+  int nsub = 1<<top_level;
+  for(int s=0; s<nsub; s++) {
+
+    // increment due to the faces active in this sub-step
+    spo.SetLocalTimeSteppingSubstep(&Level, s, dt0);
+    spo.ComputeResidual(V, ID, R, NULL, NULL, NULL, NULL, NULL);
+    spo.SetLocalTimeSteppingSubstep(NULL, 0, 0.0);
+
+    UpdateRegisterAndMask(s);
+
+    // U = U + Mask*Reg, V = V(U), clip (only the cells in Mask change)
+    spo.UpdateStageState(0.0, U, 1.0, U, 1.0, Reg, &Mask, ID, V);
+    spo.ApplyBoundaryConditions(V);
+  }
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorLTS::UpdateRegisterAndMask(int s)
+{
+  int i0, j0, k0, imax, jmax, kmax;
+  Level.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+
+  double*** lev  = Level.GetDataPointerInteriorOnly();
+  double*** mask = Mask.GetDataPointerInteriorOnly();
+  Vec5D***  reg  = (Vec5D***) Reg.GetDataPointerInteriorOnly();
+  Vec5D***  r    = (Vec5D***) R.GetDataPointerInteriorOnly();
+
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++) {
+        if(mask[k][j][i] != 0.0) //updated in the previous sub-step
+          reg[k][j][i] = r[k][j][i];
+        else
+          reg[k][j][i] += r[k][j][i];
+        mask[k][j][i] = ((s+1) % (1<<(int)lev[k][j][i]) == 0) ? 1.0 : 0.0;
+      }
+
+  Level.RestoreDataPointerToLocalVector();
+  R.RestoreDataPointerToLocalVector();
+  Mask.RestoreDataPointerAndMarkGhostsStale();
+  Reg.RestoreDataPointerAndMarkGhostsStale();
+}
+
+//----------------------------------------------------------------------------
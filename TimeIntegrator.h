@@ -14,6 +14,7 @@
 #include <EmbeddedBoundaryOperator.h>
 #include <HyperelasticityOperator.h>
 #include <SteadyStateOperator.h>
+#include <MultigridOperator.h>
 using std::vector;
 
 /********************************************************************
@@ -52,8 +53,25 @@ protected:
 
   //! Variables for steady-state analysis
   SteadyStateOperator *sso;
+  MultigridOperator *mgo; //!< NULL unless multigrid is requested
   bool local_time_stepping;
 
+  //! whether level sets are advected together (see UpdateLevelSetsPacked)
+  bool packed_ls;
+
+  //! Multi-rate transport: level sets and reference map are advanced every few flow steps
+  //! (see AdvanceTransportMultiRate). Not active if transport_interval = 1.
+  int transport_interval; //!< max. number of flow steps between two transport updates
+  bool multirate_transport;
+  int transport_steps; //!< flow steps since the last transport update
+  double transport_time; //!< time since the last transport update
+  double transport_travel; //!< estimated interface travel since the last update (in cells)
+  double transport_rate; //!< max. of |u|/dx+|v|/dy+|w|/dz since the last update
+  SpaceVariable3D *V_transport0; //!< V at the last transport update
+  SpaceVariable3D *V_transport; //!< time-interpolated V
+  vector<SpaceVariable3D*> Phi_transport1, R_transport; //!< level set: intermediate state and residual
+  SpaceVariable3D *Xi_transport1, *R_transport_xi; //!< reference map: intermediate state and residual
+
 public:
   TimeIntegratorBase(MPI_Comm &comm_, IoData& iod_, DataManagers3D& dms_, SpaceOperator& spo_, 
                      vector<LevelSetOperator*>& lso_, MultiPhaseOperator& mpo_,
@@ -74,6 +92,10 @@ public:
 
   virtual void Destroy();
 
+  //! Time-accurate local time-stepping only (see TimeIntegratorLTS): groups the cells into clusters and
+  //! replaces dt (the smallest local time step) by the time step of the main loop. Otherwise, does nothing.
+  virtual void ClusterLocalTimeSteps([[maybe_unused]] SpaceVariable3D *LocalDt, [[maybe_unused]] double &dt) {}
+
   //! All the tasks that are done at the end of a time-step, independent of time integrator
   void UpdateSolutionAfterTimeStepping(SpaceVariable3D &V, SpaceVariable3D &ID,
                                        vector<SpaceVariable3D*> &Phi,
@@ -81,6 +103,12 @@ public:
                                        SpaceVariable3D *L,
                                        double time, int time_step, int subcycle, double dts);
                                         
+  //! Multi-rate transport: if a transport window is open, advances Phi and Xi to the current time and
+  //! updates ID (and V) accordingly. Must be called before Phi, Xi, or ID is written to file, and before the
+  //! simulation stops. Otherwise, does nothing.
+  void FinishTransportWindow(SpaceVariable3D &V, SpaceVariable3D &ID, vector<SpaceVariable3D*> &Phi,
+                             SpaceVariable3D *L, SpaceVariable3D *Xi, double time, int time_step);
+
   //! Functions pertaining to steady-state computation
   bool Converged() {return sso ? sso->Converged() : false;} //only for steady-state simulations
   double GetResidual1Norm() {assert(sso); return sso->GetResidual1Norm();}
@@ -92,6 +120,29 @@ protected:
   //! compute U += a*dt*R, where dt can be different for different cells (for steady-state computation)
   void AddFluxWithLocalTimeStep(SpaceVariable3D &U, double a, SpaceVariable3D *Dt, SpaceVariable3D &R);
 
+  //! For all the level sets: R = R(PhiR), X = a*X + b*Y + c*R, then apply boundary conditions. Velocity is
+  //! reconstructed once for the level sets that can share it, and each level set needs only one exchange.
+  void UpdateLevelSetsPacked(SpaceVariable3D &V, vector<SpaceVariable3D*> &PhiR, vector<SpaceVariable3D*> &R,
+                             double a, vector<SpaceVariable3D*> &X, double b, vector<SpaceVariable3D*> &Y,
+                             double c, double time, double dt);
+
+  //! Multi-rate transport: to be called at the beginning of each time step (stores V at the beginning of a
+  //! transport window)
+  void BeginTransportWindow(SpaceVariable3D &V);
+
+  //! Multi-rate transport: to be called after V(n+1) is obtained. Advances Phi and Xi if N flow steps have
+  //! passed, or if the interface may travel more than the allowed number of cells by the next step (so that
+  //! UpdateMaterialIDByLevelSet only sees small displacements). See also FinishTransportWindow.
+  void AdvanceTransportMultiRate(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi, SpaceVariable3D *Xi,
+                                 double time, double dt);
+
+  //! Multi-rate transport: advances Phi and Xi over the current window (SSP-RK2, velocity interpolated in time)
+  void AdvanceTransportWindow(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi, SpaceVariable3D *Xi,
+                              double time);
+
+  //! returns the max. (over the domain) of |u|/dx + |v|/dy + |w|/dz
+  double ComputeMaxTransportRate(SpaceVariable3D &V);
+
 };
 
 /********************************************************************
@@ -130,9 +181,10 @@ class TimeIntegratorRK2 : public TimeIntegratorBase
 {
   //! conservative state variable at time n
   SpaceVariable3D Un;
-  //! intermediate state
+  //! intermediate state (not allocated in the low-storage mode: V1 overwrites V, and U1 is recovered from it)
   SpaceVariable3D U1;
   SpaceVariable3D V1;
+  bool low_storage;
   //! "residual", i.e. the right-hand-side of the ODE
   SpaceVariable3D R;  
 
@@ -167,10 +219,11 @@ class TimeIntegratorRK3 : public TimeIntegratorBase
 {
   //! conservative state variable at time n
   SpaceVariable3D Un;
-  //! intermediate state
+  //! intermediate state (V1 stores both V1 and V2). Not allocated in the low-storage mode: V1 and V2
+  //! overwrite V, and U1 and U2 are recovered from them.
   SpaceVariable3D U1;
   SpaceVariable3D V1;
-  SpaceVariable3D V2;
+  bool low_storage;
   //! "residual", i.e. the right-hand-side of the ODE
   SpaceVariable3D R;  
 
@@ -198,6 +251,67 @@ public:
 
 };
 
+/********************************************************************
+ * Time-accurate local time-stepping (LTS) for unsteady simulations.
+ * The cells are grouped into clusters of levels m = 0, 1, ..., M,
+ * with time steps dt0*2^m (dt0: the smallest local time step). The
+ * levels of neighboring cells differ by at most 1. A time step of
+ * the main loop (dt0*2^M) is a "sweep" of 2^M sub-steps. In sub-step
+ * s, the advective flux across a face is computed only if s is a
+ * multiple of 2^m (m: the lower level of the two cells). It is then
+ * multiplied by dt0*2^m and added to the registers of BOTH cells. A
+ * cell of level m is updated using its register every 2^m sub-steps.
+ * So, the two sides of a face always receive the same time-integrated
+ * flux, i.e. mass, momentum, and energy are conserved across cluster
+ * boundaries. Each cell update is a forward Euler step. RK2 and RK3
+ * combine sweeps in the Shu-Osher (SSP) form. With a single cluster,
+ * the scheme is identical to TimeIntegratorFE/RK2/RK3. (In clusters
+ * below the top level, time accuracy is reduced to first order.)
+ * Limitations: inviscid, single-material flows (no level sets, heat
+ * diffusion, hyperelasticity, embedded boundaries, lasers, or
+ * cylindrical/spherical symmetry).
+ *******************************************************************/
+class TimeIntegratorLTS : public TimeIntegratorBase
+{
+  ExplicitData::Type type; //!< number of sweeps and their combination
+
+  int max_level; //!< user-specified
+  int top_level; //!< M (the highest level in the current clustering)
+
+  SpaceVariable3D Level; //!< cluster level of each cell (stored as double)
+  SpaceVariable3D Un; //!< conservative state at time n (RK2 and RK3)
+  SpaceVariable3D U; //!< conservative state, updated by the sweeps
+  SpaceVariable3D R; //!< increment (time-integrated fluxes) in one sub-step
+  SpaceVariable3D Reg; //!< flux register of each cell
+  SpaceVariable3D Mask; //!< 1: the cell completes its time step in the current sub-step; 0: otherwise
+
+public:
+  TimeIntegratorLTS(MPI_Comm &comm_, IoData& iod_, DataManagers3D& dms_, SpaceOperator& spo_,
+                    vector<LevelSetOperator*>& lso_, MultiPhaseOperator &mpo_,
+                    LaserAbsorptionSolver* laser_, EmbeddedBoundaryOperator* embed_,
+                    HyperelasticityOperator* heo_);
+  ~TimeIntegratorLTS() {}
+
+  void ClusterLocalTimeSteps(SpaceVariable3D *LocalDt, double &dt);
+
+  void AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
+                          vector<SpaceVariable3D*>& Phi,
+                          SpaceVariable3D *L, SpaceVariable3D *Xi, SpaceVariable3D *LocalDt,
+                          double time, double dt, int time_step, int subcycle, double dts);
+
+  void Destroy(); 
+
+private:
+
+  //! one sweep of 2^M sub-steps, updating U and V
+  void Sweep(SpaceVariable3D &V, SpaceVariable3D &ID, double dt0);
+
+  //! Reg = Reg + R (after resetting the registers of the cells updated in the previous sub-step), and
+  //! sets Mask for sub-step s
+  void UpdateRegisterAndMask(int s);
+
+};
+
 //----------------------------------------------------------------------
 
 #endif
@@ -5,38 +5,100 @@
 
 #include <TriangulatedSurface.h>
 #include <map>
+#include <algorithm>
 #include <cassert>
-using std::set;
 using std::vector;
 using std::map;
 using std::pair;
 
 //----------------------------------------------------
 
+void AdjacencyCSR::SortAndUnique()
+{
+  int nRows = size();
+  int count = 0;
+  for(int n=0; n<nRows; n++) {
+    int *first = index.data() + offset[n];
+    int *last  = index.data() + offset[n+1];
+    std::sort(first, last);
+    last = std::unique(first, last);
+    offset[n] = count; //offset[n] has been read already
+    for(int *p = first; p != last; p++)
+      index[count++] = *p;
+  }
+  if(nRows>0)
+    offset[nRows] = count;
+  index.resize(count);
+}
+
+//----------------------------------------------------
+
 void TriangulatedSurface::BuildConnectivities()
 {
   int nNodes = X.size();
   int nElems = elems.size();
 
-  node2node.clear();
-  node2node.resize(nNodes);
-  node2elem.clear();
-  node2elem.resize(nNodes);
-  
+  // node2elem and node2node: count, then fill (counting sort by node)
+  node2elem.offset.assign(nNodes+1, 0);
+  for(int i=0; i<nElems; i++)
+    for(int j=0; j<3; j++)
+      node2elem.offset[elems[i][j]+1]++;
+  for(int n=0; n<nNodes; n++)
+    node2elem.offset[n+1] += node2elem.offset[n];
+
+  node2node.offset.resize(nNodes+1);
+  for(int n=0; n<=nNodes; n++)
+    node2node.offset[n] = 2*node2elem.offset[n]; //each appearance of a node adds two neighbors
+
+  node2elem.index.resize(node2elem.offset[nNodes]);
+  node2node.index.resize(node2node.offset[nNodes]);
+  vector<int> pos(node2elem.offset.begin(), node2elem.offset.end()-1);
   for(int i=0; i<nElems; i++)
     for(int j=0; j<3; j++) {
-      node2node[elems[i][j]].insert(elems[i][(j+1)%3]);
-      node2node[elems[i][j]].insert(elems[i][(j+2)%3]);
-      node2elem[elems[i][j]].insert(i);
+      int n = elems[i][j];
+      node2elem.index[pos[n]] = i;
+      node2node.index[2*pos[n]]   = elems[i][(j+1)%3];
+      node2node.index[2*pos[n]+1] = elems[i][(j+2)%3];
+      pos[n]++;
     }
+  node2elem.SortAndUnique(); //elements are already sorted; duplicates only in degenerate (2D) surfaces
+  node2node.SortAndUnique();
 
-  elem2elem.clear();
-  elem2elem.resize(nElems);
+  // elem2elem: union of node2elem over the three nodes of each element
+  elem2elem.offset.assign(nElems+1, 0);
+  for(int i=0; i<nElems; i++)
+    for(int j=0; j<3; j++)
+      elem2elem.offset[i+1] += node2elem.Count(elems[i][j]);
   for(int i=0; i<nElems; i++)
+    elem2elem.offset[i+1] += elem2elem.offset[i];
+
+  elem2elem.index.resize(elem2elem.offset[nElems]);
+  for(int i=0; i<nElems; i++) {
+    int p = elem2elem.offset[i];
     for(int j=0; j<3; j++)
-      for(auto it = node2elem[elems[i][j]].begin(); it != node2elem[elems[i][j]].end(); it++)
-        elem2elem[i].insert(*it); //no risk of duplicates, as elem2elem[i] is a "set"
+      for(int e : node2elem[elems[i][j]])
+        elem2elem.index[p++] = e;
+  }
+  elem2elem.SortAndUnique();
+
+}
+
+//----------------------------------------------------
 
+void TriangulatedSurface::MoveConnectivitiesToSharedMemory(MPI_Comm &comm)
+{
+  node2node.MoveToSharedMemory(comm);
+  node2elem.MoveToSharedMemory(comm);
+  elem2elem.MoveToSharedMemory(comm);
+}
+
+//----------------------------------------------------
+
+void TriangulatedSurface::DestroySharedMemory()
+{
+  node2node.Destroy();
+  node2elem.Destroy();
+  elem2elem.Destroy();
 }
 
 //----------------------------------------------------
@@ -6,9 +6,42 @@
 #ifndef _TRIANGULATED_SURFACE_H_
 #define _TRIANGULATED_SURFACE_H_
 #include <Vector3D.h>
-#include <set>
+#include <NodeSharedVector.h>
 #include <vector>
 
+/*****************************************************************************
+ * Compressed sparse row (CSR) adjacency list. Row n contains the entries
+ * index[offset[n]], ..., index[offset[n+1]-1], sorted in ascending order
+ * without duplicates (i.e. the same order as a std::set<int>).
+ *****************************************************************************/
+struct AdjacencyCSR {
+
+  NodeSharedVector<int> offset; //!< size: number of rows + 1
+  NodeSharedVector<int> index;
+
+  //! a light-weight view of one row (supports range-based for loops)
+  struct Row {
+    const int *first, *last;
+    const int* begin() const {return first;}
+    const int* end() const {return last;}
+    int size() const {return last - first;}
+  };
+
+  inline Row operator[](int n) const {return Row{index.data() + offset[n], index.data() + offset[n+1]};}
+  inline int Count(int n) const {return offset[n+1] - offset[n];}
+  inline int size() const {return offset.empty() ? 0 : (int)offset.size() - 1;}
+  inline bool empty() const {return size() == 0;}
+  void clear() {offset.clear(); index.clear();}
+
+  //! sorts each row and removes duplicates (offset and index are compacted)
+  void SortAndUnique();
+
+  //! collective: one copy per compute node (see NodeSharedVector)
+  void MoveToSharedMemory(MPI_Comm &comm) {offset.MoveToSharedMemory(comm); index.MoveToSharedMemory(comm);}
+  void Destroy() {offset.Destroy(); index.Destroy();}
+
+};
+
 /*****************************************************************************
  * A utility class to store a triangulated surface (including the degenerate 
  * scenario of a set of line segments in the x-y plane; but cannot have both
@@ -30,9 +63,9 @@ struct TriangulatedSurface {
 
   std::vector<Vec3D> elemNorm;
   std::vector<double> elemArea;
-  std::vector<std::set<int> > node2node;
-  std::vector<std::set<int> > node2elem;
-  std::vector<std::set<int> > elem2elem;
+  AdjacencyCSR node2node;
+  AdjacencyCSR node2elem;
+  AdjacencyCSR elem2elem;
 
   TriangulatedSurface(bool degen_ = false) : degenerate(degen_), active_nodes(0), active_elems(0) { }
 
@@ -47,6 +80,10 @@ struct TriangulatedSurface {
   ~TriangulatedSurface() {} 
 
   void BuildConnectivities();
+
+  //! collective. Stores the (read-only) connectivities once per compute node.
+  void MoveConnectivitiesToSharedMemory(MPI_Comm &comm);
+  void DestroySharedMemory(); //!< collective
   void CalculateNormalsAndAreas(); //!< calculate the normal and area of each element
 
   bool CheckSurfaceOrientation(); //!<  check whether all the elements have consistent normal directions